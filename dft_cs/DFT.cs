@@ -17,17 +17,47 @@ namespace Fourier
         {
             Complex[] spectre = new Complex[len];
 
+            // The transform of real samples is conjugate symmetric, hence
+            // the fast transform computes only the first half.
+            if (len >= 2 && (len & (len - 1)) == 0)
+            {
+                Complex[] half = new RealFFT(len).Transform(sample, len);
+                for (int i = 0; i <= len / 2; i++)
+                {
+                    spectre[i] = half[i];
+                }
+                for (int i = len / 2 + 1; i < len; i++)
+                {
+                    spectre[i] = Complex.Conjugate(half[len - i]);
+                }
+                return spectre;
+            }
+
+            // Any other size, with the twiddles looked up instead of
+            // computed for every product.
+            double[] cos = new double[len];
+            double[] sin = new double[len];
+            for (int i = 0; i < len; i++)
+            {
+                cos[i] = Math.Cos(PI2 * i / len);
+                sin[i] = Math.Sin(PI2 * i / len);
+            }
+
             for (int i = 0; i < len; i++)
             {
                 double re = 0.0;
                 double im = 0.0;
-                //double tmp = PI2 * i / freq;
-                double tmp = PI2 * i / len;
+                int k = 0;
 
                 for (int j = 0; j < len; j++)
                 {
-                    re += sample[j] * Math.Cos(tmp * j);
-                    im += sample[j] * Math.Sin(tmp * j);
+                    re += sample[j] * cos[k];
+                    im += sample[j] * sin[k];
+                    k += i;
+                    if (k >= len)
+                    {
+                        k -= len;
+                    }
                 }
                 spectre[i] = new Complex(re, im);
             }
@@ -0,0 +1,276 @@
+using System;
+using System.Numerics;
+using System.Threading.Tasks;
+
+namespace Fourier
+{
+    /// <summary>
+    /// Radix-2 Fast Fourier Transform over separate real and imaginary
+    /// arrays.  The spectrum has the same sign convention as DFT, i.e.
+    /// X[k] = sum x[n] * exp(+2 pi i k n / N).
+    /// </summary>
+    public class FFT
+    {
+        /// <summary>
+        /// The size from which the stages are split across threads.
+        /// </summary>
+        public const int ParallelThreshold = 1 << 15;
+
+        private readonly int length;
+        private readonly int[] bitrev;
+
+        // Twiddles of every stage laid out one after another, so that a
+        // stage of half size h reads h contiguous elements from offset
+        // h - 1.
+        private readonly double[] twRe;
+        private readonly double[] twIm;
+
+        public FFT(int length)
+        {
+            if (length < 1 || (length & (length - 1)) != 0)
+            {
+                throw new ArgumentException("length must be a power of 2");
+            }
+
+            this.length = length;
+
+            int exp = 0;
+            while ((1 << exp) < length)
+            {
+                exp++;
+            }
+
+            bitrev = new int[length];
+            for (int i = 0; i < length; i++)
+            {
+                int r = 0;
+                for (int b = 0; b < exp; b++)
+                {
+                    r |= ((i >> b) & 1) << (exp - b - 1);
+                }
+                bitrev[i] = r;
+            }
+
+            twRe = new double[Math.Max(length - 1, 1)];
+            twIm = new double[Math.Max(length - 1, 1)];
+            for (int h = 1; h < length; h <<= 1)
+            {
+                double a = Math.PI / h;
+                for (int k = 0; k < h; k++)
+                {
+                    twRe[h - 1 + k] = Math.Cos(a * k);
+                    twIm[h - 1 + k] = Math.Sin(a * k);
+                }
+            }
+        }
+
+        public int Length
+        {
+            get {
+                return length;
+            }
+        }
+
+        /// <summary>
+        /// Transforms the complex samples in place, in the natural order.
+        /// </summary>
+        public void Transform(double[] re, double[] im)
+        {
+            for (int i = 0; i < length; i++)
+            {
+                int j = bitrev[i];
+                if (i < j)
+                {
+                    double t = re[i];
+                    re[i] = re[j];
+                    re[j] = t;
+                    t = im[i];
+                    im[i] = im[j];
+                    im[j] = t;
+                }
+            }
+
+            for (int h = 1; h < length; h <<= 1)
+            {
+                Stage(re, im, h);
+            }
+        }
+
+        /// <summary>
+        /// Transforms many frames of the same size at once, one frame per
+        /// thread.
+        /// </summary>
+        public void TransformBatch(double[][] re, double[][] im)
+        {
+            Parallel.For(0, re.Length, i => Transform(re[i], im[i]));
+        }
+
+        private void Stage(double[] re, double[] im, int h)
+        {
+            int blocks = length / (2 * h);
+
+            if (length < ParallelThreshold)
+            {
+                for (int b = 0; b < blocks; b++)
+                {
+                    Butterflies(re, im, h, 2 * h * b, 0, h);
+                }
+                return;
+            }
+
+            // Split the blocks between the threads while there are many,
+            // and each block once they become few and long.
+            int parts = Environment.ProcessorCount;
+            if (blocks >= parts)
+            {
+                Parallel.For(0, parts, p =>
+                {
+                    int first = (int)((long)blocks * p / parts);
+                    int last = (int)((long)blocks * (p + 1) / parts);
+                    for (int b = first; b < last; b++)
+                    {
+                        Butterflies(re, im, h, 2 * h * b, 0, h);
+                    }
+                });
+            }
+            else
+            {
+                int split = (parts + blocks - 1) / blocks;
+                Parallel.For(0, blocks * split, t =>
+                {
+                    int b = t / split;
+                    int p = t % split;
+                    int first = (int)((long)h * p / split);
+                    int last = (int)((long)h * (p + 1) / split);
+                    Butterflies(re, im, h, 2 * h * b, first, last);
+                });
+            }
+        }
+
+        private void Butterflies(double[] re, double[] im, int h, int offset,
+                                 int first, int last)
+        {
+            int tw = h - 1;
+            int k = first;
+
+            // The vectors stay within a block, whose half is a power of 2.
+            if (Vector.IsHardwareAccelerated && h >= Vector<double>.Count)
+            {
+                for (; k + Vector<double>.Count <= last;
+                     k += Vector<double>.Count)
+                {
+                    int m = offset + k;
+                    int n = m + h;
+                    var wr = new Vector<double>(twRe, tw + k);
+                    var wi = new Vector<double>(twIm, tw + k);
+                    var ar = new Vector<double>(re, m);
+                    var ai = new Vector<double>(im, m);
+                    var br = new Vector<double>(re, n);
+                    var bi = new Vector<double>(im, n);
+                    var tr = br * wr - bi * wi;
+                    var ti = br * wi + bi * wr;
+                    (ar + tr).CopyTo(re, m);
+                    (ai + ti).CopyTo(im, m);
+                    (ar - tr).CopyTo(re, n);
+                    (ai - ti).CopyTo(im, n);
+                }
+            }
+
+            for (; k < last; k++)
+            {
+                int m = offset + k;
+                int n = m + h;
+                double wr = twRe[tw + k];
+                double wi = twIm[tw + k];
+                double tr = re[n] * wr - im[n] * wi;
+                double ti = re[n] * wi + im[n] * wr;
+                re[n] = re[m] - tr;
+                im[n] = im[m] - ti;
+                re[m] += tr;
+                im[m] += ti;
+            }
+        }
+    }
+
+    /// <summary>
+    /// Transform of real samples through a complex transform of half the
+    /// size: the even and odd samples are packed as the real and imaginary
+    /// parts and separated afterwards.
+    /// </summary>
+    public class RealFFT
+    {
+        private readonly int length;
+        private readonly FFT half;
+        private readonly double[] splitRe;
+        private readonly double[] splitIm;
+
+        public RealFFT(int length)
+        {
+            if (length < 2 || (length & (length - 1)) != 0)
+            {
+                throw new ArgumentException("length must be a power of 2");
+            }
+
+            this.length = length;
+            half = new FFT(length / 2);
+            splitRe = new double[length / 2];
+            splitIm = new double[length / 2];
+            for (int k = 0; k < length / 2; k++)
+            {
+                double a = 2.0 * Math.PI * k / length;
+                splitRe[k] = Math.Cos(a);
+                splitIm[k] = Math.Sin(a);
+            }
+        }
+
+        public int Length
+        {
+            get {
+                return length;
+            }
+        }
+
+        /// <summary>
+        /// Transforms count samples padded with zeros to the length.
+        /// </summary>
+        /// <returns>the bins 0 to length / 2.</returns>
+        public Complex[] Transform(short[] sample, int count)
+        {
+            int m = length / 2;
+            double[] re = new double[m];
+            double[] im = new double[m];
+
+            count = Math.Min(count, Math.Min(sample.Length, length));
+            for (int i = 0; i + 1 < count; i += 2)
+            {
+                re[i / 2] = sample[i];
+                im[i / 2] = sample[i + 1];
+            }
+            if ((count & 1) != 0)
+            {
+                re[count / 2] = sample[count - 1];
+            }
+
+            half.Transform(re, im);
+
+            Complex[] spectre = new Complex[m + 1];
+            for (int k = 0; k <= m; k++)
+            {
+                int j = (m - k) & (m - 1);
+                int l = k & (m - 1);
+                // Even part (Z[k] + conj(Z[m - k])) / 2 and odd part
+                // (Z[k] - conj(Z[m - k])) / 2i.
+                double evr = 0.5 * (re[l] + re[j]);
+                double evi = 0.5 * (im[l] - im[j]);
+                double odr = 0.5 * (im[l] + im[j]);
+                double odi = -0.5 * (re[l] - re[j]);
+                double wr = k < m ? splitRe[k] : -1.0;
+                double wi = k < m ? splitIm[k] : 0.0;
+                spectre[k] = new Complex(evr + odr * wr - odi * wi,
+                                         evi + odr * wi + odi * wr);
+            }
+
+            return spectre;
+        }
+    }
+}
@@ -15,7 +15,6 @@ namespace Fourier
         static void Main(string[] args)
         {
             WaveReader reader;
-            DFT dft;
             StreamWriter writer;
 
             if (args.Length < 2)
@@ -24,8 +23,7 @@ namespace Fourier
                 return;
             }
 
-            reader = new WaveReader(File.OpenRead(args[0]));
-            dft = new DFT(reader.SamplingRate);
+            reader = WaveReader.OpenMapped(args[0]);
             writer = File.CreateText(args[1]);
 
             /*
@@ -36,30 +34,24 @@ namespace Fourier
 
             try
             {
-                short[] sample = new short[reader.SamplingRate];
-                //uint length = reader.SamplingRate;
-                uint length = 512;
-
-                uint step = reader.SamplingRate / length;
-
-                /*
-                for (uint i = 0; i < reader.SamplingRate; i++)
+                // A whole second of samples, padded to the size of the
+                // transform.
+                int count = (int)reader.SamplingRate;
+                int length = 1;
+                while (length < count)
                 {
-                    sample[i] = reader.ReadInt16();
-                }
-                */
-                for (uint i = 0; i < length; i++)
-                {
-                    sample[i] = reader.ReadInt16();
-                    for (uint j = 1; j < step; j++) {
-                        reader.ReadInt16();
-                    }
+                    length <<= 1;
                 }
 
-                Complex[] result = dft.transform(sample, (int)length);
-                for (uint i = 0; i < length / 2; i++)
+                short[] sample = new short[count];
+                count = reader.ReadChannel(sample, 0);
+
+                Complex[] result = new RealFFT(length).Transform(sample, count);
+                for (int i = 0; i < length / 2; i++)
                 {
-                    writer.WriteLine("{0} {1}", i, (int)result[i].Real);
+                    writer.WriteLine("{0} {1}",
+                                     (double)i * reader.SamplingRate / length,
+                                     (int)result[i].Real);
                 }
             }
             catch (System.IO.IOException e)
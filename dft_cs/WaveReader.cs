@@ -1,17 +1,35 @@
 using System;
+using System.Buffers.Binary;
 using System.IO;
+using System.IO.MemoryMappedFiles;
+using System.Runtime.InteropServices;
 
 namespace Fourier
 {
     public class WaveReader
     {
+        // The chunk identifiers read as little-endian integers.
+        private const uint RiffID = 0x46464952;
+        private const uint WaveID = 0x45564157;
+        private const uint FormatID = 0x20746d66;
+        private const uint DataID = 0x61746164;
+
+        /// <summary>
+        /// The size of the buffer the block reads go through.
+        /// </summary>
+        public const int BlockSize = 1 << 16;
+
         private uint fileSize;
         private ushort nChannels;
         private uint samplingRate;
         private uint dataRate;
+        private ushort blockAlign;
         private ushort depth;
         private uint dataSize;
+        private uint dataLeft;
         private BinaryReader reader;
+        private MemoryMappedFile map;
+        private byte[] block;
 
         public ushort NumChannels
         {
@@ -41,76 +59,375 @@ namespace Fourier
             }
         }
 
+        /// <summary>
+        /// The number of frames of the data chunk.
+        /// </summary>
+        public uint NumFrames
+        {
+            get {
+                return blockAlign == 0 ? 0 : dataSize / blockAlign;
+            }
+        }
+
         private void Load()
         {
-            uint riffHeader = reader.ReadUInt32();
+            if (reader.ReadUInt32() != RiffID)
+            {
+                throw new InvalidDataException("not a RIFF file");
+            }
             fileSize = reader.ReadUInt32();
+            if (reader.ReadUInt32() != WaveID)
+            {
+                throw new InvalidDataException("not a WAVE file");
+            }
 
-            uint riffType = reader.ReadUInt32();
-
-            uint chunkID = reader.ReadUInt32();
-            uint chunkSize = reader.ReadUInt32();
+            // Walk the chunks up to the data, skipping the ones unknown
+            // such as LIST or fact.
+            bool format = false;
+            for (;;)
+            {
+                uint chunkID = reader.ReadUInt32();
+                uint chunkSize = reader.ReadUInt32();
+                long padded = chunkSize + (chunkSize & 1);
 
-            ushort formatId = reader.ReadUInt16();
-            nChannels = reader.ReadUInt16();
-            samplingRate = reader.ReadUInt32();
-            dataRate = reader.ReadUInt32();
-            ushort blockSize = reader.ReadUInt16();
-            depth = reader.ReadUInt16();
+                if (chunkID == DataID)
+                {
+                    if (!format)
+                    {
+                        throw new InvalidDataException("no format chunk");
+                    }
+                    dataSize = chunkSize;
+                    dataLeft = chunkSize;
+                    return;
+                }
 
-            /*
-            if (dataRate != nChannels * blockSize) {
+                if (chunkID == FormatID && chunkSize >= 16)
+                {
+                    ushort formatId = reader.ReadUInt16();
+                    nChannels = reader.ReadUInt16();
+                    samplingRate = reader.ReadUInt32();
+                    dataRate = reader.ReadUInt32();
+                    blockAlign = reader.ReadUInt16();
+                    depth = reader.ReadUInt16();
+                    format = true;
+                    padded -= 16;
+                }
+                Skip(padded);
             }
-            */
+        }
 
-            if (chunkSize > 16) {
-                ushort xSize = reader.ReadUInt16();
-                reader.ReadBytes(xSize);
-            }
+        private void Skip(long count)
+        {
+            Stream st = reader.BaseStream;
 
-            uint dataID = reader.ReadUInt32();
-            dataSize = reader.ReadUInt32();
+            if (st.CanSeek)
+            {
+                st.Seek(count, SeekOrigin.Current);
+                return;
+            }
+            while (count > 0)
+            {
+                int n = st.Read(block, 0, (int)Math.Min(count, block.Length));
+                if (n == 0)
+                {
+                    throw new EndOfStreamException();
+                }
+                count -= n;
+            }
         }
 
         public WaveReader(Stream st) {
             reader = new BinaryReader(st);
+            block = new byte[BlockSize];
             Load();
         }
 
+        /// <summary>
+        /// Opens a file through a read-only mapping, so that the block
+        /// reads copy straight from the page cache.
+        /// </summary>
+        public static WaveReader OpenMapped(string path)
+        {
+            MemoryMappedFile map = MemoryMappedFile.CreateFromFile(
+                path, FileMode.Open, null, 0, MemoryMappedFileAccess.Read);
+
+            try
+            {
+                Stream st = map.CreateViewStream(0, 0,
+                                                 MemoryMappedFileAccess.Read);
+                WaveReader wr = new WaveReader(st);
+                wr.map = map;
+                return wr;
+            }
+            catch
+            {
+                map.Dispose();
+                throw;
+            }
+        }
+
         public void Close()
         {
             reader.Close();
+            if (map != null)
+            {
+                map.Dispose();
+            }
+        }
+
+        private void Consume(uint count)
+        {
+            dataLeft = dataLeft > count ? dataLeft - count : 0;
         }
 
         public Int16 ReadInt16()
         {
+            Consume(2);
             return reader.ReadInt16();
         }
 
         public UInt32 ReadUInt32()
         {
+            Consume(4);
             return reader.ReadUInt32();
         }
 
         public Int16 ReadMonoral()
         {
-            return reader.ReadInt16();
+            return ReadInt16();
         }
 
         public Int16[] ReadStereo()
         {
             Int16[] data = new Int16[2];
 
-            data[0] = reader.ReadInt16();
-            data[1] = reader.ReadInt16();
+            ReadStereo(out data[0], out data[1]);
 
             return data;
         }
 
+        public void ReadStereo(out Int16 left, out Int16 right)
+        {
+            left = ReadInt16();
+            right = ReadInt16();
+        }
+
         public int Read(byte[] buffer, int index, int count)
         {
-            return reader.Read(buffer, index, count);
+            int n = reader.Read(buffer, index, count);
+            Consume((uint)n);
+            return n;
+        }
+
+        /// <summary>
+        /// Reads the interleaved samples of the data chunk as they are.
+        /// </summary>
+        /// <returns>the number of samples read, 0 at the end.</returns>
+        public int ReadSamples(Span<short> buffer)
+        {
+            RequireDepth16();
+
+            int n = Fill(MemoryMarshal.AsBytes(buffer), 2) / 2;
+            Swap(buffer.Slice(0, n));
+            return n;
+        }
+
+        /// <summary>
+        /// Reads the samples of one channel, skipping the others.
+        /// </summary>
+        /// <returns>the number of frames read, 0 at the end.</returns>
+        public int ReadChannel(Span<short> buffer, int channel)
+        {
+            RequireChannel(channel);
+
+            int frames = 0;
+            while (frames < buffer.Length)
+            {
+                ReadOnlySpan<short> samples;
+                int n = NextBlock(buffer.Length - frames, out samples);
+                if (n == 0)
+                {
+                    break;
+                }
+                for (int i = 0; i < n; i++)
+                {
+                    buffer[frames + i] = samples[i * nChannels + channel];
+                }
+                frames += n;
+            }
+            return frames;
+        }
+
+        /// <summary>
+        /// Reads the samples of one channel scaled to [-1, 1).
+        /// </summary>
+        /// <returns>the number of frames read, 0 at the end.</returns>
+        public int ReadChannel(Span<float> buffer, int channel)
+        {
+            RequireChannel(channel);
+
+            int frames = 0;
+            while (frames < buffer.Length)
+            {
+                ReadOnlySpan<short> samples;
+                int n = NextBlock(buffer.Length - frames, out samples);
+                if (n == 0)
+                {
+                    break;
+                }
+                for (int i = 0; i < n; i++)
+                {
+                    buffer[frames + i] =
+                        samples[i * nChannels + channel] * (1.0f / 32768);
+                }
+                frames += n;
+            }
+            return frames;
+        }
+
+        /// <summary>
+        /// Reads count frames split into one array per channel, from the
+        /// index of each array.
+        /// </summary>
+        /// <returns>the number of frames read, 0 at the end.</returns>
+        public int ReadFrames(short[][] channels, int index, int count)
+        {
+            RequireChannels(channels.Length);
+
+            int frames = 0;
+            while (frames < count)
+            {
+                ReadOnlySpan<short> samples;
+                int n = NextBlock(count - frames, out samples);
+                if (n == 0)
+                {
+                    break;
+                }
+                for (int c = 0; c < nChannels; c++)
+                {
+                    short[] dest = channels[c];
+                    for (int i = 0; i < n; i++)
+                    {
+                        dest[index + frames + i] = samples[i * nChannels + c];
+                    }
+                }
+                frames += n;
+            }
+            return frames;
+        }
+
+        /// <summary>
+        /// Reads count frames split into one array per channel and scaled
+        /// to [-1, 1).
+        /// </summary>
+        /// <returns>the number of frames read, 0 at the end.</returns>
+        public int ReadFrames(float[][] channels, int index, int count)
+        {
+            RequireChannels(channels.Length);
+
+            int frames = 0;
+            while (frames < count)
+            {
+                ReadOnlySpan<short> samples;
+                int n = NextBlock(count - frames, out samples);
+                if (n == 0)
+                {
+                    break;
+                }
+                for (int c = 0; c < nChannels; c++)
+                {
+                    float[] dest = channels[c];
+                    for (int i = 0; i < n; i++)
+                    {
+                        dest[index + frames + i] =
+                            samples[i * nChannels + c] * (1.0f / 32768);
+                    }
+                }
+                frames += n;
+            }
+            return frames;
+        }
+
+        /// <summary>
+        /// Reads up to count whole frames into the block buffer.
+        /// </summary>
+        /// <returns>the number of frames read.</returns>
+        private int NextBlock(int count, out ReadOnlySpan<short> samples)
+        {
+            int frameSize = nChannels * 2;
+            int frames = Math.Min(count, block.Length / frameSize);
+            Span<byte> bytes = new Span<byte>(block, 0, frames * frameSize);
+
+            frames = Fill(bytes, frameSize) / frameSize;
+
+            Span<short> data = MemoryMarshal.Cast<byte, short>(
+                bytes.Slice(0, frames * frameSize));
+            Swap(data);
+            samples = data;
+            return frames;
+        }
+
+        /// <summary>
+        /// Reads the data chunk until the buffer is full or the chunk ends,
+        /// in multiples of unit bytes.
+        /// </summary>
+        private int Fill(Span<byte> buffer, int unit)
+        {
+            int count = (int)Math.Min(buffer.Length, dataLeft);
+            count -= count % unit;
+
+            Stream st = reader.BaseStream;
+            int n = 0;
+            while (n < count)
+            {
+                int r = st.Read(buffer.Slice(n, count - n));
+                if (r == 0)
+                {
+                    break;
+                }
+                n += r;
+            }
+            dataLeft -= (uint)n;
+            return n - n % unit;
+        }
+
+        private static void Swap(Span<short> samples)
+        {
+            if (BitConverter.IsLittleEndian)
+            {
+                return;
+            }
+            for (int i = 0; i < samples.Length; i++)
+            {
+                samples[i] = BinaryPrimitives.ReverseEndianness(samples[i]);
+            }
+        }
+
+        private void RequireDepth16()
+        {
+            if (depth != 16)
+            {
+                throw new NotSupportedException(
+                    "block reads need 16-bit samples");
+            }
+        }
+
+        private void RequireChannel(int channel)
+        {
+            RequireDepth16();
+            if (channel < 0 || channel >= nChannels)
+            {
+                throw new ArgumentOutOfRangeException("channel");
+            }
+        }
+
+        private void RequireChannels(int count)
+        {
+            RequireDepth16();
+            if (count < nChannels)
+            {
+                throw new ArgumentException("an array per channel is needed");
+            }
         }
     }
 }
-
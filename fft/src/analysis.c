@@ -0,0 +1,241 @@
+/**
+ * Per-block analysis
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "analysis.h"
+#include "stats.h"
+
+static size_t
+transform_size(const analysis_options_t *opts, size_t count)
+{
+    if (opts->fixed) {
+        return fixed_plan_size(count) + fixed_buffer_size(count)
+             + workspace_align(sizeof(double complex) * (count / 2));
+    }
+    if (opts->zoom_bins > 0) {
+        return czt_plan_size(count, opts->zoom_bins)
+             + czt_buffer_size(count, opts->zoom_bins);
+    }
+    if (opts->sparse > 0) {
+        return sparse_plan_size(count, opts->sparse)
+             + sparse_buffer_size(count, opts->sparse)
+             + workspace_align(sizeof(sparse_coeff_t) * opts->sparse);
+    }
+
+    size_t size = fft_plan_size(count) + fft_buffer_size(count);
+    if (opts->window != WINDOW_NONE) {
+        size += workspace_align(sizeof(double) * count);
+    }
+    if (opts->output.mels > 0) {
+        size += mel_plan_size(count, opts->output.mels, opts->output.coeffs)
+              + workspace_align(sizeof(float) * opts->output.coeffs);
+    }
+    return size;
+}
+
+size_t
+analysis_size(const analysis_options_t *opts, size_t count,
+              size_t sample_rate)
+{
+    size_t size = 0;
+
+    /* The fixed-point path works on the raw PCM only. */
+    if (opts->fixed && (opts->rate > 0 || opts->zoom_bins > 0)) {
+        return 0;
+    }
+    /* The zoom has a window of its own, the chirp. */
+    if (opts->window != WINDOW_NONE && (opts->fixed || opts->zoom_bins > 0)) {
+        return 0;
+    }
+    /* The features are computed from the full spectrum in floating point. */
+    if (opts->output.mels > 0 &&
+        (opts->fixed || opts->zoom_bins > 0 || opts->output.peaks > 0 ||
+         opts->output.mels > MEL_MAX || opts->output.coeffs == 0 ||
+         opts->output.coeffs > opts->output.mels)) {
+        return 0;
+    }
+    /* The sparse transform writes its bins as they are. */
+    if (opts->sparse > 0 &&
+        (opts->fixed || opts->zoom_bins > 0 || opts->output.peaks > 0 ||
+         opts->output.mels > 0 || opts->window != WINDOW_NONE)) {
+        return 0;
+    }
+
+    if (opts->rate > 0 && opts->rate != sample_rate) {
+        size_t rsize = resampler_size(sample_rate, opts->rate, count);
+        if (rsize == 0) {
+            return 0;
+        }
+        count = resampler_max_output(sample_rate, opts->rate, count);
+        size += rsize + workspace_align(sizeof(double) * count);
+    }
+
+    return size + transform_size(opts, count);
+}
+
+int
+analysis_init(analysis_t *a, const analysis_options_t *opts, size_t count,
+              size_t sample_rate, workspace_t *ws)
+{
+    a->opts = opts;
+    a->sample_rate = sample_rate;
+    a->resampled = NULL;
+    a->window = NULL;
+
+    if (opts->rate > 0 && opts->rate != sample_rate) {
+        if (resampler_init(&a->resampler, sample_rate, opts->rate, count,
+                           ws) < 0) {
+            return -1;
+        }
+        /* A block of one second keeps its duration at the new rate. */
+        size_t max = resampler_max_output(sample_rate, opts->rate, count);
+        a->resampled = workspace_get(ws, sizeof(double) * max);
+        if (a->resampled == NULL) {
+            return -1;
+        }
+        count = (count * opts->rate + sample_rate - 1) / sample_rate;
+        a->sample_rate = opts->rate;
+    }
+
+    a->count = count;
+
+    if (opts->fixed) {
+        if (fixed_plan_init(&a->fixed, count, ws) < 0) {
+            return -1;
+        }
+        a->fixed_buf = workspace_get(ws, fixed_buffer_size(count));
+        a->buf = workspace_get(ws, sizeof(double complex) * (count / 2));
+        return a->fixed_buf != NULL && a->buf != NULL ? 0 : -1;
+    }
+
+    if (opts->zoom_bins > 0) {
+        if (czt_plan_init(&a->czt, count, opts->zoom_bins, opts->zoom_lo,
+                          opts->zoom_hi, a->sample_rate, ws) < 0) {
+            return -1;
+        }
+        a->buf = workspace_get(ws, czt_buffer_size(count, opts->zoom_bins));
+    }
+    else if (opts->sparse > 0) {
+        if (sparse_plan_init(&a->sparse, count, opts->sparse,
+                             opts->sparse_tolerance, ws) < 0) {
+            return -1;
+        }
+        a->buf = workspace_get(ws, sparse_buffer_size(count, opts->sparse));
+        a->coeffs = workspace_get(ws, sizeof(sparse_coeff_t) * opts->sparse);
+        if (a->coeffs == NULL) {
+            return -1;
+        }
+    }
+    else {
+        if (fft_plan_init(&a->fft, count, ws) < 0) {
+            return -1;
+        }
+        a->buf = workspace_get(ws, fft_buffer_size(count));
+    }
+
+    if (opts->window != WINDOW_NONE) {
+        a->window = workspace_get(ws, sizeof(double) * count);
+        if (a->window == NULL) {
+            return -1;
+        }
+        window_init(a->window, opts->window, count);
+    }
+
+    if (opts->output.mels > 0) {
+        if (mel_plan_init(&a->mel, count, a->sample_rate, opts->output.mels,
+                          opts->output.coeffs, ws) < 0) {
+            return -1;
+        }
+        a->features = workspace_get(ws, sizeof(float) * opts->output.coeffs);
+        if (a->features == NULL) {
+            return -1;
+        }
+    }
+
+    return a->buf != NULL ? 0 : -1;
+}
+
+/*
+ * Writes the spectrum in the buffer, or its features.
+ */
+static size_t
+write_spectrum(analysis_t *a, FILE *out)
+{
+    if (a->opts->output.mels > 0) {
+        mel_execute(&a->mel, a->buf, a->features);
+        return output_features(out, &a->opts->output, a->features,
+                               a->mel.coeffs);
+    }
+    return output_result(out, &a->opts->output, &a->fft, a->sample_rate,
+                         a->buf);
+}
+
+void
+analysis_run(analysis_t *a, const double *samples, size_t len, FILE *out)
+{
+    uint64_t t0;
+    size_t bytes;
+
+    if (a->resampled != NULL) {
+        t0 = stats_begin();
+        len = resampler_run(&a->resampler, samples, len, a->resampled);
+        samples = a->resampled;
+        stats_end(STATS_RESAMPLE, t0);
+    }
+
+    if (a->opts->zoom_bins > 0) {
+        czt_execute(&a->czt, samples, len, a->buf);
+        t0 = stats_begin();
+        bytes = output_zoom(out, &a->opts->output, &a->czt, a->buf);
+    }
+    else if (a->opts->sparse > 0) {
+        int dense;
+        size_t n = sparse_execute(&a->sparse, samples, len, a->buf,
+                                  a->coeffs, &dense);
+        t0 = stats_begin();
+        bytes = output_sparse(out, &a->opts->output, &a->sparse,
+                              a->sample_rate, a->coeffs, n, dense);
+    }
+    else {
+        fft_execute_window(&a->fft, samples, a->window, len, a->buf);
+        t0 = stats_begin();
+        bytes = write_spectrum(a, out);
+    }
+    stats_end(STATS_OUTPUT, t0);
+    STATS_ADD(output_bytes, bytes);
+}
+
+int
+analysis_run_pcm(analysis_t *a, wave_handle_t *h,
+                 const wave_read_buffer_t *rbuf, size_t len, unsigned int ch,
+                 FILE *out)
+{
+    if (!a->opts->fixed) {
+        if (fft_execute_pcm(&a->fft, h, rbuf, len, ch, a->window,
+                            a->buf) < 0) {
+            return -1;
+        }
+        uint64_t t0 = stats_begin();
+        size_t bytes = write_spectrum(a, out);
+        stats_end(STATS_OUTPUT, t0);
+        STATS_ADD(output_bytes, bytes);
+        return 0;
+    }
+
+    int exp = fixed_execute(&a->fixed, h, rbuf, len, ch, a->fixed_buf);
+    if (exp < 0) {
+        return -1;
+    }
+
+    /* Only the bins to be written are converted. */
+    uint64_t t0 = stats_begin();
+    fixed_to_complex(&a->fixed, a->fixed_buf, exp, a->count / 2, a->buf);
+    size_t bytes = output_result(out, &a->opts->output, &a->fixed.fft,
+                                 a->sample_rate, a->buf);
+    stats_end(STATS_OUTPUT, t0);
+    STATS_ADD(output_bytes, bytes);
+
+    return 0;
+}
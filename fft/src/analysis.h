@@ -0,0 +1,189 @@
+#ifndef FOURIER_ANALYSIS_H
+#define FOURIER_ANALYSIS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <complex.h>
+#include "transform.h"
+#include "czt.h"
+#include "resample.h"
+#include "fixed.h"
+#include "mel.h"
+#include "sparse.h"
+#include "window.h"
+#include "output.h"
+#include "workspace.h"
+
+typedef struct analysis_options
+{
+    /**
+     * The selection of the result to be written.
+     */
+    output_options_t output;
+
+    /**
+     * The number of bins of the zoomed band, or 0 for the full spectrum.
+     */
+    size_t zoom_bins;
+
+    /**
+     * The band to be zoomed into in Hz.
+     */
+    double zoom_lo;
+    double zoom_hi;
+
+    /**
+     * The rate the blocks are resampled to before the transform in Hz, or
+     * 0 to keep the rate of the file.
+     */
+    size_t rate;
+
+    /**
+     * Transform the raw PCM with the fixed-point FFT.
+     */
+    int fixed;
+
+    /**
+     * The window applied to the samples of the spectrum.
+     */
+    enum window_type window;
+
+    /**
+     * The number of bins recovered by the sparse transform, or 0 for the
+     * full spectrum.
+     */
+    size_t sparse;
+
+    /**
+     * The largest relative RMS error of a sparse result.
+     */
+    double sparse_tolerance;
+} analysis_options_t;
+
+/**
+ * The transform applied to every block and its output.
+ */
+typedef struct analysis
+{
+    const analysis_options_t *opts;
+
+    /**
+     * The number of samples in a block given to the transform.
+     */
+    size_t count;
+
+    /**
+     * The sampling rate of the transformed samples.
+     */
+    double sample_rate;
+
+    /**
+     * The front end resampling the blocks, if opts->rate is set.
+     */
+    resampler_t resampler;
+
+    /**
+     * The resampled block.
+     */
+    double *resampled;
+
+    fft_plan_t fft;
+    czt_plan_t czt;
+    fixed_plan_t fixed;
+    mel_plan_t mel;
+    sparse_plan_t sparse;
+
+    /**
+     * The transform buffer.
+     */
+    double complex *buf;
+
+    /**
+     * The buffer of the fixed-point transform.
+     */
+    int32_t *fixed_buf;
+
+    /**
+     * The cepstral coefficients of a block, if opts->output.mels is set.
+     */
+    float *features;
+
+    /**
+     * The window of count elements, or NULL.
+     */
+    double *window;
+
+    /**
+     * The bins recovered by the sparse transform, if opts->sparse is set.
+     */
+    sparse_coeff_t *coeffs;
+} analysis_t;
+
+/**
+ * Returns the size of the workspace needed for the analysis.
+ *
+ * @param opts          the options.
+ * @param count         the number of samples in a block.
+ * @param sample_rate   the sampling rate in Hz.
+ * @return              the size in bytes, 0 if the options cannot be
+ *                      applied.
+ */
+size_t analysis_size(const analysis_options_t *opts, size_t count,
+                     size_t sample_rate);
+
+/**
+ * Initializes the analysis with the tables and buffers in the workspace.
+ *
+ * @param a             the analysis.
+ * @param opts          the options.
+ * @param count         the number of samples in a block.
+ * @param sample_rate   the sampling rate in Hz.
+ * @param ws            the workspace with at least analysis_size() bytes
+ *                      left.
+ * @return              0 on success, -1 on failure.
+ */
+int analysis_init(analysis_t *a, const analysis_options_t *opts, size_t count,
+                  size_t sample_rate, workspace_t *ws);
+
+/**
+ * Transforms a block and writes the result.
+ *
+ * @param a         the analysis.
+ * @param samples   the samples of the block.
+ * @param len       the number of samples, at most the count given to
+ *                  analysis_init().
+ * @param out       the output stream.
+ */
+void analysis_run(analysis_t *a, const double *samples, size_t len, FILE *out);
+
+/**
+ * Returns whether analysis_run_pcm() may be given the blocks.  The
+ * resampler, the zoom and the sparse transform need the samples in
+ * floating point.
+ */
+static inline int
+analysis_accepts_pcm(const analysis_t *a)
+{
+    return a->opts->fixed ||
+           (a->resampled == NULL && a->opts->zoom_bins == 0 &&
+            a->opts->sparse == 0);
+}
+
+/**
+ * Transforms a channel of a block of raw PCM and writes the result.  The
+ * samples are loaded straight into the transform buffer, or into the
+ * fixed-point transform which skips the conversion to floating point.
+ *
+ * @param a     the analysis.
+ * @param h     the handle of the wave file.
+ * @param rbuf  the raw PCM.
+ * @param len   the number of frames.
+ * @param ch    the channel.
+ * @param out   the output stream.
+ * @return      0 on success, -1 if the format is not supported.
+ */
+int analysis_run_pcm(analysis_t *a, wave_handle_t *h,
+                     const wave_read_buffer_t *rbuf, size_t len,
+                     unsigned int ch, FILE *out);
+
+#endif /* FOURIER_ANALYSIS_H */
@@ -0,0 +1,413 @@
+/**
+ * Batch analysis of many wave files
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "batch.h"
+#include "mel.h"
+#include "pool.h"
+#include "plancache.h"
+#include "output.h"
+#include "wave.h"
+#include "window.h"
+#include "workspace.h"
+
+/*
+ * Per-file result, filled by the worker which has analyzed the file.
+ */
+typedef struct batch_result
+{
+    off_t offset;
+    size_t length;
+    int status;
+} batch_result_t;
+
+/*
+ * Scratch memory of a worker.  It grows with the largest block seen and
+ * is reused for every file.
+ */
+typedef struct batch_worker
+{
+    workspace_t *ws;
+    size_t rlen;
+    size_t count;
+    wave_read_buffer_t rbuf;
+    double complex *buf;
+
+    /*
+     * The window of the size of the last block, or NULL.
+     */
+    double *window;
+    size_t window_count;
+
+    /*
+     * The filterbank for the size and the rate of the last file.
+     */
+    workspace_t *mel_ws;
+    size_t mel_count;
+    uint32_t mel_rate;
+    mel_plan_t mel;
+    float *features;
+} batch_worker_t;
+
+typedef struct batch
+{
+    path_list_t *list;
+    batch_result_t *results;
+    batch_worker_t *workers;
+    plan_cache_t plans;
+    size_t nblocks;
+    int window;
+    const output_options_t *opts;
+    FILE *out;
+    off_t offset;
+    pthread_mutex_t lock;
+} batch_t;
+
+static int
+path_list_add(path_list_t *list, const char *path)
+{
+    if (list->count == list->capacity) {
+        size_t capacity = list->capacity > 0 ? list->capacity * 2 : 64;
+        char **paths = realloc(list->paths, sizeof(char *) * capacity);
+        if (paths == NULL) {
+            return -1;
+        }
+        list->paths = paths;
+        list->capacity = capacity;
+    }
+
+    list->paths[list->count] = strdup(path);
+    if (list->paths[list->count] == NULL) {
+        return -1;
+    }
+    list->count++;
+
+    return 0;
+}
+
+void
+path_list_free(path_list_t *list)
+{
+    for (size_t i = 0; i < list->count; i++) {
+        free(list->paths[i]);
+    }
+    free(list->paths);
+}
+
+static int
+compare_paths(const void *a, const void *b)
+{
+    return strcmp(*(char * const *)a, *(char * const *)b);
+}
+
+static int
+load_directory(path_list_t *list, const char *dir)
+{
+    DIR *d = opendir(dir);
+    if (d == NULL) {
+        return -1;
+    }
+
+    int ret = 0;
+    struct dirent *ent;
+    while ((ent = readdir(d)) != NULL) {
+        size_t len = strlen(ent->d_name);
+        if (len < 4 || strcasecmp(ent->d_name + len - 4, ".wav") != 0) {
+            continue;
+        }
+
+        char *path = malloc(strlen(dir) + len + 2);
+        if (path == NULL) {
+            ret = -1;
+            break;
+        }
+        sprintf(path, "%s/%s", dir, ent->d_name);
+        ret = path_list_add(list, path);
+        free(path);
+        if (ret < 0) {
+            break;
+        }
+    }
+    closedir(d);
+
+    /* Keep the indices stable regardless of the order of the entries. */
+    qsort(list->paths, list->count, sizeof(char *), compare_paths);
+
+    return ret;
+}
+
+static int
+load_list(path_list_t *list, const char *file)
+{
+    FILE *in = strcmp(file, "-") == 0 ? stdin : fopen(file, "r");
+    if (in == NULL) {
+        return -1;
+    }
+
+    int ret = 0;
+    char *line = NULL;
+    size_t cap = 0;
+    ssize_t len;
+    while ((len = getline(&line, &cap, in)) != -1) {
+        while (len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r')) {
+            line[--len] = '\0';
+        }
+        if (len == 0 || line[0] == '#') {
+            continue;
+        }
+        if ((ret = path_list_add(list, line)) < 0) {
+            break;
+        }
+    }
+    free(line);
+
+    if (in != stdin) {
+        fclose(in);
+    }
+
+    return ret;
+}
+
+int
+path_list_load(path_list_t *list, const char *src)
+{
+    struct stat st;
+
+    if (stat(src, &st) == 0 && S_ISDIR(st.st_mode)) {
+        return load_directory(list, src);
+    }
+    return load_list(list, src);
+}
+
+static int
+reserve(batch_worker_t *w, size_t rlen, size_t count, int window)
+{
+    if (w->ws != NULL && rlen <= w->rlen && count <= w->count) {
+        goto fill;
+    }
+
+    if (w->ws != NULL) {
+        workspace_destroy(w->ws);
+    }
+
+    size_t wsize = workspace_align(rlen) + fft_buffer_size(count)
+                 + workspace_align(sizeof(double) * count);
+    w->ws = workspace_create(wsize, 0);
+    if (w->ws == NULL) {
+        return -1;
+    }
+
+    w->rlen = rlen;
+    w->count = count;
+    wave_init_read_buffer(&w->rbuf, workspace_get(w->ws, rlen), rlen);
+    w->buf = workspace_get(w->ws, fft_buffer_size(count));
+    w->window = workspace_get(w->ws, sizeof(double) * count);
+    w->window_count = 0;
+
+fill:
+    if (window != WINDOW_NONE && w->window_count != count) {
+        window_init(w->window, window, count);
+        w->window_count = count;
+    }
+
+    return 0;
+}
+
+static int
+reserve_mel(batch_worker_t *w, const output_options_t *opts, size_t count,
+            uint32_t sample_rate)
+{
+    if (w->mel_ws != NULL && count == w->mel_count &&
+        sample_rate == w->mel_rate) {
+        return 0;
+    }
+
+    if (w->mel_ws != NULL) {
+        workspace_destroy(w->mel_ws);
+    }
+
+    size_t wsize = mel_plan_size(count, opts->mels, opts->coeffs)
+                 + workspace_align(sizeof(float) * opts->coeffs);
+    w->mel_ws = workspace_create(wsize, 0);
+    if (w->mel_ws == NULL) {
+        return -1;
+    }
+
+    if (mel_plan_init(&w->mel, count, sample_rate, opts->mels, opts->coeffs,
+                      w->mel_ws) < 0) {
+        workspace_destroy(w->mel_ws);
+        w->mel_ws = NULL;
+        return -1;
+    }
+    w->features = workspace_get(w->mel_ws, sizeof(float) * opts->coeffs);
+    w->mel_count = count;
+    w->mel_rate = sample_rate;
+
+    return 0;
+}
+
+static int
+analyze(batch_t *b, batch_worker_t *w, const char *path, FILE *out)
+{
+    wave_handle_t *handle = wave_open(path, O_RDONLY);
+    if (handle == NULL) {
+        return -1;
+    }
+
+    output_header(out, b->opts, handle);
+
+    int ret = -1;
+    size_t rlen = wave_read_buffer_size(handle, 1);
+    size_t count = rlen / wave_bsize(handle);
+    const fft_plan_t *plan = plan_cache_get(&b->plans, count);
+    if (plan == NULL || reserve(w, rlen, count, b->window) < 0) {
+        goto exit;
+    }
+    if (b->opts->mels > 0 &&
+        reserve_mel(w, b->opts, count, wave_sr(handle)) < 0) {
+        goto exit;
+    }
+
+    /* The buffer may be larger than a block of this file. */
+    wave_read_buffer_t rbuf;
+    wave_init_read_buffer(&rbuf, w->rbuf.body, rlen);
+
+    for (size_t n = 0; b->nblocks == 0 || n < b->nblocks; n++) {
+        ssize_t length = wave_rawread(handle, &rbuf);
+        if (length < 0) {
+            goto exit;
+        }
+        if (length == 0) {
+            break;
+        }
+        fprintf(out, "# %zd samples read.\n", length);
+
+        size_t len = length / wave_bsize(handle);
+        fprintf(out, "# %zu samples to be processed.\n", len);
+
+        const double *window = b->window != WINDOW_NONE ? w->window : NULL;
+        if (fft_execute_pcm(plan, handle, &rbuf, len, 0, window,
+                            w->buf) < 0) {
+            goto exit;
+        }
+        if (b->opts->mels > 0) {
+            mel_execute(&w->mel, w->buf, w->features);
+            output_features(out, b->opts, w->features, w->mel.coeffs);
+        }
+        else {
+            output_result(out, b->opts, plan, wave_sr(handle), w->buf);
+        }
+    }
+    ret = 0;
+
+exit:
+    wave_close(handle);
+    return ret;
+}
+
+static void
+run(size_t task, size_t worker, void *arg)
+{
+    batch_t *b = arg;
+    batch_result_t *res = &b->results[task];
+    const char *path = b->list->paths[task];
+
+    /*
+     * Format the record aside so that the shared output is locked only
+     * for a single write.
+     */
+    char *text = NULL;
+    size_t size = 0;
+    FILE *out = open_memstream(&text, &size);
+    if (out == NULL) {
+        res->status = -1;
+        return;
+    }
+
+    fprintf(out, "# file %zu %s\n", task, path);
+    res->status = analyze(b, &b->workers[worker], path, out);
+    fclose(out);
+
+    pthread_mutex_lock(&b->lock);
+    res->offset = b->offset;
+    res->length = fwrite(text, 1, size, b->out);
+    b->offset += res->length;
+    pthread_mutex_unlock(&b->lock);
+
+    free(text);
+}
+
+int
+batch_run(const char *src, FILE *out, size_t nthreads, size_t nblocks,
+          int window, const output_options_t *opts)
+{
+    int ret = -1;
+    path_list_t list = { NULL, 0, 0 };
+
+    if (path_list_load(&list, src) < 0) {
+        path_list_free(&list);
+        return -1;
+    }
+
+    if (nthreads == 0) {
+        nthreads = pool_ncpus();
+    }
+
+    batch_t b;
+    b.list = &list;
+    b.nblocks = nblocks;
+    b.window = window;
+    b.opts = opts;
+    b.out = out;
+    /* Track the offsets by hand as the output may be a pipe. */
+    b.offset = ftello(out) > 0 ? ftello(out) : 0;
+    b.results = calloc(list.count > 0 ? list.count : 1,
+                       sizeof(batch_result_t));
+    b.workers = calloc(nthreads, sizeof(batch_worker_t));
+    if (b.results == NULL || b.workers == NULL) {
+        ret = -1;
+        goto exit;
+    }
+    plan_cache_init(&b.plans);
+    pthread_mutex_init(&b.lock, NULL);
+
+    ret = pool_run(list.count, nthreads, run, &b);
+
+    off_t index_offset = b.offset;
+    fprintf(out, "# index %zu\n", list.count);
+    for (size_t i = 0; i < list.count; i++) {
+        fprintf(out, "# %zu %lld %zu %d %s\n", i,
+                (long long)b.results[i].offset, b.results[i].length,
+                b.results[i].status, list.paths[i]);
+        if (b.results[i].status < 0) {
+            ret = -1;
+        }
+    }
+    fprintf(out, "# index_offset %lld\n", (long long)index_offset);
+
+    for (size_t i = 0; i < nthreads; i++) {
+        if (b.workers[i].ws != NULL) {
+            workspace_destroy(b.workers[i].ws);
+        }
+        if (b.workers[i].mel_ws != NULL) {
+            workspace_destroy(b.workers[i].mel_ws);
+        }
+    }
+    pthread_mutex_destroy(&b.lock);
+    plan_cache_destroy(&b.plans);
+
+exit:
+    free(b.workers);
+    free(b.results);
+    path_list_free(&list);
+    return ret;
+}
@@ -0,0 +1,60 @@
+#ifndef FOURIER_BATCH_H
+#define FOURIER_BATCH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "output.h"
+
+/**
+ * The paths of the files of a batch.
+ */
+typedef struct path_list
+{
+    char **paths;
+    size_t count;
+    size_t capacity;
+} path_list_t;
+
+/**
+ * Lists the wave files of a directory, sorted so that the indices do not
+ * depend on the order of the entries, or the paths of a text file.
+ *
+ * @param list  the empty list.
+ * @param src   a directory holding the wave files, or a text file listing
+ *              one path per line ("-" for the standard input).
+ * @return      0 on success, -1 on failure, in which case the list still
+ *              has to be released.
+ */
+int path_list_load(path_list_t *list, const char *src);
+
+/**
+ * Releases the paths of a list.
+ */
+void path_list_free(path_list_t *list);
+
+/**
+ * Analyzes many wave files on a work-stealing thread pool.
+ *
+ * The spectra of every file are written to the output as a record
+ * starting with "# file <index> <path>".  The records appear in the order
+ * of completion; an index at the end of the output maps every file to the
+ * offset and the length of its record:
+ *
+ *   # index <number of files>
+ *   # <index> <offset> <length> <status> <path>
+ *   ...
+ *   # index_offset <offset of the "# index" line>
+ *
+ * @param src       a directory holding the wave files, or a text file
+ *                  listing one path per line ("-" for the standard input).
+ * @param out       the output stream.
+ * @param nthreads  the number of workers, 0 for the number of CPUs.
+ * @param nblocks   the number of 1-second blocks per file, 0 for all.
+ * @param window    the window applied to every block.
+ * @param opts      the selection of the result to be written.
+ * @return          0 if all the files have been analyzed, -1 otherwise.
+ */
+int batch_run(const char *src, FILE *out, size_t nthreads, size_t nblocks,
+              int window, const output_options_t *opts);
+
+#endif /* FOURIER_BATCH_H */
@@ -0,0 +1,313 @@
+/**
+ * Content-addressed cache of the output
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "cache.h"
+#include "output.h"
+
+#define CACHE_MAGIC     "FSPC"
+#define CACHE_SUFFIX    ".spc"
+
+/*
+ * The name of an entry, 16 hexadecimal digits and the suffix.
+ */
+#define NAME_LENGTH     (16 + sizeof(CACHE_SUFFIX) - 1)
+
+typedef struct victim
+{
+    char name[NAME_LENGTH + 1];
+    off_t size;
+    struct timespec used;
+} victim_t;
+
+static ssize_t
+write_full(int fd, const void *buf, size_t count)
+{
+    size_t done = 0;
+
+    while (done < count) {
+        ssize_t sz = write(fd, (const uint8_t *)buf + done, count - done);
+        if (sz < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        done += sz;
+    }
+
+    return done;
+}
+
+int
+cache_key(char *key, const char *path, const char *params)
+{
+    struct stat st;
+
+    if (stat(path, &st) < 0 || !S_ISREG(st.st_mode)) {
+        return -1;
+    }
+
+    /* The device, inode, size and mtime stand for the contents. */
+    int n = snprintf(key, CACHE_KEY_MAX, "%d:%ju:%ju:%jd:%jd.%09ld:%s",
+                     CACHE_VERSION, (uintmax_t)st.st_dev,
+                     (uintmax_t)st.st_ino, (intmax_t)st.st_size,
+                     (intmax_t)st.st_mtim.tv_sec, st.st_mtim.tv_nsec,
+                     params);
+    return n < 0 || n >= CACHE_KEY_MAX ? -1 : 0;
+}
+
+/*
+ * Returns the path of the entry of the key, named by its FNV-1a hash.
+ */
+static char *
+entry_path(const char *dir, const char *key)
+{
+    uint64_t hash = 0xcbf29ce484222325;
+    for (const char *p = key; *p != '\0'; p++) {
+        hash = (hash ^ (uint8_t)*p) * 0x100000001b3;
+    }
+
+    char *path = malloc(strlen(dir) + 1 + NAME_LENGTH + 1);
+    if (path != NULL) {
+        sprintf(path, "%s/%016" PRIx64 CACHE_SUFFIX, dir, hash);
+    }
+    return path;
+}
+
+/*
+ * Returns the offset of the output if the mapped entry holds the key, 0
+ * otherwise.
+ */
+static size_t
+entry_match(const uint8_t *map, size_t size, const char *key)
+{
+    const cache_header_t *h = (const cache_header_t *)map;
+    size_t len = strlen(key);
+
+    if (size < sizeof(*h) ||
+        memcmp(h->magic, CACHE_MAGIC, sizeof(h->magic)) != 0 ||
+        h->version != CACHE_VERSION || h->key_length != len ||
+        size != sizeof(*h) + len + h->length ||
+        memcmp(map + sizeof(*h), key, len) != 0) {
+        return 0;
+    }
+    return sizeof(*h) + len;
+}
+
+int
+cache_lookup(const char *dir, const char *key, FILE *out)
+{
+    char *path = entry_path(dir, key);
+    if (path == NULL) {
+        return -1;
+    }
+    int efd = open(path, O_RDONLY);
+    free(path);
+    if (efd < 0) {
+        return 0;
+    }
+
+    int ret = 0;
+    struct stat st;
+    if (fstat(efd, &st) < 0 || st.st_size < (off_t)sizeof(cache_header_t)) {
+        goto exit;
+    }
+    uint8_t *map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, efd, 0);
+    if (map == MAP_FAILED) {
+        goto exit;
+    }
+
+    /* A corrupt entry is a miss, and is replaced by the analysis. */
+    size_t offset = entry_match(map, st.st_size, key);
+    if (offset > 0 &&
+        output_replay(out, map + offset, st.st_size - offset) >= 0) {
+        ret = fflush(out) == 0 ? 1 : -1;
+        /* Marks the entry as used for the eviction. */
+        futimens(efd, NULL);
+    }
+    munmap(map, st.st_size);
+
+exit:
+    close(efd);
+    return ret;
+}
+
+static void
+entry_free(cache_entry_t *entry)
+{
+    if (entry->fd >= 0) {
+        close(entry->fd);
+    }
+    free(entry->tmp);
+    free(entry->path);
+}
+
+int
+cache_begin(cache_entry_t *entry, const char *dir, size_t budget,
+            const char *key)
+{
+    entry->dir = dir;
+    entry->budget = budget;
+    entry->fd = -1;
+    entry->saved = -1;
+    entry->path = entry_path(dir, key);
+    entry->tmp = malloc(strlen(dir) + sizeof("/spc.XXXXXX"));
+    if (entry->path == NULL || entry->tmp == NULL) {
+        goto error;
+    }
+    sprintf(entry->tmp, "%s/spc.XXXXXX", dir);
+    entry->fd = mkstemp(entry->tmp);
+    if (entry->fd < 0) {
+        goto error;
+    }
+
+    /* The length is written once the output is complete. */
+    cache_header_t h = { CACHE_MAGIC, CACHE_VERSION, strlen(key), 0 };
+    entry->offset = sizeof(h) + h.key_length;
+    if (write_full(entry->fd, &h, sizeof(h)) < (ssize_t)sizeof(h) ||
+        write_full(entry->fd, key, h.key_length) < (ssize_t)h.key_length) {
+        goto error;
+    }
+
+    fflush(stdout);
+    entry->saved = dup(STDOUT_FILENO);
+    if (entry->saved < 0 || dup2(entry->fd, STDOUT_FILENO) < 0) {
+        goto error;
+    }
+
+    return 0;
+
+error:
+    if (entry->saved >= 0) {
+        close(entry->saved);
+    }
+    if (entry->fd >= 0) {
+        unlink(entry->tmp);
+    }
+    entry_free(entry);
+    return -1;
+}
+
+static int
+victim_compare(const void *a, const void *b)
+{
+    const struct timespec *x = &((const victim_t *)a)->used;
+    const struct timespec *y = &((const victim_t *)b)->used;
+
+    if (x->tv_sec != y->tv_sec) {
+        return x->tv_sec < y->tv_sec ? -1 : 1;
+    }
+    return (x->tv_nsec > y->tv_nsec) - (x->tv_nsec < y->tv_nsec);
+}
+
+/*
+ * Removes the least recently used entries until the directory fits in
+ * the budget.
+ */
+static void
+evict(const char *dir, size_t budget)
+{
+    DIR *d = opendir(dir);
+    if (d == NULL) {
+        return;
+    }
+
+    victim_t *victims = NULL;
+    size_t n = 0;
+    size_t cap = 0;
+    uint64_t total = 0;
+    struct dirent *e;
+    while ((e = readdir(d)) != NULL) {
+        size_t len = strlen(e->d_name);
+        struct stat st;
+        if (len != NAME_LENGTH ||
+            strcmp(e->d_name + len - strlen(CACHE_SUFFIX), CACHE_SUFFIX) ||
+            fstatat(dirfd(d), e->d_name, &st, 0) < 0) {
+            continue;
+        }
+        if (n == cap) {
+            size_t c = cap > 0 ? 2 * cap : 64;
+            victim_t *v = realloc(victims, sizeof(*v) * c);
+            if (v == NULL) {
+                goto exit;
+            }
+            victims = v;
+            cap = c;
+        }
+        memcpy(victims[n].name, e->d_name, len + 1);
+        victims[n].size = st.st_size;
+        victims[n].used = st.st_mtim;
+        total += st.st_size;
+        n++;
+    }
+
+    if (total > budget) {
+        qsort(victims, n, sizeof(*victims), victim_compare);
+        for (size_t i = 0; i < n && total > budget; i++) {
+            if (unlinkat(dirfd(d), victims[i].name, 0) == 0) {
+                total -= victims[i].size;
+            }
+        }
+    }
+
+exit:
+    free(victims);
+    closedir(d);
+}
+
+int
+cache_commit(cache_entry_t *entry, int ok)
+{
+    int ret = 0;
+
+    fflush(stdout);
+    off_t end = lseek(entry->fd, 0, SEEK_END);
+    if (dup2(entry->saved, STDOUT_FILENO) < 0) {
+        ret = -1;
+    }
+    close(entry->saved);
+
+    uint64_t length = end > (off_t)entry->offset ? end - entry->offset : 0;
+    if (ret < 0 || end < (off_t)entry->offset ||
+        pwrite(entry->fd, &length, sizeof(length),
+               offsetof(cache_header_t, length)) < (ssize_t)sizeof(length)) {
+        ok = 0;
+        ret = -1;
+    }
+    if (!ok || rename(entry->tmp, entry->path) < 0) {
+        unlink(entry->tmp);
+        ok = 0;
+    }
+
+    /* The output is formatted from the entry, as on a hit. */
+    if (ret == 0 && length > 0) {
+        uint8_t *map = mmap(NULL, end, PROT_READ, MAP_SHARED, entry->fd, 0);
+        if (map == MAP_FAILED ||
+            output_replay(stdout, map + entry->offset, length) < 0 ||
+            fflush(stdout) != 0) {
+            ret = -1;
+        }
+        if (map != MAP_FAILED) {
+            munmap(map, end);
+        }
+    }
+    entry_free(entry);
+
+    if (ok) {
+        evict(entry->dir, entry->budget);
+    }
+    return ret;
+}
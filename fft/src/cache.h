@@ -0,0 +1,119 @@
+#ifndef FOURIER_CACHE_H
+#define FOURIER_CACHE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+/**
+ * The default size of a cache directory in bytes.
+ */
+#define CACHE_BUDGET    ((size_t)1024 << 20)
+
+/**
+ * The largest key, including the terminating null character.
+ */
+#define CACHE_KEY_MAX   512
+
+/**
+ * The version of the entries, to be bumped whenever the output changes.
+ */
+#define CACHE_VERSION   3
+
+/**
+ * The header of an entry, followed by the key and the binary records of
+ * the output (see output_record_t).
+ */
+typedef struct cache_header
+{
+    char magic[4];
+    uint32_t version;
+    uint64_t key_length;
+    uint64_t length;
+} cache_header_t;
+
+/**
+ * An entry being written.
+ *
+ * The results are cached as the binary records the analysis writes to
+ * stdout in place of its text, so that a hit maps the entry and only
+ * formats it, and an entry takes about a third of the text.  The entries
+ * live in a directory, named by the hash of their key
+ * which they also hold; the modification time of an entry is the time it
+ * has last been used, and the least recently used entries are removed
+ * whenever the directory grows beyond its budget.
+ */
+typedef struct cache_entry
+{
+    /**
+     * The directory and the size it is kept under.
+     */
+    const char *dir;
+    size_t budget;
+
+    /**
+     * The entry being written to, renamed once it is complete.
+     */
+    char *tmp;
+    char *path;
+    int fd;
+
+    /**
+     * The original stdout.
+     */
+    int saved;
+
+    /**
+     * The size of the header and the key.
+     */
+    size_t offset;
+} cache_entry_t;
+
+/**
+ * Builds the key of the results of a file, made of the identity of its
+ * contents and of the parameters of the analysis.
+ *
+ * @param key       the buffer of CACHE_KEY_MAX bytes.
+ * @param path      the path of the file.
+ * @param params    the parameters.
+ * @return          0 on success, -1 if the file is not a regular one or
+ *                  the key is too long.
+ */
+int cache_key(char *key, const char *path, const char *params);
+
+/**
+ * Writes the output of an entry, if there is one with the key.
+ *
+ * @param dir   the directory of the cache.
+ * @param key   the key.
+ * @param out   the stream the records are formatted to.
+ * @return      1 if the entry has been written, 0 if there is none, -1 on
+ *              failure.
+ */
+int cache_lookup(const char *dir, const char *key, FILE *out);
+
+/**
+ * Creates an entry and redirects stdout to it.  The analysis is to write
+ * binary records, with output_options_t.binary set.
+ *
+ * @param entry     the entry.
+ * @param dir       the directory of the cache.
+ * @param budget    the size of the directory in bytes.
+ * @param key       the key.
+ * @return          0 on success, -1 on failure, in which case stdout is
+ *                  left as it is.
+ */
+int cache_begin(cache_entry_t *entry, const char *dir, size_t budget,
+                const char *key);
+
+/**
+ * Restores stdout and formats the records of the entry to it.  The entry is
+ * kept only if the analysis has succeeded.
+ *
+ * @param entry the entry.
+ * @param ok    whether the analysis has succeeded.
+ * @return      0 on success, -1 on failure.
+ */
+int cache_commit(cache_entry_t *entry, int ok);
+
+#endif /* FOURIER_CACHE_H */
@@ -0,0 +1,3077 @@
+/*
+ * Generated by tools/gencodelets.py; do not edit.
+ */
+
+#include <stdlib.h>
+#include <complex.h>
+#include "codelets.h"
+
+void
+dft_2(const double complex *in, size_t is, double complex *out, size_t os)
+{
+    const double t0 = creal(in[0 * is]);
+    const double t1 = cimag(in[0 * is]);
+    const double t2 = creal(in[1 * is]);
+    const double t3 = cimag(in[1 * is]);
+    const double t4 = t0 + t2;
+    const double t5 = t1 + t3;
+    const double t6 = t0 - t2;
+    const double t7 = t1 - t3;
+    out[0 * os] = CMPLX(t4, t5);
+    out[1 * os] = CMPLX(t6, t7);
+}
+
+void
+dft_4(const double complex *in, size_t is, double complex *out, size_t os)
+{
+    const double t0 = creal(in[0 * is]);
+    const double t1 = cimag(in[0 * is]);
+    const double t2 = creal(in[1 * is]);
+    const double t3 = cimag(in[1 * is]);
+    const double t4 = creal(in[2 * is]);
+    const double t5 = cimag(in[2 * is]);
+    const double t6 = creal(in[3 * is]);
+    const double t7 = cimag(in[3 * is]);
+    const double t8 = t0 + t4;
+    const double t9 = t1 + t5;
+    const double t10 = t0 - t4;
+    const double t11 = t1 - t5;
+    const double t12 = t2 + t6;
+    const double t13 = t3 + t7;
+    const double t14 = t2 - t6;
+    const double t15 = t3 - t7;
+    const double t16 = t8 + t12;
+    const double t17 = t9 + t13;
+    const double t18 = t8 - t12;
+    const double t19 = t9 - t13;
+    const double t20 = -t15;
+    const double t21 = t10 + t20;
+    const double t22 = t11 + t14;
+    const double t23 = t10 - t20;
+    const double t24 = t11 - t14;
+    out[0 * os] = CMPLX(t16, t17);
+    out[1 * os] = CMPLX(t21, t22);
+    out[2 * os] = CMPLX(t18, t19);
+    out[3 * os] = CMPLX(t23, t24);
+}
+
+void
+dft_8(const double complex *in, size_t is, double complex *out, size_t os)
+{
+    const double t0 = creal(in[0 * is]);
+    const double t1 = cimag(in[0 * is]);
+    const double t2 = creal(in[1 * is]);
+    const double t3 = cimag(in[1 * is]);
+    const double t4 = creal(in[2 * is]);
+    const double t5 = cimag(in[2 * is]);
+    const double t6 = creal(in[3 * is]);
+    const double t7 = cimag(in[3 * is]);
+    const double t8 = creal(in[4 * is]);
+    const double t9 = cimag(in[4 * is]);
+    const double t10 = creal(in[5 * is]);
+    const double t11 = cimag(in[5 * is]);
+    const double t12 = creal(in[6 * is]);
+    const double t13 = cimag(in[6 * is]);
+    const double t14 = creal(in[7 * is]);
+    const double t15 = cimag(in[7 * is]);
+    const double t16 = t0 + t8;
+    const double t17 = t1 + t9;
+    const double t18 = t0 - t8;
+    const double t19 = t1 - t9;
+    const double t20 = t4 + t12;
+    const double t21 = t5 + t13;
+    const double t22 = t4 - t12;
+    const double t23 = t5 - t13;
+    const double t24 = t16 + t20;
+    const double t25 = t17 + t21;
+    const double t26 = t16 - t20;
+    const double t27 = t17 - t21;
+    const double t28 = -t23;
+    const double t29 = t18 + t28;
+    const double t30 = t19 + t22;
+    const double t31 = t18 - t28;
+    const double t32 = t19 - t22;
+    const double t33 = t2 + t10;
+    const double t34 = t3 + t11;
+    const double t35 = t2 - t10;
+    const double t36 = t3 - t11;
+    const double t37 = t6 + t14;
+    const double t38 = t7 + t15;
+    const double t39 = t6 - t14;
+    const double t40 = t7 - t15;
+    const double t41 = t33 + t37;
+    const double t42 = t34 + t38;
+    const double t43 = t33 - t37;
+    const double t44 = t34 - t38;
+    const double t45 = -t40;
+    const double t46 = t35 + t45;
+    const double t47 = t36 + t39;
+    const double t48 = t35 - t45;
+    const double t49 = t36 - t39;
+    const double t50 = t24 + t41;
+    const double t51 = t25 + t42;
+    const double t52 = t24 - t41;
+    const double t53 = t25 - t42;
+    const double t54 = t46 - t47;
+    const double t55 = t46 + t47;
+    const double t56 = 0.70710678118654757 * t54;
+    const double t57 = 0.70710678118654757 * t55;
+    const double t58 = t29 + t56;
+    const double t59 = t30 + t57;
+    const double t60 = t29 - t56;
+    const double t61 = t30 - t57;
+    const double t62 = -t44;
+    const double t63 = t26 + t62;
+    const double t64 = t27 + t43;
+    const double t65 = t26 - t62;
+    const double t66 = t27 - t43;
+    const double t67 = t48 + t49;
+    const double t68 = t49 - t48;
+    const double t69 = -0.70710678118654757 * t67;
+    const double t70 = -0.70710678118654757 * t68;
+    const double t71 = t31 + t69;
+    const double t72 = t32 + t70;
+    const double t73 = t31 - t69;
+    const double t74 = t32 - t70;
+    out[0 * os] = CMPLX(t50, t51);
+    out[1 * os] = CMPLX(t58, t59);
+    out[2 * os] = CMPLX(t63, t64);
+    out[3 * os] = CMPLX(t71, t72);
+    out[4 * os] = CMPLX(t52, t53);
+    out[5 * os] = CMPLX(t60, t61);
+    out[6 * os] = CMPLX(t65, t66);
+    out[7 * os] = CMPLX(t73, t74);
+}
+
+void
+dft_16(const double complex *in, size_t is, double complex *out, size_t os)
+{
+    const double t0 = creal(in[0 * is]);
+    const double t1 = cimag(in[0 * is]);
+    const double t2 = creal(in[1 * is]);
+    const double t3 = cimag(in[1 * is]);
+    const double t4 = creal(in[2 * is]);
+    const double t5 = cimag(in[2 * is]);
+    const double t6 = creal(in[3 * is]);
+    const double t7 = cimag(in[3 * is]);
+    const double t8 = creal(in[4 * is]);
+    const double t9 = cimag(in[4 * is]);
+    const double t10 = creal(in[5 * is]);
+    const double t11 = cimag(in[5 * is]);
+    const double t12 = creal(in[6 * is]);
+    const double t13 = cimag(in[6 * is]);
+    const double t14 = creal(in[7 * is]);
+    const double t15 = cimag(in[7 * is]);
+    const double t16 = creal(in[8 * is]);
+    const double t17 = cimag(in[8 * is]);
+    const double t18 = creal(in[9 * is]);
+    const double t19 = cimag(in[9 * is]);
+    const double t20 = creal(in[10 * is]);
+    const double t21 = cimag(in[10 * is]);
+    const double t22 = creal(in[11 * is]);
+    const double t23 = cimag(in[11 * is]);
+    const double t24 = creal(in[12 * is]);
+    const double t25 = cimag(in[12 * is]);
+    const double t26 = creal(in[13 * is]);
+    const double t27 = cimag(in[13 * is]);
+    const double t28 = creal(in[14 * is]);
+    const double t29 = cimag(in[14 * is]);
+    const double t30 = creal(in[15 * is]);
+    const double t31 = cimag(in[15 * is]);
+    const double t32 = t0 + t16;
+    const double t33 = t1 + t17;
+    const double t34 = t0 - t16;
+    const double t35 = t1 - t17;
+    const double t36 = t8 + t24;
+    const double t37 = t9 + t25;
+    const double t38 = t8 - t24;
+    const double t39 = t9 - t25;
+    const double t40 = t32 + t36;
+    const double t41 = t33 + t37;
+    const double t42 = t32 - t36;
+    const double t43 = t33 - t37;
+    const double t44 = -t39;
+    const double t45 = t34 + t44;
+    const double t46 = t35 + t38;
+    const double t47 = t34 - t44;
+    const double t48 = t35 - t38;
+    const double t49 = t4 + t20;
+    const double t50 = t5 + t21;
+    const double t51 = t4 - t20;
+    const double t52 = t5 - t21;
+    const double t53 = t12 + t28;
+    const double t54 = t13 + t29;
+    const double t55 = t12 - t28;
+    const double t56 = t13 - t29;
+    const double t57 = t49 + t53;
+    const double t58 = t50 + t54;
+    const double t59 = t49 - t53;
+    const double t60 = t50 - t54;
+    const double t61 = -t56;
+    const double t62 = t51 + t61;
+    const double t63 = t52 + t55;
+    const double t64 = t51 - t61;
+    const double t65 = t52 - t55;
+    const double t66 = t40 + t57;
+    const double t67 = t41 + t58;
+    const double t68 = t40 - t57;
+    const double t69 = t41 - t58;
+    const double t70 = t62 - t63;
+    const double t71 = t62 + t63;
+    const double t72 = 0.70710678118654757 * t70;
+    const double t73 = 0.70710678118654757 * t71;
+    const double t74 = t45 + t72;
+    const double t75 = t46 + t73;
+    const double t76 = t45 - t72;
+    const double t77 = t46 - t73;
+    const double t78 = -t60;
+    const double t79 = t42 + t78;
+    const double t80 = t43 + t59;
+    const double t81 = t42 - t78;
+    const double t82 = t43 - t59;
+    const double t83 = t64 + t65;
+    const double t84 = t65 - t64;
+    const double t85 = -0.70710678118654757 * t83;
+    const double t86 = -0.70710678118654757 * t84;
+    const double t87 = t47 + t85;
+    const double t88 = t48 + t86;
+    const double t89 = t47 - t85;
+    const double t90 = t48 - t86;
+    const double t91 = t2 + t18;
+    const double t92 = t3 + t19;
+    const double t93 = t2 - t18;
+    const double t94 = t3 - t19;
+    const double t95 = t10 + t26;
+    const double t96 = t11 + t27;
+    const double t97 = t10 - t26;
+    const double t98 = t11 - t27;
+    const double t99 = t91 + t95;
+    const double t100 = t92 + t96;
+    const double t101 = t91 - t95;
+    const double t102 = t92 - t96;
+    const double t103 = -t98;
+    const double t104 = t93 + t103;
+    const double t105 = t94 + t97;
+    const double t106 = t93 - t103;
+    const double t107 = t94 - t97;
+    const double t108 = t6 + t22;
+    const double t109 = t7 + t23;
+    const double t110 = t6 - t22;
+    const double t111 = t7 - t23;
+    const double t112 = t14 + t30;
+    const double t113 = t15 + t31;
+    const double t114 = t14 - t30;
+    const double t115 = t15 - t31;
+    const double t116 = t108 + t112;
+    const double t117 = t109 + t113;
+    const double t118 = t108 - t112;
+    const double t119 = t109 - t113;
+    const double t120 = -t115;
+    const double t121 = t110 + t120;
+    const double t122 = t111 + t114;
+    const double t123 = t110 - t120;
+    const double t124 = t111 - t114;
+    const double t125 = t99 + t116;
+    const double t126 = t100 + t117;
+    const double t127 = t99 - t116;
+    const double t128 = t100 - t117;
+    const double t129 = t121 - t122;
+    const double t130 = t121 + t122;
+    const double t131 = 0.70710678118654757 * t129;
+    const double t132 = 0.70710678118654757 * t130;
+    const double t133 = t104 + t131;
+    const double t134 = t105 + t132;
+    const double t135 = t104 - t131;
+    const double t136 = t105 - t132;
+    const double t137 = -t119;
+    const double t138 = t101 + t137;
+    const double t139 = t102 + t118;
+    const double t140 = t101 - t137;
+    const double t141 = t102 - t118;
+    const double t142 = t123 + t124;
+    const double t143 = t124 - t123;
+    const double t144 = -0.70710678118654757 * t142;
+    const double t145 = -0.70710678118654757 * t143;
+    const double t146 = t106 + t144;
+    const double t147 = t107 + t145;
+    const double t148 = t106 - t144;
+    const double t149 = t107 - t145;
+    const double t150 = t66 + t125;
+    const double t151 = t67 + t126;
+    const double t152 = t66 - t125;
+    const double t153 = t67 - t126;
+    const double t154 = 0.92387953251128674 * t133 - 0.38268343236508978 * t134;
+    const double t155 = 0.38268343236508978 * t133 + 0.92387953251128674 * t134;
+    const double t156 = t74 + t154;
+    const double t157 = t75 + t155;
+    const double t158 = t74 - t154;
+    const double t159 = t75 - t155;
+    const double t160 = t138 - t139;
+    const double t161 = t138 + t139;
+    const double t162 = 0.70710678118654757 * t160;
+    const double t163 = 0.70710678118654757 * t161;
+    const double t164 = t79 + t162;
+    const double t165 = t80 + t163;
+    const double t166 = t79 - t162;
+    const double t167 = t80 - t163;
+    const double t168 = 0.38268343236508978 * t146 - 0.92387953251128674 * t147;
+    const double t169 = 0.92387953251128674 * t146 + 0.38268343236508978 * t147;
+    const double t170 = t87 + t168;
+    const double t171 = t88 + t169;
+    const double t172 = t87 - t168;
+    const double t173 = t88 - t169;
+    const double t174 = -t128;
+    const double t175 = t68 + t174;
+    const double t176 = t69 + t127;
+    const double t177 = t68 - t174;
+    const double t178 = t69 - t127;
+    const double t179 = -0.38268343236508978 * t135 - 0.92387953251128674 * t136;
+    const double t180 = 0.92387953251128674 * t135 + -0.38268343236508978 * t136;
+    const double t181 = t76 + t179;
+    const double t182 = t77 + t180;
+    const double t183 = t76 - t179;
+    const double t184 = t77 - t180;
+    const double t185 = t140 + t141;
+    const double t186 = t141 - t140;
+    const double t187 = -0.70710678118654757 * t185;
+    const double t188 = -0.70710678118654757 * t186;
+    const double t189 = t81 + t187;
+    const double t190 = t82 + t188;
+    const double t191 = t81 - t187;
+    const double t192 = t82 - t188;
+    const double t193 = -0.92387953251128674 * t148 - 0.38268343236508978 * t149;
+    const double t194 = 0.38268343236508978 * t148 + -0.92387953251128674 * t149;
+    const double t195 = t89 + t193;
+    const double t196 = t90 + t194;
+    const double t197 = t89 - t193;
+    const double t198 = t90 - t194;
+    out[0 * os] = CMPLX(t150, t151);
+    out[1 * os] = CMPLX(t156, t157);
+    out[2 * os] = CMPLX(t164, t165);
+    out[3 * os] = CMPLX(t170, t171);
+    out[4 * os] = CMPLX(t175, t176);
+    out[5 * os] = CMPLX(t181, t182);
+    out[6 * os] = CMPLX(t189, t190);
+    out[7 * os] = CMPLX(t195, t196);
+    out[8 * os] = CMPLX(t152, t153);
+    out[9 * os] = CMPLX(t158, t159);
+    out[10 * os] = CMPLX(t166, t167);
+    out[11 * os] = CMPLX(t172, t173);
+    out[12 * os] = CMPLX(t177, t178);
+    out[13 * os] = CMPLX(t183, t184);
+    out[14 * os] = CMPLX(t191, t192);
+    out[15 * os] = CMPLX(t197, t198);
+}
+
+void
+dft_32(const double complex *in, size_t is, double complex *out, size_t os)
+{
+    const double t0 = creal(in[0 * is]);
+    const double t1 = cimag(in[0 * is]);
+    const double t2 = creal(in[1 * is]);
+    const double t3 = cimag(in[1 * is]);
+    const double t4 = creal(in[2 * is]);
+    const double t5 = cimag(in[2 * is]);
+    const double t6 = creal(in[3 * is]);
+    const double t7 = cimag(in[3 * is]);
+    const double t8 = creal(in[4 * is]);
+    const double t9 = cimag(in[4 * is]);
+    const double t10 = creal(in[5 * is]);
+    const double t11 = cimag(in[5 * is]);
+    const double t12 = creal(in[6 * is]);
+    const double t13 = cimag(in[6 * is]);
+    const double t14 = creal(in[7 * is]);
+    const double t15 = cimag(in[7 * is]);
+    const double t16 = creal(in[8 * is]);
+    const double t17 = cimag(in[8 * is]);
+    const double t18 = creal(in[9 * is]);
+    const double t19 = cimag(in[9 * is]);
+    const double t20 = creal(in[10 * is]);
+    const double t21 = cimag(in[10 * is]);
+    const double t22 = creal(in[11 * is]);
+    const double t23 = cimag(in[11 * is]);
+    const double t24 = creal(in[12 * is]);
+    const double t25 = cimag(in[12 * is]);
+    const double t26 = creal(in[13 * is]);
+    const double t27 = cimag(in[13 * is]);
+    const double t28 = creal(in[14 * is]);
+    const double t29 = cimag(in[14 * is]);
+    const double t30 = creal(in[15 * is]);
+    const double t31 = cimag(in[15 * is]);
+    const double t32 = creal(in[16 * is]);
+    const double t33 = cimag(in[16 * is]);
+    const double t34 = creal(in[17 * is]);
+    const double t35 = cimag(in[17 * is]);
+    const double t36 = creal(in[18 * is]);
+    const double t37 = cimag(in[18 * is]);
+    const double t38 = creal(in[19 * is]);
+    const double t39 = cimag(in[19 * is]);
+    const double t40 = creal(in[20 * is]);
+    const double t41 = cimag(in[20 * is]);
+    const double t42 = creal(in[21 * is]);
+    const double t43 = cimag(in[21 * is]);
+    const double t44 = creal(in[22 * is]);
+    const double t45 = cimag(in[22 * is]);
+    const double t46 = creal(in[23 * is]);
+    const double t47 = cimag(in[23 * is]);
+    const double t48 = creal(in[24 * is]);
+    const double t49 = cimag(in[24 * is]);
+    const double t50 = creal(in[25 * is]);
+    const double t51 = cimag(in[25 * is]);
+    const double t52 = creal(in[26 * is]);
+    const double t53 = cimag(in[26 * is]);
+    const double t54 = creal(in[27 * is]);
+    const double t55 = cimag(in[27 * is]);
+    const double t56 = creal(in[28 * is]);
+    const double t57 = cimag(in[28 * is]);
+    const double t58 = creal(in[29 * is]);
+    const double t59 = cimag(in[29 * is]);
+    const double t60 = creal(in[30 * is]);
+    const double t61 = cimag(in[30 * is]);
+    const double t62 = creal(in[31 * is]);
+    const double t63 = cimag(in[31 * is]);
+    const double t64 = t0 + t32;
+    const double t65 = t1 + t33;
+    const double t66 = t0 - t32;
+    const double t67 = t1 - t33;
+    const double t68 = t16 + t48;
+    const double t69 = t17 + t49;
+    const double t70 = t16 - t48;
+    const double t71 = t17 - t49;
+    const double t72 = t64 + t68;
+    const double t73 = t65 + t69;
+    const double t74 = t64 - t68;
+    const double t75 = t65 - t69;
+    const double t76 = -t71;
+    const double t77 = t66 + t76;
+    const double t78 = t67 + t70;
+    const double t79 = t66 - t76;
+    const double t80 = t67 - t70;
+    const double t81 = t8 + t40;
+    const double t82 = t9 + t41;
+    const double t83 = t8 - t40;
+    const double t84 = t9 - t41;
+    const double t85 = t24 + t56;
+    const double t86 = t25 + t57;
+    const double t87 = t24 - t56;
+    const double t88 = t25 - t57;
+    const double t89 = t81 + t85;
+    const double t90 = t82 + t86;
+    const double t91 = t81 - t85;
+    const double t92 = t82 - t86;
+    const double t93 = -t88;
+    const double t94 = t83 + t93;
+    const double t95 = t84 + t87;
+    const double t96 = t83 - t93;
+    const double t97 = t84 - t87;
+    const double t98 = t72 + t89;
+    const double t99 = t73 + t90;
+    const double t100 = t72 - t89;
+    const double t101 = t73 - t90;
+    const double t102 = t94 - t95;
+    const double t103 = t94 + t95;
+    const double t104 = 0.70710678118654757 * t102;
+    const double t105 = 0.70710678118654757 * t103;
+    const double t106 = t77 + t104;
+    const double t107 = t78 + t105;
+    const double t108 = t77 - t104;
+    const double t109 = t78 - t105;
+    const double t110 = -t92;
+    const double t111 = t74 + t110;
+    const double t112 = t75 + t91;
+    const double t113 = t74 - t110;
+    const double t114 = t75 - t91;
+    const double t115 = t96 + t97;
+    const double t116 = t97 - t96;
+    const double t117 = -0.70710678118654757 * t115;
+    const double t118 = -0.70710678118654757 * t116;
+    const double t119 = t79 + t117;
+    const double t120 = t80 + t118;
+    const double t121 = t79 - t117;
+    const double t122 = t80 - t118;
+    const double t123 = t4 + t36;
+    const double t124 = t5 + t37;
+    const double t125 = t4 - t36;
+    const double t126 = t5 - t37;
+    const double t127 = t20 + t52;
+    const double t128 = t21 + t53;
+    const double t129 = t20 - t52;
+    const double t130 = t21 - t53;
+    const double t131 = t123 + t127;
+    const double t132 = t124 + t128;
+    const double t133 = t123 - t127;
+    const double t134 = t124 - t128;
+    const double t135 = -t130;
+    const double t136 = t125 + t135;
+    const double t137 = t126 + t129;
+    const double t138 = t125 - t135;
+    const double t139 = t126 - t129;
+    const double t140 = t12 + t44;
+    const double t141 = t13 + t45;
+    const double t142 = t12 - t44;
+    const double t143 = t13 - t45;
+    const double t144 = t28 + t60;
+    const double t145 = t29 + t61;
+    const double t146 = t28 - t60;
+    const double t147 = t29 - t61;
+    const double t148 = t140 + t144;
+    const double t149 = t141 + t145;
+    const double t150 = t140 - t144;
+    const double t151 = t141 - t145;
+    const double t152 = -t147;
+    const double t153 = t142 + t152;
+    const double t154 = t143 + t146;
+    const double t155 = t142 - t152;
+    const double t156 = t143 - t146;
+    const double t157 = t131 + t148;
+    const double t158 = t132 + t149;
+    const double t159 = t131 - t148;
+    const double t160 = t132 - t149;
+    const double t161 = t153 - t154;
+    const double t162 = t153 + t154;
+    const double t163 = 0.70710678118654757 * t161;
+    const double t164 = 0.70710678118654757 * t162;
+    const double t165 = t136 + t163;
+    const double t166 = t137 + t164;
+    const double t167 = t136 - t163;
+    const double t168 = t137 - t164;
+    const double t169 = -t151;
+    const double t170 = t133 + t169;
+    const double t171 = t134 + t150;
+    const double t172 = t133 - t169;
+    const double t173 = t134 - t150;
+    const double t174 = t155 + t156;
+    const double t175 = t156 - t155;
+    const double t176 = -0.70710678118654757 * t174;
+    const double t177 = -0.70710678118654757 * t175;
+    const double t178 = t138 + t176;
+    const double t179 = t139 + t177;
+    const double t180 = t138 - t176;
+    const double t181 = t139 - t177;
+    const double t182 = t98 + t157;
+    const double t183 = t99 + t158;
+    const double t184 = t98 - t157;
+    const double t185 = t99 - t158;
+    const double t186 = 0.92387953251128674 * t165 - 0.38268343236508978 * t166;
+    const double t187 = 0.38268343236508978 * t165 + 0.92387953251128674 * t166;
+    const double t188 = t106 + t186;
+    const double t189 = t107 + t187;
+    const double t190 = t106 - t186;
+    const double t191 = t107 - t187;
+    const double t192 = t170 - t171;
+    const double t193 = t170 + t171;
+    const double t194 = 0.70710678118654757 * t192;
+    const double t195 = 0.70710678118654757 * t193;
+    const double t196 = t111 + t194;
+    const double t197 = t112 + t195;
+    const double t198 = t111 - t194;
+    const double t199 = t112 - t195;
+    const double t200 = 0.38268343236508978 * t178 - 0.92387953251128674 * t179;
+    const double t201 = 0.92387953251128674 * t178 + 0.38268343236508978 * t179;
+    const double t202 = t119 + t200;
+    const double t203 = t120 + t201;
+    const double t204 = t119 - t200;
+    const double t205 = t120 - t201;
+    const double t206 = -t160;
+    const double t207 = t100 + t206;
+    const double t208 = t101 + t159;
+    const double t209 = t100 - t206;
+    const double t210 = t101 - t159;
+    const double t211 = -0.38268343236508978 * t167 - 0.92387953251128674 * t168;
+    const double t212 = 0.92387953251128674 * t167 + -0.38268343236508978 * t168;
+    const double t213 = t108 + t211;
+    const double t214 = t109 + t212;
+    const double t215 = t108 - t211;
+    const double t216 = t109 - t212;
+    const double t217 = t172 + t173;
+    const double t218 = t173 - t172;
+    const double t219 = -0.70710678118654757 * t217;
+    const double t220 = -0.70710678118654757 * t218;
+    const double t221 = t113 + t219;
+    const double t222 = t114 + t220;
+    const double t223 = t113 - t219;
+    const double t224 = t114 - t220;
+    const double t225 = -0.92387953251128674 * t180 - 0.38268343236508978 * t181;
+    const double t226 = 0.38268343236508978 * t180 + -0.92387953251128674 * t181;
+    const double t227 = t121 + t225;
+    const double t228 = t122 + t226;
+    const double t229 = t121 - t225;
+    const double t230 = t122 - t226;
+    const double t231 = t2 + t34;
+    const double t232 = t3 + t35;
+    const double t233 = t2 - t34;
+    const double t234 = t3 - t35;
+    const double t235 = t18 + t50;
+    const double t236 = t19 + t51;
+    const double t237 = t18 - t50;
+    const double t238 = t19 - t51;
+    const double t239 = t231 + t235;
+    const double t240 = t232 + t236;
+    const double t241 = t231 - t235;
+    const double t242 = t232 - t236;
+    const double t243 = -t238;
+    const double t244 = t233 + t243;
+    const double t245 = t234 + t237;
+    const double t246 = t233 - t243;
+    const double t247 = t234 - t237;
+    const double t248 = t10 + t42;
+    const double t249 = t11 + t43;
+    const double t250 = t10 - t42;
+    const double t251 = t11 - t43;
+    const double t252 = t26 + t58;
+    const double t253 = t27 + t59;
+    const double t254 = t26 - t58;
+    const double t255 = t27 - t59;
+    const double t256 = t248 + t252;
+    const double t257 = t249 + t253;
+    const double t258 = t248 - t252;
+    const double t259 = t249 - t253;
+    const double t260 = -t255;
+    const double t261 = t250 + t260;
+    const double t262 = t251 + t254;
+    const double t263 = t250 - t260;
+    const double t264 = t251 - t254;
+    const double t265 = t239 + t256;
+    const double t266 = t240 + t257;
+    const double t267 = t239 - t256;
+    const double t268 = t240 - t257;
+    const double t269 = t261 - t262;
+    const double t270 = t261 + t262;
+    const double t271 = 0.70710678118654757 * t269;
+    const double t272 = 0.70710678118654757 * t270;
+    const double t273 = t244 + t271;
+    const double t274 = t245 + t272;
+    const double t275 = t244 - t271;
+    const double t276 = t245 - t272;
+    const double t277 = -t259;
+    const double t278 = t241 + t277;
+    const double t279 = t242 + t258;
+    const double t280 = t241 - t277;
+    const double t281 = t242 - t258;
+    const double t282 = t263 + t264;
+    const double t283 = t264 - t263;
+    const double t284 = -0.70710678118654757 * t282;
+    const double t285 = -0.70710678118654757 * t283;
+    const double t286 = t246 + t284;
+    const double t287 = t247 + t285;
+    const double t288 = t246 - t284;
+    const double t289 = t247 - t285;
+    const double t290 = t6 + t38;
+    const double t291 = t7 + t39;
+    const double t292 = t6 - t38;
+    const double t293 = t7 - t39;
+    const double t294 = t22 + t54;
+    const double t295 = t23 + t55;
+    const double t296 = t22 - t54;
+    const double t297 = t23 - t55;
+    const double t298 = t290 + t294;
+    const double t299 = t291 + t295;
+    const double t300 = t290 - t294;
+    const double t301 = t291 - t295;
+    const double t302 = -t297;
+    const double t303 = t292 + t302;
+    const double t304 = t293 + t296;
+    const double t305 = t292 - t302;
+    const double t306 = t293 - t296;
+    const double t307 = t14 + t46;
+    const double t308 = t15 + t47;
+    const double t309 = t14 - t46;
+    const double t310 = t15 - t47;
+    const double t311 = t30 + t62;
+    const double t312 = t31 + t63;
+    const double t313 = t30 - t62;
+    const double t314 = t31 - t63;
+    const double t315 = t307 + t311;
+    const double t316 = t308 + t312;
+    const double t317 = t307 - t311;
+    const double t318 = t308 - t312;
+    const double t319 = -t314;
+    const double t320 = t309 + t319;
+    const double t321 = t310 + t313;
+    const double t322 = t309 - t319;
+    const double t323 = t310 - t313;
+    const double t324 = t298 + t315;
+    const double t325 = t299 + t316;
+    const double t326 = t298 - t315;
+    const double t327 = t299 - t316;
+    const double t328 = t320 - t321;
+    const double t329 = t320 + t321;
+    const double t330 = 0.70710678118654757 * t328;
+    const double t331 = 0.70710678118654757 * t329;
+    const double t332 = t303 + t330;
+    const double t333 = t304 + t331;
+    const double t334 = t303 - t330;
+    const double t335 = t304 - t331;
+    const double t336 = -t318;
+    const double t337 = t300 + t336;
+    const double t338 = t301 + t317;
+    const double t339 = t300 - t336;
+    const double t340 = t301 - t317;
+    const double t341 = t322 + t323;
+    const double t342 = t323 - t322;
+    const double t343 = -0.70710678118654757 * t341;
+    const double t344 = -0.70710678118654757 * t342;
+    const double t345 = t305 + t343;
+    const double t346 = t306 + t344;
+    const double t347 = t305 - t343;
+    const double t348 = t306 - t344;
+    const double t349 = t265 + t324;
+    const double t350 = t266 + t325;
+    const double t351 = t265 - t324;
+    const double t352 = t266 - t325;
+    const double t353 = 0.92387953251128674 * t332 - 0.38268343236508978 * t333;
+    const double t354 = 0.38268343236508978 * t332 + 0.92387953251128674 * t333;
+    const double t355 = t273 + t353;
+    const double t356 = t274 + t354;
+    const double t357 = t273 - t353;
+    const double t358 = t274 - t354;
+    const double t359 = t337 - t338;
+    const double t360 = t337 + t338;
+    const double t361 = 0.70710678118654757 * t359;
+    const double t362 = 0.70710678118654757 * t360;
+    const double t363 = t278 + t361;
+    const double t364 = t279 + t362;
+    const double t365 = t278 - t361;
+    const double t366 = t279 - t362;
+    const double t367 = 0.38268343236508978 * t345 - 0.92387953251128674 * t346;
+    const double t368 = 0.92387953251128674 * t345 + 0.38268343236508978 * t346;
+    const double t369 = t286 + t367;
+    const double t370 = t287 + t368;
+    const double t371 = t286 - t367;
+    const double t372 = t287 - t368;
+    const double t373 = -t327;
+    const double t374 = t267 + t373;
+    const double t375 = t268 + t326;
+    const double t376 = t267 - t373;
+    const double t377 = t268 - t326;
+    const double t378 = -0.38268343236508978 * t334 - 0.92387953251128674 * t335;
+    const double t379 = 0.92387953251128674 * t334 + -0.38268343236508978 * t335;
+    const double t380 = t275 + t378;
+    const double t381 = t276 + t379;
+    const double t382 = t275 - t378;
+    const double t383 = t276 - t379;
+    const double t384 = t339 + t340;
+    const double t385 = t340 - t339;
+    const double t386 = -0.70710678118654757 * t384;
+    const double t387 = -0.70710678118654757 * t385;
+    const double t388 = t280 + t386;
+    const double t389 = t281 + t387;
+    const double t390 = t280 - t386;
+    const double t391 = t281 - t387;
+    const double t392 = -0.92387953251128674 * t347 - 0.38268343236508978 * t348;
+    const double t393 = 0.38268343236508978 * t347 + -0.92387953251128674 * t348;
+    const double t394 = t288 + t392;
+    const double t395 = t289 + t393;
+    const double t396 = t288 - t392;
+    const double t397 = t289 - t393;
+    const double t398 = t182 + t349;
+    const double t399 = t183 + t350;
+    const double t400 = t182 - t349;
+    const double t401 = t183 - t350;
+    const double t402 = 0.98078528040323043 * t355 - 0.19509032201612828 * t356;
+    const double t403 = 0.19509032201612828 * t355 + 0.98078528040323043 * t356;
+    const double t404 = t188 + t402;
+    const double t405 = t189 + t403;
+    const double t406 = t188 - t402;
+    const double t407 = t189 - t403;
+    const double t408 = 0.92387953251128674 * t363 - 0.38268343236508978 * t364;
+    const double t409 = 0.38268343236508978 * t363 + 0.92387953251128674 * t364;
+    const double t410 = t196 + t408;
+    const double t411 = t197 + t409;
+    const double t412 = t196 - t408;
+    const double t413 = t197 - t409;
+    const double t414 = 0.83146961230254524 * t369 - 0.55557023301960218 * t370;
+    const double t415 = 0.55557023301960218 * t369 + 0.83146961230254524 * t370;
+    const double t416 = t202 + t414;
+    const double t417 = t203 + t415;
+    const double t418 = t202 - t414;
+    const double t419 = t203 - t415;
+    const double t420 = t374 - t375;
+    const double t421 = t374 + t375;
+    const double t422 = 0.70710678118654757 * t420;
+    const double t423 = 0.70710678118654757 * t421;
+    const double t424 = t207 + t422;
+    const double t425 = t208 + t423;
+    const double t426 = t207 - t422;
+    const double t427 = t208 - t423;
+    const double t428 = 0.55557023301960218 * t380 - 0.83146961230254524 * t381;
+    const double t429 = 0.83146961230254524 * t380 + 0.55557023301960218 * t381;
+    const double t430 = t213 + t428;
+    const double t431 = t214 + t429;
+    const double t432 = t213 - t428;
+    const double t433 = t214 - t429;
+    const double t434 = 0.38268343236508978 * t388 - 0.92387953251128674 * t389;
+    const double t435 = 0.92387953251128674 * t388 + 0.38268343236508978 * t389;
+    const double t436 = t221 + t434;
+    const double t437 = t222 + t435;
+    const double t438 = t221 - t434;
+    const double t439 = t222 - t435;
+    const double t440 = 0.19509032201612828 * t394 - 0.98078528040323043 * t395;
+    const double t441 = 0.98078528040323043 * t394 + 0.19509032201612828 * t395;
+    const double t442 = t227 + t440;
+    const double t443 = t228 + t441;
+    const double t444 = t227 - t440;
+    const double t445 = t228 - t441;
+    const double t446 = -t352;
+    const double t447 = t184 + t446;
+    const double t448 = t185 + t351;
+    const double t449 = t184 - t446;
+    const double t450 = t185 - t351;
+    const double t451 = -0.19509032201612828 * t357 - 0.98078528040323043 * t358;
+    const double t452 = 0.98078528040323043 * t357 + -0.19509032201612828 * t358;
+    const double t453 = t190 + t451;
+    const double t454 = t191 + t452;
+    const double t455 = t190 - t451;
+    const double t456 = t191 - t452;
+    const double t457 = -0.38268343236508978 * t365 - 0.92387953251128674 * t366;
+    const double t458 = 0.92387953251128674 * t365 + -0.38268343236508978 * t366;
+    const double t459 = t198 + t457;
+    const double t460 = t199 + t458;
+    const double t461 = t198 - t457;
+    const double t462 = t199 - t458;
+    const double t463 = -0.55557023301960218 * t371 - 0.83146961230254524 * t372;
+    const double t464 = 0.83146961230254524 * t371 + -0.55557023301960218 * t372;
+    const double t465 = t204 + t463;
+    const double t466 = t205 + t464;
+    const double t467 = t204 - t463;
+    const double t468 = t205 - t464;
+    const double t469 = t376 + t377;
+    const double t470 = t377 - t376;
+    const double t471 = -0.70710678118654757 * t469;
+    const double t472 = -0.70710678118654757 * t470;
+    const double t473 = t209 + t471;
+    const double t474 = t210 + t472;
+    const double t475 = t209 - t471;
+    const double t476 = t210 - t472;
+    const double t477 = -0.83146961230254524 * t382 - 0.55557023301960218 * t383;
+    const double t478 = 0.55557023301960218 * t382 + -0.83146961230254524 * t383;
+    const double t479 = t215 + t477;
+    const double t480 = t216 + t478;
+    const double t481 = t215 - t477;
+    const double t482 = t216 - t478;
+    const double t483 = -0.92387953251128674 * t390 - 0.38268343236508978 * t391;
+    const double t484 = 0.38268343236508978 * t390 + -0.92387953251128674 * t391;
+    const double t485 = t223 + t483;
+    const double t486 = t224 + t484;
+    const double t487 = t223 - t483;
+    const double t488 = t224 - t484;
+    const double t489 = -0.98078528040323043 * t396 - 0.19509032201612828 * t397;
+    const double t490 = 0.19509032201612828 * t396 + -0.98078528040323043 * t397;
+    const double t491 = t229 + t489;
+    const double t492 = t230 + t490;
+    const double t493 = t229 - t489;
+    const double t494 = t230 - t490;
+    out[0 * os] = CMPLX(t398, t399);
+    out[1 * os] = CMPLX(t404, t405);
+    out[2 * os] = CMPLX(t410, t411);
+    out[3 * os] = CMPLX(t416, t417);
+    out[4 * os] = CMPLX(t424, t425);
+    out[5 * os] = CMPLX(t430, t431);
+    out[6 * os] = CMPLX(t436, t437);
+    out[7 * os] = CMPLX(t442, t443);
+    out[8 * os] = CMPLX(t447, t448);
+    out[9 * os] = CMPLX(t453, t454);
+    out[10 * os] = CMPLX(t459, t460);
+    out[11 * os] = CMPLX(t465, t466);
+    out[12 * os] = CMPLX(t473, t474);
+    out[13 * os] = CMPLX(t479, t480);
+    out[14 * os] = CMPLX(t485, t486);
+    out[15 * os] = CMPLX(t491, t492);
+    out[16 * os] = CMPLX(t400, t401);
+    out[17 * os] = CMPLX(t406, t407);
+    out[18 * os] = CMPLX(t412, t413);
+    out[19 * os] = CMPLX(t418, t419);
+    out[20 * os] = CMPLX(t426, t427);
+    out[21 * os] = CMPLX(t432, t433);
+    out[22 * os] = CMPLX(t438, t439);
+    out[23 * os] = CMPLX(t444, t445);
+    out[24 * os] = CMPLX(t449, t450);
+    out[25 * os] = CMPLX(t455, t456);
+    out[26 * os] = CMPLX(t461, t462);
+    out[27 * os] = CMPLX(t467, t468);
+    out[28 * os] = CMPLX(t475, t476);
+    out[29 * os] = CMPLX(t481, t482);
+    out[30 * os] = CMPLX(t487, t488);
+    out[31 * os] = CMPLX(t493, t494);
+}
+
+void
+dft_64(const double complex *in, size_t is, double complex *out, size_t os)
+{
+    const double t0 = creal(in[0 * is]);
+    const double t1 = cimag(in[0 * is]);
+    const double t2 = creal(in[1 * is]);
+    const double t3 = cimag(in[1 * is]);
+    const double t4 = creal(in[2 * is]);
+    const double t5 = cimag(in[2 * is]);
+    const double t6 = creal(in[3 * is]);
+    const double t7 = cimag(in[3 * is]);
+    const double t8 = creal(in[4 * is]);
+    const double t9 = cimag(in[4 * is]);
+    const double t10 = creal(in[5 * is]);
+    const double t11 = cimag(in[5 * is]);
+    const double t12 = creal(in[6 * is]);
+    const double t13 = cimag(in[6 * is]);
+    const double t14 = creal(in[7 * is]);
+    const double t15 = cimag(in[7 * is]);
+    const double t16 = creal(in[8 * is]);
+    const double t17 = cimag(in[8 * is]);
+    const double t18 = creal(in[9 * is]);
+    const double t19 = cimag(in[9 * is]);
+    const double t20 = creal(in[10 * is]);
+    const double t21 = cimag(in[10 * is]);
+    const double t22 = creal(in[11 * is]);
+    const double t23 = cimag(in[11 * is]);
+    const double t24 = creal(in[12 * is]);
+    const double t25 = cimag(in[12 * is]);
+    const double t26 = creal(in[13 * is]);
+    const double t27 = cimag(in[13 * is]);
+    const double t28 = creal(in[14 * is]);
+    const double t29 = cimag(in[14 * is]);
+    const double t30 = creal(in[15 * is]);
+    const double t31 = cimag(in[15 * is]);
+    const double t32 = creal(in[16 * is]);
+    const double t33 = cimag(in[16 * is]);
+    const double t34 = creal(in[17 * is]);
+    const double t35 = cimag(in[17 * is]);
+    const double t36 = creal(in[18 * is]);
+    const double t37 = cimag(in[18 * is]);
+    const double t38 = creal(in[19 * is]);
+    const double t39 = cimag(in[19 * is]);
+    const double t40 = creal(in[20 * is]);
+    const double t41 = cimag(in[20 * is]);
+    const double t42 = creal(in[21 * is]);
+    const double t43 = cimag(in[21 * is]);
+    const double t44 = creal(in[22 * is]);
+    const double t45 = cimag(in[22 * is]);
+    const double t46 = creal(in[23 * is]);
+    const double t47 = cimag(in[23 * is]);
+    const double t48 = creal(in[24 * is]);
+    const double t49 = cimag(in[24 * is]);
+    const double t50 = creal(in[25 * is]);
+    const double t51 = cimag(in[25 * is]);
+    const double t52 = creal(in[26 * is]);
+    const double t53 = cimag(in[26 * is]);
+    const double t54 = creal(in[27 * is]);
+    const double t55 = cimag(in[27 * is]);
+    const double t56 = creal(in[28 * is]);
+    const double t57 = cimag(in[28 * is]);
+    const double t58 = creal(in[29 * is]);
+    const double t59 = cimag(in[29 * is]);
+    const double t60 = creal(in[30 * is]);
+    const double t61 = cimag(in[30 * is]);
+    const double t62 = creal(in[31 * is]);
+    const double t63 = cimag(in[31 * is]);
+    const double t64 = creal(in[32 * is]);
+    const double t65 = cimag(in[32 * is]);
+    const double t66 = creal(in[33 * is]);
+    const double t67 = cimag(in[33 * is]);
+    const double t68 = creal(in[34 * is]);
+    const double t69 = cimag(in[34 * is]);
+    const double t70 = creal(in[35 * is]);
+    const double t71 = cimag(in[35 * is]);
+    const double t72 = creal(in[36 * is]);
+    const double t73 = cimag(in[36 * is]);
+    const double t74 = creal(in[37 * is]);
+    const double t75 = cimag(in[37 * is]);
+    const double t76 = creal(in[38 * is]);
+    const double t77 = cimag(in[38 * is]);
+    const double t78 = creal(in[39 * is]);
+    const double t79 = cimag(in[39 * is]);
+    const double t80 = creal(in[40 * is]);
+    const double t81 = cimag(in[40 * is]);
+    const double t82 = creal(in[41 * is]);
+    const double t83 = cimag(in[41 * is]);
+    const double t84 = creal(in[42 * is]);
+    const double t85 = cimag(in[42 * is]);
+    const double t86 = creal(in[43 * is]);
+    const double t87 = cimag(in[43 * is]);
+    const double t88 = creal(in[44 * is]);
+    const double t89 = cimag(in[44 * is]);
+    const double t90 = creal(in[45 * is]);
+    const double t91 = cimag(in[45 * is]);
+    const double t92 = creal(in[46 * is]);
+    const double t93 = cimag(in[46 * is]);
+    const double t94 = creal(in[47 * is]);
+    const double t95 = cimag(in[47 * is]);
+    const double t96 = creal(in[48 * is]);
+    const double t97 = cimag(in[48 * is]);
+    const double t98 = creal(in[49 * is]);
+    const double t99 = cimag(in[49 * is]);
+    const double t100 = creal(in[50 * is]);
+    const double t101 = cimag(in[50 * is]);
+    const double t102 = creal(in[51 * is]);
+    const double t103 = cimag(in[51 * is]);
+    const double t104 = creal(in[52 * is]);
+    const double t105 = cimag(in[52 * is]);
+    const double t106 = creal(in[53 * is]);
+    const double t107 = cimag(in[53 * is]);
+    const double t108 = creal(in[54 * is]);
+    const double t109 = cimag(in[54 * is]);
+    const double t110 = creal(in[55 * is]);
+    const double t111 = cimag(in[55 * is]);
+    const double t112 = creal(in[56 * is]);
+    const double t113 = cimag(in[56 * is]);
+    const double t114 = creal(in[57 * is]);
+    const double t115 = cimag(in[57 * is]);
+    const double t116 = creal(in[58 * is]);
+    const double t117 = cimag(in[58 * is]);
+    const double t118 = creal(in[59 * is]);
+    const double t119 = cimag(in[59 * is]);
+    const double t120 = creal(in[60 * is]);
+    const double t121 = cimag(in[60 * is]);
+    const double t122 = creal(in[61 * is]);
+    const double t123 = cimag(in[61 * is]);
+    const double t124 = creal(in[62 * is]);
+    const double t125 = cimag(in[62 * is]);
+    const double t126 = creal(in[63 * is]);
+    const double t127 = cimag(in[63 * is]);
+    const double t128 = t0 + t64;
+    const double t129 = t1 + t65;
+    const double t130 = t0 - t64;
+    const double t131 = t1 - t65;
+    const double t132 = t32 + t96;
+    const double t133 = t33 + t97;
+    const double t134 = t32 - t96;
+    const double t135 = t33 - t97;
+    const double t136 = t128 + t132;
+    const double t137 = t129 + t133;
+    const double t138 = t128 - t132;
+    const double t139 = t129 - t133;
+    const double t140 = -t135;
+    const double t141 = t130 + t140;
+    const double t142 = t131 + t134;
+    const double t143 = t130 - t140;
+    const double t144 = t131 - t134;
+    const double t145 = t16 + t80;
+    const double t146 = t17 + t81;
+    const double t147 = t16 - t80;
+    const double t148 = t17 - t81;
+    const double t149 = t48 + t112;
+    const double t150 = t49 + t113;
+    const double t151 = t48 - t112;
+    const double t152 = t49 - t113;
+    const double t153 = t145 + t149;
+    const double t154 = t146 + t150;
+    const double t155 = t145 - t149;
+    const double t156 = t146 - t150;
+    const double t157 = -t152;
+    const double t158 = t147 + t157;
+    const double t159 = t148 + t151;
+    const double t160 = t147 - t157;
+    const double t161 = t148 - t151;
+    const double t162 = t136 + t153;
+    const double t163 = t137 + t154;
+    const double t164 = t136 - t153;
+    const double t165 = t137 - t154;
+    const double t166 = t158 - t159;
+    const double t167 = t158 + t159;
+    const double t168 = 0.70710678118654757 * t166;
+    const double t169 = 0.70710678118654757 * t167;
+    const double t170 = t141 + t168;
+    const double t171 = t142 + t169;
+    const double t172 = t141 - t168;
+    const double t173 = t142 - t169;
+    const double t174 = -t156;
+    const double t175 = t138 + t174;
+    const double t176 = t139 + t155;
+    const double t177 = t138 - t174;
+    const double t178 = t139 - t155;
+    const double t179 = t160 + t161;
+    const double t180 = t161 - t160;
+    const double t181 = -0.70710678118654757 * t179;
+    const double t182 = -0.70710678118654757 * t180;
+    const double t183 = t143 + t181;
+    const double t184 = t144 + t182;
+    const double t185 = t143 - t181;
+    const double t186 = t144 - t182;
+    const double t187 = t8 + t72;
+    const double t188 = t9 + t73;
+    const double t189 = t8 - t72;
+    const double t190 = t9 - t73;
+    const double t191 = t40 + t104;
+    const double t192 = t41 + t105;
+    const double t193 = t40 - t104;
+    const double t194 = t41 - t105;
+    const double t195 = t187 + t191;
+    const double t196 = t188 + t192;
+    const double t197 = t187 - t191;
+    const double t198 = t188 - t192;
+    const double t199 = -t194;
+    const double t200 = t189 + t199;
+    const double t201 = t190 + t193;
+    const double t202 = t189 - t199;
+    const double t203 = t190 - t193;
+    const double t204 = t24 + t88;
+    const double t205 = t25 + t89;
+    const double t206 = t24 - t88;
+    const double t207 = t25 - t89;
+    const double t208 = t56 + t120;
+    const double t209 = t57 + t121;
+    const double t210 = t56 - t120;
+    const double t211 = t57 - t121;
+    const double t212 = t204 + t208;
+    const double t213 = t205 + t209;
+    const double t214 = t204 - t208;
+    const double t215 = t205 - t209;
+    const double t216 = -t211;
+    const double t217 = t206 + t216;
+    const double t218 = t207 + t210;
+    const double t219 = t206 - t216;
+    const double t220 = t207 - t210;
+    const double t221 = t195 + t212;
+    const double t222 = t196 + t213;
+    const double t223 = t195 - t212;
+    const double t224 = t196 - t213;
+    const double t225 = t217 - t218;
+    const double t226 = t217 + t218;
+    const double t227 = 0.70710678118654757 * t225;
+    const double t228 = 0.70710678118654757 * t226;
+    const double t229 = t200 + t227;
+    const double t230 = t201 + t228;
+    const double t231 = t200 - t227;
+    const double t232 = t201 - t228;
+    const double t233 = -t215;
+    const double t234 = t197 + t233;
+    const double t235 = t198 + t214;
+    const double t236 = t197 - t233;
+    const double t237 = t198 - t214;
+    const double t238 = t219 + t220;
+    const double t239 = t220 - t219;
+    const double t240 = -0.70710678118654757 * t238;
+    const double t241 = -0.70710678118654757 * t239;
+    const double t242 = t202 + t240;
+    const double t243 = t203 + t241;
+    const double t244 = t202 - t240;
+    const double t245 = t203 - t241;
+    const double t246 = t162 + t221;
+    const double t247 = t163 + t222;
+    const double t248 = t162 - t221;
+    const double t249 = t163 - t222;
+    const double t250 = 0.92387953251128674 * t229 - 0.38268343236508978 * t230;
+    const double t251 = 0.38268343236508978 * t229 + 0.92387953251128674 * t230;
+    const double t252 = t170 + t250;
+    const double t253 = t171 + t251;
+    const double t254 = t170 - t250;
+    const double t255 = t171 - t251;
+    const double t256 = t234 - t235;
+    const double t257 = t234 + t235;
+    const double t258 = 0.70710678118654757 * t256;
+    const double t259 = 0.70710678118654757 * t257;
+    const double t260 = t175 + t258;
+    const double t261 = t176 + t259;
+    const double t262 = t175 - t258;
+    const double t263 = t176 - t259;
+    const double t264 = 0.38268343236508978 * t242 - 0.92387953251128674 * t243;
+    const double t265 = 0.92387953251128674 * t242 + 0.38268343236508978 * t243;
+    const double t266 = t183 + t264;
+    const double t267 = t184 + t265;
+    const double t268 = t183 - t264;
+    const double t269 = t184 - t265;
+    const double t270 = -t224;
+    const double t271 = t164 + t270;
+    const double t272 = t165 + t223;
+    const double t273 = t164 - t270;
+    const double t274 = t165 - t223;
+    const double t275 = -0.38268343236508978 * t231 - 0.92387953251128674 * t232;
+    const double t276 = 0.92387953251128674 * t231 + -0.38268343236508978 * t232;
+    const double t277 = t172 + t275;
+    const double t278 = t173 + t276;
+    const double t279 = t172 - t275;
+    const double t280 = t173 - t276;
+    const double t281 = t236 + t237;
+    const double t282 = t237 - t236;
+    const double t283 = -0.70710678118654757 * t281;
+    const double t284 = -0.70710678118654757 * t282;
+    const double t285 = t177 + t283;
+    const double t286 = t178 + t284;
+    const double t287 = t177 - t283;
+    const double t288 = t178 - t284;
+    const double t289 = -0.92387953251128674 * t244 - 0.38268343236508978 * t245;
+    const double t290 = 0.38268343236508978 * t244 + -0.92387953251128674 * t245;
+    const double t291 = t185 + t289;
+    const double t292 = t186 + t290;
+    const double t293 = t185 - t289;
+    const double t294 = t186 - t290;
+    const double t295 = t4 + t68;
+    const double t296 = t5 + t69;
+    const double t297 = t4 - t68;
+    const double t298 = t5 - t69;
+    const double t299 = t36 + t100;
+    const double t300 = t37 + t101;
+    const double t301 = t36 - t100;
+    const double t302 = t37 - t101;
+    const double t303 = t295 + t299;
+    const double t304 = t296 + t300;
+    const double t305 = t295 - t299;
+    const double t306 = t296 - t300;
+    const double t307 = -t302;
+    const double t308 = t297 + t307;
+    const double t309 = t298 + t301;
+    const double t310 = t297 - t307;
+    const double t311 = t298 - t301;
+    const double t312 = t20 + t84;
+    const double t313 = t21 + t85;
+    const double t314 = t20 - t84;
+    const double t315 = t21 - t85;
+    const double t316 = t52 + t116;
+    const double t317 = t53 + t117;
+    const double t318 = t52 - t116;
+    const double t319 = t53 - t117;
+    const double t320 = t312 + t316;
+    const double t321 = t313 + t317;
+    const double t322 = t312 - t316;
+    const double t323 = t313 - t317;
+    const double t324 = -t319;
+    const double t325 = t314 + t324;
+    const double t326 = t315 + t318;
+    const double t327 = t314 - t324;
+    const double t328 = t315 - t318;
+    const double t329 = t303 + t320;
+    const double t330 = t304 + t321;
+    const double t331 = t303 - t320;
+    const double t332 = t304 - t321;
+    const double t333 = t325 - t326;
+    const double t334 = t325 + t326;
+    const double t335 = 0.70710678118654757 * t333;
+    const double t336 = 0.70710678118654757 * t334;
+    const double t337 = t308 + t335;
+    const double t338 = t309 + t336;
+    const double t339 = t308 - t335;
+    const double t340 = t309 - t336;
+    const double t341 = -t323;
+    const double t342 = t305 + t341;
+    const double t343 = t306 + t322;
+    const double t344 = t305 - t341;
+    const double t345 = t306 - t322;
+    const double t346 = t327 + t328;
+    const double t347 = t328 - t327;
+    const double t348 = -0.70710678118654757 * t346;
+    const double t349 = -0.70710678118654757 * t347;
+    const double t350 = t310 + t348;
+    const double t351 = t311 + t349;
+    const double t352 = t310 - t348;
+    const double t353 = t311 - t349;
+    const double t354 = t12 + t76;
+    const double t355 = t13 + t77;
+    const double t356 = t12 - t76;
+    const double t357 = t13 - t77;
+    const double t358 = t44 + t108;
+    const double t359 = t45 + t109;
+    const double t360 = t44 - t108;
+    const double t361 = t45 - t109;
+    const double t362 = t354 + t358;
+    const double t363 = t355 + t359;
+    const double t364 = t354 - t358;
+    const double t365 = t355 - t359;
+    const double t366 = -t361;
+    const double t367 = t356 + t366;
+    const double t368 = t357 + t360;
+    const double t369 = t356 - t366;
+    const double t370 = t357 - t360;
+    const double t371 = t28 + t92;
+    const double t372 = t29 + t93;
+    const double t373 = t28 - t92;
+    const double t374 = t29 - t93;
+    const double t375 = t60 + t124;
+    const double t376 = t61 + t125;
+    const double t377 = t60 - t124;
+    const double t378 = t61 - t125;
+    const double t379 = t371 + t375;
+    const double t380 = t372 + t376;
+    const double t381 = t371 - t375;
+    const double t382 = t372 - t376;
+    const double t383 = -t378;
+    const double t384 = t373 + t383;
+    const double t385 = t374 + t377;
+    const double t386 = t373 - t383;
+    const double t387 = t374 - t377;
+    const double t388 = t362 + t379;
+    const double t389 = t363 + t380;
+    const double t390 = t362 - t379;
+    const double t391 = t363 - t380;
+    const double t392 = t384 - t385;
+    const double t393 = t384 + t385;
+    const double t394 = 0.70710678118654757 * t392;
+    const double t395 = 0.70710678118654757 * t393;
+    const double t396 = t367 + t394;
+    const double t397 = t368 + t395;
+    const double t398 = t367 - t394;
+    const double t399 = t368 - t395;
+    const double t400 = -t382;
+    const double t401 = t364 + t400;
+    const double t402 = t365 + t381;
+    const double t403 = t364 - t400;
+    const double t404 = t365 - t381;
+    const double t405 = t386 + t387;
+    const double t406 = t387 - t386;
+    const double t407 = -0.70710678118654757 * t405;
+    const double t408 = -0.70710678118654757 * t406;
+    const double t409 = t369 + t407;
+    const double t410 = t370 + t408;
+    const double t411 = t369 - t407;
+    const double t412 = t370 - t408;
+    const double t413 = t329 + t388;
+    const double t414 = t330 + t389;
+    const double t415 = t329 - t388;
+    const double t416 = t330 - t389;
+    const double t417 = 0.92387953251128674 * t396 - 0.38268343236508978 * t397;
+    const double t418 = 0.38268343236508978 * t396 + 0.92387953251128674 * t397;
+    const double t419 = t337 + t417;
+    const double t420 = t338 + t418;
+    const double t421 = t337 - t417;
+    const double t422 = t338 - t418;
+    const double t423 = t401 - t402;
+    const double t424 = t401 + t402;
+    const double t425 = 0.70710678118654757 * t423;
+    const double t426 = 0.70710678118654757 * t424;
+    const double t427 = t342 + t425;
+    const double t428 = t343 + t426;
+    const double t429 = t342 - t425;
+    const double t430 = t343 - t426;
+    const double t431 = 0.38268343236508978 * t409 - 0.92387953251128674 * t410;
+    const double t432 = 0.92387953251128674 * t409 + 0.38268343236508978 * t410;
+    const double t433 = t350 + t431;
+    const double t434 = t351 + t432;
+    const double t435 = t350 - t431;
+    const double t436 = t351 - t432;
+    const double t437 = -t391;
+    const double t438 = t331 + t437;
+    const double t439 = t332 + t390;
+    const double t440 = t331 - t437;
+    const double t441 = t332 - t390;
+    const double t442 = -0.38268343236508978 * t398 - 0.92387953251128674 * t399;
+    const double t443 = 0.92387953251128674 * t398 + -0.38268343236508978 * t399;
+    const double t444 = t339 + t442;
+    const double t445 = t340 + t443;
+    const double t446 = t339 - t442;
+    const double t447 = t340 - t443;
+    const double t448 = t403 + t404;
+    const double t449 = t404 - t403;
+    const double t450 = -0.70710678118654757 * t448;
+    const double t451 = -0.70710678118654757 * t449;
+    const double t452 = t344 + t450;
+    const double t453 = t345 + t451;
+    const double t454 = t344 - t450;
+    const double t455 = t345 - t451;
+    const double t456 = -0.92387953251128674 * t411 - 0.38268343236508978 * t412;
+    const double t457 = 0.38268343236508978 * t411 + -0.92387953251128674 * t412;
+    const double t458 = t352 + t456;
+    const double t459 = t353 + t457;
+    const double t460 = t352 - t456;
+    const double t461 = t353 - t457;
+    const double t462 = t246 + t413;
+    const double t463 = t247 + t414;
+    const double t464 = t246 - t413;
+    const double t465 = t247 - t414;
+    const double t466 = 0.98078528040323043 * t419 - 0.19509032201612828 * t420;
+    const double t467 = 0.19509032201612828 * t419 + 0.98078528040323043 * t420;
+    const double t468 = t252 + t466;
+    const double t469 = t253 + t467;
+    const double t470 = t252 - t466;
+    const double t471 = t253 - t467;
+    const double t472 = 0.92387953251128674 * t427 - 0.38268343236508978 * t428;
+    const double t473 = 0.38268343236508978 * t427 + 0.92387953251128674 * t428;
+    const double t474 = t260 + t472;
+    const double t475 = t261 + t473;
+    const double t476 = t260 - t472;
+    const double t477 = t261 - t473;
+    const double t478 = 0.83146961230254524 * t433 - 0.55557023301960218 * t434;
+    const double t479 = 0.55557023301960218 * t433 + 0.83146961230254524 * t434;
+    const double t480 = t266 + t478;
+    const double t481 = t267 + t479;
+    const double t482 = t266 - t478;
+    const double t483 = t267 - t479;
+    const double t484 = t438 - t439;
+    const double t485 = t438 + t439;
+    const double t486 = 0.70710678118654757 * t484;
+    const double t487 = 0.70710678118654757 * t485;
+    const double t488 = t271 + t486;
+    const double t489 = t272 + t487;
+    const double t490 = t271 - t486;
+    const double t491 = t272 - t487;
+    const double t492 = 0.55557023301960218 * t444 - 0.83146961230254524 * t445;
+    const double t493 = 0.83146961230254524 * t444 + 0.55557023301960218 * t445;
+    const double t494 = t277 + t492;
+    const double t495 = t278 + t493;
+    const double t496 = t277 - t492;
+    const double t497 = t278 - t493;
+    const double t498 = 0.38268343236508978 * t452 - 0.92387953251128674 * t453;
+    const double t499 = 0.92387953251128674 * t452 + 0.38268343236508978 * t453;
+    const double t500 = t285 + t498;
+    const double t501 = t286 + t499;
+    const double t502 = t285 - t498;
+    const double t503 = t286 - t499;
+    const double t504 = 0.19509032201612828 * t458 - 0.98078528040323043 * t459;
+    const double t505 = 0.98078528040323043 * t458 + 0.19509032201612828 * t459;
+    const double t506 = t291 + t504;
+    const double t507 = t292 + t505;
+    const double t508 = t291 - t504;
+    const double t509 = t292 - t505;
+    const double t510 = -t416;
+    const double t511 = t248 + t510;
+    const double t512 = t249 + t415;
+    const double t513 = t248 - t510;
+    const double t514 = t249 - t415;
+    const double t515 = -0.19509032201612828 * t421 - 0.98078528040323043 * t422;
+    const double t516 = 0.98078528040323043 * t421 + -0.19509032201612828 * t422;
+    const double t517 = t254 + t515;
+    const double t518 = t255 + t516;
+    const double t519 = t254 - t515;
+    const double t520 = t255 - t516;
+    const double t521 = -0.38268343236508978 * t429 - 0.92387953251128674 * t430;
+    const double t522 = 0.92387953251128674 * t429 + -0.38268343236508978 * t430;
+    const double t523 = t262 + t521;
+    const double t524 = t263 + t522;
+    const double t525 = t262 - t521;
+    const double t526 = t263 - t522;
+    const double t527 = -0.55557023301960218 * t435 - 0.83146961230254524 * t436;
+    const double t528 = 0.83146961230254524 * t435 + -0.55557023301960218 * t436;
+    const double t529 = t268 + t527;
+    const double t530 = t269 + t528;
+    const double t531 = t268 - t527;
+    const double t532 = t269 - t528;
+    const double t533 = t440 + t441;
+    const double t534 = t441 - t440;
+    const double t535 = -0.70710678118654757 * t533;
+    const double t536 = -0.70710678118654757 * t534;
+    const double t537 = t273 + t535;
+    const double t538 = t274 + t536;
+    const double t539 = t273 - t535;
+    const double t540 = t274 - t536;
+    const double t541 = -0.83146961230254524 * t446 - 0.55557023301960218 * t447;
+    const double t542 = 0.55557023301960218 * t446 + -0.83146961230254524 * t447;
+    const double t543 = t279 + t541;
+    const double t544 = t280 + t542;
+    const double t545 = t279 - t541;
+    const double t546 = t280 - t542;
+    const double t547 = -0.92387953251128674 * t454 - 0.38268343236508978 * t455;
+    const double t548 = 0.38268343236508978 * t454 + -0.92387953251128674 * t455;
+    const double t549 = t287 + t547;
+    const double t550 = t288 + t548;
+    const double t551 = t287 - t547;
+    const double t552 = t288 - t548;
+    const double t553 = -0.98078528040323043 * t460 - 0.19509032201612828 * t461;
+    const double t554 = 0.19509032201612828 * t460 + -0.98078528040323043 * t461;
+    const double t555 = t293 + t553;
+    const double t556 = t294 + t554;
+    const double t557 = t293 - t553;
+    const double t558 = t294 - t554;
+    const double t559 = t2 + t66;
+    const double t560 = t3 + t67;
+    const double t561 = t2 - t66;
+    const double t562 = t3 - t67;
+    const double t563 = t34 + t98;
+    const double t564 = t35 + t99;
+    const double t565 = t34 - t98;
+    const double t566 = t35 - t99;
+    const double t567 = t559 + t563;
+    const double t568 = t560 + t564;
+    const double t569 = t559 - t563;
+    const double t570 = t560 - t564;
+    const double t571 = -t566;
+    const double t572 = t561 + t571;
+    const double t573 = t562 + t565;
+    const double t574 = t561 - t571;
+    const double t575 = t562 - t565;
+    const double t576 = t18 + t82;
+    const double t577 = t19 + t83;
+    const double t578 = t18 - t82;
+    const double t579 = t19 - t83;
+    const double t580 = t50 + t114;
+    const double t581 = t51 + t115;
+    const double t582 = t50 - t114;
+    const double t583 = t51 - t115;
+    const double t584 = t576 + t580;
+    const double t585 = t577 + t581;
+    const double t586 = t576 - t580;
+    const double t587 = t577 - t581;
+    const double t588 = -t583;
+    const double t589 = t578 + t588;
+    const double t590 = t579 + t582;
+    const double t591 = t578 - t588;
+    const double t592 = t579 - t582;
+    const double t593 = t567 + t584;
+    const double t594 = t568 + t585;
+    const double t595 = t567 - t584;
+    const double t596 = t568 - t585;
+    const double t597 = t589 - t590;
+    const double t598 = t589 + t590;
+    const double t599 = 0.70710678118654757 * t597;
+    const double t600 = 0.70710678118654757 * t598;
+    const double t601 = t572 + t599;
+    const double t602 = t573 + t600;
+    const double t603 = t572 - t599;
+    const double t604 = t573 - t600;
+    const double t605 = -t587;
+    const double t606 = t569 + t605;
+    const double t607 = t570 + t586;
+    const double t608 = t569 - t605;
+    const double t609 = t570 - t586;
+    const double t610 = t591 + t592;
+    const double t611 = t592 - t591;
+    const double t612 = -0.70710678118654757 * t610;
+    const double t613 = -0.70710678118654757 * t611;
+    const double t614 = t574 + t612;
+    const double t615 = t575 + t613;
+    const double t616 = t574 - t612;
+    const double t617 = t575 - t613;
+    const double t618 = t10 + t74;
+    const double t619 = t11 + t75;
+    const double t620 = t10 - t74;
+    const double t621 = t11 - t75;
+    const double t622 = t42 + t106;
+    const double t623 = t43 + t107;
+    const double t624 = t42 - t106;
+    const double t625 = t43 - t107;
+    const double t626 = t618 + t622;
+    const double t627 = t619 + t623;
+    const double t628 = t618 - t622;
+    const double t629 = t619 - t623;
+    const double t630 = -t625;
+    const double t631 = t620 + t630;
+    const double t632 = t621 + t624;
+    const double t633 = t620 - t630;
+    const double t634 = t621 - t624;
+    const double t635 = t26 + t90;
+    const double t636 = t27 + t91;
+    const double t637 = t26 - t90;
+    const double t638 = t27 - t91;
+    const double t639 = t58 + t122;
+    const double t640 = t59 + t123;
+    const double t641 = t58 - t122;
+    const double t642 = t59 - t123;
+    const double t643 = t635 + t639;
+    const double t644 = t636 + t640;
+    const double t645 = t635 - t639;
+    const double t646 = t636 - t640;
+    const double t647 = -t642;
+    const double t648 = t637 + t647;
+    const double t649 = t638 + t641;
+    const double t650 = t637 - t647;
+    const double t651 = t638 - t641;
+    const double t652 = t626 + t643;
+    const double t653 = t627 + t644;
+    const double t654 = t626 - t643;
+    const double t655 = t627 - t644;
+    const double t656 = t648 - t649;
+    const double t657 = t648 + t649;
+    const double t658 = 0.70710678118654757 * t656;
+    const double t659 = 0.70710678118654757 * t657;
+    const double t660 = t631 + t658;
+    const double t661 = t632 + t659;
+    const double t662 = t631 - t658;
+    const double t663 = t632 - t659;
+    const double t664 = -t646;
+    const double t665 = t628 + t664;
+    const double t666 = t629 + t645;
+    const double t667 = t628 - t664;
+    const double t668 = t629 - t645;
+    const double t669 = t650 + t651;
+    const double t670 = t651 - t650;
+    const double t671 = -0.70710678118654757 * t669;
+    const double t672 = -0.70710678118654757 * t670;
+    const double t673 = t633 + t671;
+    const double t674 = t634 + t672;
+    const double t675 = t633 - t671;
+    const double t676 = t634 - t672;
+    const double t677 = t593 + t652;
+    const double t678 = t594 + t653;
+    const double t679 = t593 - t652;
+    const double t680 = t594 - t653;
+    const double t681 = 0.92387953251128674 * t660 - 0.38268343236508978 * t661;
+    const double t682 = 0.38268343236508978 * t660 + 0.92387953251128674 * t661;
+    const double t683 = t601 + t681;
+    const double t684 = t602 + t682;
+    const double t685 = t601 - t681;
+    const double t686 = t602 - t682;
+    const double t687 = t665 - t666;
+    const double t688 = t665 + t666;
+    const double t689 = 0.70710678118654757 * t687;
+    const double t690 = 0.70710678118654757 * t688;
+    const double t691 = t606 + t689;
+    const double t692 = t607 + t690;
+    const double t693 = t606 - t689;
+    const double t694 = t607 - t690;
+    const double t695 = 0.38268343236508978 * t673 - 0.92387953251128674 * t674;
+    const double t696 = 0.92387953251128674 * t673 + 0.38268343236508978 * t674;
+    const double t697 = t614 + t695;
+    const double t698 = t615 + t696;
+    const double t699 = t614 - t695;
+    const double t700 = t615 - t696;
+    const double t701 = -t655;
+    const double t702 = t595 + t701;
+    const double t703 = t596 + t654;
+    const double t704 = t595 - t701;
+    const double t705 = t596 - t654;
+    const double t706 = -0.38268343236508978 * t662 - 0.92387953251128674 * t663;
+    const double t707 = 0.92387953251128674 * t662 + -0.38268343236508978 * t663;
+    const double t708 = t603 + t706;
+    const double t709 = t604 + t707;
+    const double t710 = t603 - t706;
+    const double t711 = t604 - t707;
+    const double t712 = t667 + t668;
+    const double t713 = t668 - t667;
+    const double t714 = -0.70710678118654757 * t712;
+    const double t715 = -0.70710678118654757 * t713;
+    const double t716 = t608 + t714;
+    const double t717 = t609 + t715;
+    const double t718 = t608 - t714;
+    const double t719 = t609 - t715;
+    const double t720 = -0.92387953251128674 * t675 - 0.38268343236508978 * t676;
+    const double t721 = 0.38268343236508978 * t675 + -0.92387953251128674 * t676;
+    const double t722 = t616 + t720;
+    const double t723 = t617 + t721;
+    const double t724 = t616 - t720;
+    const double t725 = t617 - t721;
+    const double t726 = t6 + t70;
+    const double t727 = t7 + t71;
+    const double t728 = t6 - t70;
+    const double t729 = t7 - t71;
+    const double t730 = t38 + t102;
+    const double t731 = t39 + t103;
+    const double t732 = t38 - t102;
+    const double t733 = t39 - t103;
+    const double t734 = t726 + t730;
+    const double t735 = t727 + t731;
+    const double t736 = t726 - t730;
+    const double t737 = t727 - t731;
+    const double t738 = -t733;
+    const double t739 = t728 + t738;
+    const double t740 = t729 + t732;
+    const double t741 = t728 - t738;
+    const double t742 = t729 - t732;
+    const double t743 = t22 + t86;
+    const double t744 = t23 + t87;
+    const double t745 = t22 - t86;
+    const double t746 = t23 - t87;
+    const double t747 = t54 + t118;
+    const double t748 = t55 + t119;
+    const double t749 = t54 - t118;
+    const double t750 = t55 - t119;
+    const double t751 = t743 + t747;
+    const double t752 = t744 + t748;
+    const double t753 = t743 - t747;
+    const double t754 = t744 - t748;
+    const double t755 = -t750;
+    const double t756 = t745 + t755;
+    const double t757 = t746 + t749;
+    const double t758 = t745 - t755;
+    const double t759 = t746 - t749;
+    const double t760 = t734 + t751;
+    const double t761 = t735 + t752;
+    const double t762 = t734 - t751;
+    const double t763 = t735 - t752;
+    const double t764 = t756 - t757;
+    const double t765 = t756 + t757;
+    const double t766 = 0.70710678118654757 * t764;
+    const double t767 = 0.70710678118654757 * t765;
+    const double t768 = t739 + t766;
+    const double t769 = t740 + t767;
+    const double t770 = t739 - t766;
+    const double t771 = t740 - t767;
+    const double t772 = -t754;
+    const double t773 = t736 + t772;
+    const double t774 = t737 + t753;
+    const double t775 = t736 - t772;
+    const double t776 = t737 - t753;
+    const double t777 = t758 + t759;
+    const double t778 = t759 - t758;
+    const double t779 = -0.70710678118654757 * t777;
+    const double t780 = -0.70710678118654757 * t778;
+    const double t781 = t741 + t779;
+    const double t782 = t742 + t780;
+    const double t783 = t741 - t779;
+    const double t784 = t742 - t780;
+    const double t785 = t14 + t78;
+    const double t786 = t15 + t79;
+    const double t787 = t14 - t78;
+    const double t788 = t15 - t79;
+    const double t789 = t46 + t110;
+    const double t790 = t47 + t111;
+    const double t791 = t46 - t110;
+    const double t792 = t47 - t111;
+    const double t793 = t785 + t789;
+    const double t794 = t786 + t790;
+    const double t795 = t785 - t789;
+    const double t796 = t786 - t790;
+    const double t797 = -t792;
+    const double t798 = t787 + t797;
+    const double t799 = t788 + t791;
+    const double t800 = t787 - t797;
+    const double t801 = t788 - t791;
+    const double t802 = t30 + t94;
+    const double t803 = t31 + t95;
+    const double t804 = t30 - t94;
+    const double t805 = t31 - t95;
+    const double t806 = t62 + t126;
+    const double t807 = t63 + t127;
+    const double t808 = t62 - t126;
+    const double t809 = t63 - t127;
+    const double t810 = t802 + t806;
+    const double t811 = t803 + t807;
+    const double t812 = t802 - t806;
+    const double t813 = t803 - t807;
+    const double t814 = -t809;
+    const double t815 = t804 + t814;
+    const double t816 = t805 + t808;
+    const double t817 = t804 - t814;
+    const double t818 = t805 - t808;
+    const double t819 = t793 + t810;
+    const double t820 = t794 + t811;
+    const double t821 = t793 - t810;
+    const double t822 = t794 - t811;
+    const double t823 = t815 - t816;
+    const double t824 = t815 + t816;
+    const double t825 = 0.70710678118654757 * t823;
+    const double t826 = 0.70710678118654757 * t824;
+    const double t827 = t798 + t825;
+    const double t828 = t799 + t826;
+    const double t829 = t798 - t825;
+    const double t830 = t799 - t826;
+    const double t831 = -t813;
+    const double t832 = t795 + t831;
+    const double t833 = t796 + t812;
+    const double t834 = t795 - t831;
+    const double t835 = t796 - t812;
+    const double t836 = t817 + t818;
+    const double t837 = t818 - t817;
+    const double t838 = -0.70710678118654757 * t836;
+    const double t839 = -0.70710678118654757 * t837;
+    const double t840 = t800 + t838;
+    const double t841 = t801 + t839;
+    const double t842 = t800 - t838;
+    const double t843 = t801 - t839;
+    const double t844 = t760 + t819;
+    const double t845 = t761 + t820;
+    const double t846 = t760 - t819;
+    const double t847 = t761 - t820;
+    const double t848 = 0.92387953251128674 * t827 - 0.38268343236508978 * t828;
+    const double t849 = 0.38268343236508978 * t827 + 0.92387953251128674 * t828;
+    const double t850 = t768 + t848;
+    const double t851 = t769 + t849;
+    const double t852 = t768 - t848;
+    const double t853 = t769 - t849;
+    const double t854 = t832 - t833;
+    const double t855 = t832 + t833;
+    const double t856 = 0.70710678118654757 * t854;
+    const double t857 = 0.70710678118654757 * t855;
+    const double t858 = t773 + t856;
+    const double t859 = t774 + t857;
+    const double t860 = t773 - t856;
+    const double t861 = t774 - t857;
+    const double t862 = 0.38268343236508978 * t840 - 0.92387953251128674 * t841;
+    const double t863 = 0.92387953251128674 * t840 + 0.38268343236508978 * t841;
+    const double t864 = t781 + t862;
+    const double t865 = t782 + t863;
+    const double t866 = t781 - t862;
+    const double t867 = t782 - t863;
+    const double t868 = -t822;
+    const double t869 = t762 + t868;
+    const double t870 = t763 + t821;
+    const double t871 = t762 - t868;
+    const double t872 = t763 - t821;
+    const double t873 = -0.38268343236508978 * t829 - 0.92387953251128674 * t830;
+    const double t874 = 0.92387953251128674 * t829 + -0.38268343236508978 * t830;
+    const double t875 = t770 + t873;
+    const double t876 = t771 + t874;
+    const double t877 = t770 - t873;
+    const double t878 = t771 - t874;
+    const double t879 = t834 + t835;
+    const double t880 = t835 - t834;
+    const double t881 = -0.70710678118654757 * t879;
+    const double t882 = -0.70710678118654757 * t880;
+    const double t883 = t775 + t881;
+    const double t884 = t776 + t882;
+    const double t885 = t775 - t881;
+    const double t886 = t776 - t882;
+    const double t887 = -0.92387953251128674 * t842 - 0.38268343236508978 * t843;
+    const double t888 = 0.38268343236508978 * t842 + -0.92387953251128674 * t843;
+    const double t889 = t783 + t887;
+    const double t890 = t784 + t888;
+    const double t891 = t783 - t887;
+    const double t892 = t784 - t888;
+    const double t893 = t677 + t844;
+    const double t894 = t678 + t845;
+    const double t895 = t677 - t844;
+    const double t896 = t678 - t845;
+    const double t897 = 0.98078528040323043 * t850 - 0.19509032201612828 * t851;
+    const double t898 = 0.19509032201612828 * t850 + 0.98078528040323043 * t851;
+    const double t899 = t683 + t897;
+    const double t900 = t684 + t898;
+    const double t901 = t683 - t897;
+    const double t902 = t684 - t898;
+    const double t903 = 0.92387953251128674 * t858 - 0.38268343236508978 * t859;
+    const double t904 = 0.38268343236508978 * t858 + 0.92387953251128674 * t859;
+    const double t905 = t691 + t903;
+    const double t906 = t692 + t904;
+    const double t907 = t691 - t903;
+    const double t908 = t692 - t904;
+    const double t909 = 0.83146961230254524 * t864 - 0.55557023301960218 * t865;
+    const double t910 = 0.55557023301960218 * t864 + 0.83146961230254524 * t865;
+    const double t911 = t697 + t909;
+    const double t912 = t698 + t910;
+    const double t913 = t697 - t909;
+    const double t914 = t698 - t910;
+    const double t915 = t869 - t870;
+    const double t916 = t869 + t870;
+    const double t917 = 0.70710678118654757 * t915;
+    const double t918 = 0.70710678118654757 * t916;
+    const double t919 = t702 + t917;
+    const double t920 = t703 + t918;
+    const double t921 = t702 - t917;
+    const double t922 = t703 - t918;
+    const double t923 = 0.55557023301960218 * t875 - 0.83146961230254524 * t876;
+    const double t924 = 0.83146961230254524 * t875 + 0.55557023301960218 * t876;
+    const double t925 = t708 + t923;
+    const double t926 = t709 + t924;
+    const double t927 = t708 - t923;
+    const double t928 = t709 - t924;
+    const double t929 = 0.38268343236508978 * t883 - 0.92387953251128674 * t884;
+    const double t930 = 0.92387953251128674 * t883 + 0.38268343236508978 * t884;
+    const double t931 = t716 + t929;
+    const double t932 = t717 + t930;
+    const double t933 = t716 - t929;
+    const double t934 = t717 - t930;
+    const double t935 = 0.19509032201612828 * t889 - 0.98078528040323043 * t890;
+    const double t936 = 0.98078528040323043 * t889 + 0.19509032201612828 * t890;
+    const double t937 = t722 + t935;
+    const double t938 = t723 + t936;
+    const double t939 = t722 - t935;
+    const double t940 = t723 - t936;
+    const double t941 = -t847;
+    const double t942 = t679 + t941;
+    const double t943 = t680 + t846;
+    const double t944 = t679 - t941;
+    const double t945 = t680 - t846;
+    const double t946 = -0.19509032201612828 * t852 - 0.98078528040323043 * t853;
+    const double t947 = 0.98078528040323043 * t852 + -0.19509032201612828 * t853;
+    const double t948 = t685 + t946;
+    const double t949 = t686 + t947;
+    const double t950 = t685 - t946;
+    const double t951 = t686 - t947;
+    const double t952 = -0.38268343236508978 * t860 - 0.92387953251128674 * t861;
+    const double t953 = 0.92387953251128674 * t860 + -0.38268343236508978 * t861;
+    const double t954 = t693 + t952;
+    const double t955 = t694 + t953;
+    const double t956 = t693 - t952;
+    const double t957 = t694 - t953;
+    const double t958 = -0.55557023301960218 * t866 - 0.83146961230254524 * t867;
+    const double t959 = 0.83146961230254524 * t866 + -0.55557023301960218 * t867;
+    const double t960 = t699 + t958;
+    const double t961 = t700 + t959;
+    const double t962 = t699 - t958;
+    const double t963 = t700 - t959;
+    const double t964 = t871 + t872;
+    const double t965 = t872 - t871;
+    const double t966 = -0.70710678118654757 * t964;
+    const double t967 = -0.70710678118654757 * t965;
+    const double t968 = t704 + t966;
+    const double t969 = t705 + t967;
+    const double t970 = t704 - t966;
+    const double t971 = t705 - t967;
+    const double t972 = -0.83146961230254524 * t877 - 0.55557023301960218 * t878;
+    const double t973 = 0.55557023301960218 * t877 + -0.83146961230254524 * t878;
+    const double t974 = t710 + t972;
+    const double t975 = t711 + t973;
+    const double t976 = t710 - t972;
+    const double t977 = t711 - t973;
+    const double t978 = -0.92387953251128674 * t885 - 0.38268343236508978 * t886;
+    const double t979 = 0.38268343236508978 * t885 + -0.92387953251128674 * t886;
+    const double t980 = t718 + t978;
+    const double t981 = t719 + t979;
+    const double t982 = t718 - t978;
+    const double t983 = t719 - t979;
+    const double t984 = -0.98078528040323043 * t891 - 0.19509032201612828 * t892;
+    const double t985 = 0.19509032201612828 * t891 + -0.98078528040323043 * t892;
+    const double t986 = t724 + t984;
+    const double t987 = t725 + t985;
+    const double t988 = t724 - t984;
+    const double t989 = t725 - t985;
+    const double t990 = t462 + t893;
+    const double t991 = t463 + t894;
+    const double t992 = t462 - t893;
+    const double t993 = t463 - t894;
+    const double t994 = 0.99518472667219693 * t899 - 0.098017140329560604 * t900;
+    const double t995 = 0.098017140329560604 * t899 + 0.99518472667219693 * t900;
+    const double t996 = t468 + t994;
+    const double t997 = t469 + t995;
+    const double t998 = t468 - t994;
+    const double t999 = t469 - t995;
+    const double t1000 = 0.98078528040323043 * t905 - 0.19509032201612828 * t906;
+    const double t1001 = 0.19509032201612828 * t905 + 0.98078528040323043 * t906;
+    const double t1002 = t474 + t1000;
+    const double t1003 = t475 + t1001;
+    const double t1004 = t474 - t1000;
+    const double t1005 = t475 - t1001;
+    const double t1006 = 0.95694033573220882 * t911 - 0.29028467725446239 * t912;
+    const double t1007 = 0.29028467725446239 * t911 + 0.95694033573220882 * t912;
+    const double t1008 = t480 + t1006;
+    const double t1009 = t481 + t1007;
+    const double t1010 = t480 - t1006;
+    const double t1011 = t481 - t1007;
+    const double t1012 = 0.92387953251128674 * t919 - 0.38268343236508978 * t920;
+    const double t1013 = 0.38268343236508978 * t919 + 0.92387953251128674 * t920;
+    const double t1014 = t488 + t1012;
+    const double t1015 = t489 + t1013;
+    const double t1016 = t488 - t1012;
+    const double t1017 = t489 - t1013;
+    const double t1018 = 0.88192126434835505 * t925 - 0.47139673682599764 * t926;
+    const double t1019 = 0.47139673682599764 * t925 + 0.88192126434835505 * t926;
+    const double t1020 = t494 + t1018;
+    const double t1021 = t495 + t1019;
+    const double t1022 = t494 - t1018;
+    const double t1023 = t495 - t1019;
+    const double t1024 = 0.83146961230254524 * t931 - 0.55557023301960218 * t932;
+    const double t1025 = 0.55557023301960218 * t931 + 0.83146961230254524 * t932;
+    const double t1026 = t500 + t1024;
+    const double t1027 = t501 + t1025;
+    const double t1028 = t500 - t1024;
+    const double t1029 = t501 - t1025;
+    const double t1030 = 0.77301045336273699 * t937 - 0.63439328416364549 * t938;
+    const double t1031 = 0.63439328416364549 * t937 + 0.77301045336273699 * t938;
+    const double t1032 = t506 + t1030;
+    const double t1033 = t507 + t1031;
+    const double t1034 = t506 - t1030;
+    const double t1035 = t507 - t1031;
+    const double t1036 = t942 - t943;
+    const double t1037 = t942 + t943;
+    const double t1038 = 0.70710678118654757 * t1036;
+    const double t1039 = 0.70710678118654757 * t1037;
+    const double t1040 = t511 + t1038;
+    const double t1041 = t512 + t1039;
+    const double t1042 = t511 - t1038;
+    const double t1043 = t512 - t1039;
+    const double t1044 = 0.63439328416364549 * t948 - 0.77301045336273699 * t949;
+    const double t1045 = 0.77301045336273699 * t948 + 0.63439328416364549 * t949;
+    const double t1046 = t517 + t1044;
+    const double t1047 = t518 + t1045;
+    const double t1048 = t517 - t1044;
+    const double t1049 = t518 - t1045;
+    const double t1050 = 0.55557023301960218 * t954 - 0.83146961230254524 * t955;
+    const double t1051 = 0.83146961230254524 * t954 + 0.55557023301960218 * t955;
+    const double t1052 = t523 + t1050;
+    const double t1053 = t524 + t1051;
+    const double t1054 = t523 - t1050;
+    const double t1055 = t524 - t1051;
+    const double t1056 = 0.47139673682599764 * t960 - 0.88192126434835505 * t961;
+    const double t1057 = 0.88192126434835505 * t960 + 0.47139673682599764 * t961;
+    const double t1058 = t529 + t1056;
+    const double t1059 = t530 + t1057;
+    const double t1060 = t529 - t1056;
+    const double t1061 = t530 - t1057;
+    const double t1062 = 0.38268343236508978 * t968 - 0.92387953251128674 * t969;
+    const double t1063 = 0.92387953251128674 * t968 + 0.38268343236508978 * t969;
+    const double t1064 = t537 + t1062;
+    const double t1065 = t538 + t1063;
+    const double t1066 = t537 - t1062;
+    const double t1067 = t538 - t1063;
+    const double t1068 = 0.29028467725446239 * t974 - 0.95694033573220882 * t975;
+    const double t1069 = 0.95694033573220882 * t974 + 0.29028467725446239 * t975;
+    const double t1070 = t543 + t1068;
+    const double t1071 = t544 + t1069;
+    const double t1072 = t543 - t1068;
+    const double t1073 = t544 - t1069;
+    const double t1074 = 0.19509032201612828 * t980 - 0.98078528040323043 * t981;
+    const double t1075 = 0.98078528040323043 * t980 + 0.19509032201612828 * t981;
+    const double t1076 = t549 + t1074;
+    const double t1077 = t550 + t1075;
+    const double t1078 = t549 - t1074;
+    const double t1079 = t550 - t1075;
+    const double t1080 = 0.098017140329560604 * t986 - 0.99518472667219693 * t987;
+    const double t1081 = 0.99518472667219693 * t986 + 0.098017140329560604 * t987;
+    const double t1082 = t555 + t1080;
+    const double t1083 = t556 + t1081;
+    const double t1084 = t555 - t1080;
+    const double t1085 = t556 - t1081;
+    const double t1086 = -t896;
+    const double t1087 = t464 + t1086;
+    const double t1088 = t465 + t895;
+    const double t1089 = t464 - t1086;
+    const double t1090 = t465 - t895;
+    const double t1091 = -0.098017140329560604 * t901 - 0.99518472667219693 * t902;
+    const double t1092 = 0.99518472667219693 * t901 + -0.098017140329560604 * t902;
+    const double t1093 = t470 + t1091;
+    const double t1094 = t471 + t1092;
+    const double t1095 = t470 - t1091;
+    const double t1096 = t471 - t1092;
+    const double t1097 = -0.19509032201612828 * t907 - 0.98078528040323043 * t908;
+    const double t1098 = 0.98078528040323043 * t907 + -0.19509032201612828 * t908;
+    const double t1099 = t476 + t1097;
+    const double t1100 = t477 + t1098;
+    const double t1101 = t476 - t1097;
+    const double t1102 = t477 - t1098;
+    const double t1103 = -0.29028467725446239 * t913 - 0.95694033573220882 * t914;
+    const double t1104 = 0.95694033573220882 * t913 + -0.29028467725446239 * t914;
+    const double t1105 = t482 + t1103;
+    const double t1106 = t483 + t1104;
+    const double t1107 = t482 - t1103;
+    const double t1108 = t483 - t1104;
+    const double t1109 = -0.38268343236508978 * t921 - 0.92387953251128674 * t922;
+    const double t1110 = 0.92387953251128674 * t921 + -0.38268343236508978 * t922;
+    const double t1111 = t490 + t1109;
+    const double t1112 = t491 + t1110;
+    const double t1113 = t490 - t1109;
+    const double t1114 = t491 - t1110;
+    const double t1115 = -0.47139673682599764 * t927 - 0.88192126434835505 * t928;
+    const double t1116 = 0.88192126434835505 * t927 + -0.47139673682599764 * t928;
+    const double t1117 = t496 + t1115;
+    const double t1118 = t497 + t1116;
+    const double t1119 = t496 - t1115;
+    const double t1120 = t497 - t1116;
+    const double t1121 = -0.55557023301960218 * t933 - 0.83146961230254524 * t934;
+    const double t1122 = 0.83146961230254524 * t933 + -0.55557023301960218 * t934;
+    const double t1123 = t502 + t1121;
+    const double t1124 = t503 + t1122;
+    const double t1125 = t502 - t1121;
+    const double t1126 = t503 - t1122;
+    const double t1127 = -0.63439328416364549 * t939 - 0.77301045336273699 * t940;
+    const double t1128 = 0.77301045336273699 * t939 + -0.63439328416364549 * t940;
+    const double t1129 = t508 + t1127;
+    const double t1130 = t509 + t1128;
+    const double t1131 = t508 - t1127;
+    const double t1132 = t509 - t1128;
+    const double t1133 = t944 + t945;
+    const double t1134 = t945 - t944;
+    const double t1135 = -0.70710678118654757 * t1133;
+    const double t1136 = -0.70710678118654757 * t1134;
+    const double t1137 = t513 + t1135;
+    const double t1138 = t514 + t1136;
+    const double t1139 = t513 - t1135;
+    const double t1140 = t514 - t1136;
+    const double t1141 = -0.77301045336273699 * t950 - 0.63439328416364549 * t951;
+    const double t1142 = 0.63439328416364549 * t950 + -0.77301045336273699 * t951;
+    const double t1143 = t519 + t1141;
+    const double t1144 = t520 + t1142;
+    const double t1145 = t519 - t1141;
+    const double t1146 = t520 - t1142;
+    const double t1147 = -0.83146961230254524 * t956 - 0.55557023301960218 * t957;
+    const double t1148 = 0.55557023301960218 * t956 + -0.83146961230254524 * t957;
+    const double t1149 = t525 + t1147;
+    const double t1150 = t526 + t1148;
+    const double t1151 = t525 - t1147;
+    const double t1152 = t526 - t1148;
+    const double t1153 = -0.88192126434835505 * t962 - 0.47139673682599764 * t963;
+    const double t1154 = 0.47139673682599764 * t962 + -0.88192126434835505 * t963;
+    const double t1155 = t531 + t1153;
+    const double t1156 = t532 + t1154;
+    const double t1157 = t531 - t1153;
+    const double t1158 = t532 - t1154;
+    const double t1159 = -0.92387953251128674 * t970 - 0.38268343236508978 * t971;
+    const double t1160 = 0.38268343236508978 * t970 + -0.92387953251128674 * t971;
+    const double t1161 = t539 + t1159;
+    const double t1162 = t540 + t1160;
+    const double t1163 = t539 - t1159;
+    const double t1164 = t540 - t1160;
+    const double t1165 = -0.95694033573220882 * t976 - 0.29028467725446239 * t977;
+    const double t1166 = 0.29028467725446239 * t976 + -0.95694033573220882 * t977;
+    const double t1167 = t545 + t1165;
+    const double t1168 = t546 + t1166;
+    const double t1169 = t545 - t1165;
+    const double t1170 = t546 - t1166;
+    const double t1171 = -0.98078528040323043 * t982 - 0.19509032201612828 * t983;
+    const double t1172 = 0.19509032201612828 * t982 + -0.98078528040323043 * t983;
+    const double t1173 = t551 + t1171;
+    const double t1174 = t552 + t1172;
+    const double t1175 = t551 - t1171;
+    const double t1176 = t552 - t1172;
+    const double t1177 = -0.99518472667219693 * t988 - 0.098017140329560604 * t989;
+    const double t1178 = 0.098017140329560604 * t988 + -0.99518472667219693 * t989;
+    const double t1179 = t557 + t1177;
+    const double t1180 = t558 + t1178;
+    const double t1181 = t557 - t1177;
+    const double t1182 = t558 - t1178;
+    out[0 * os] = CMPLX(t990, t991);
+    out[1 * os] = CMPLX(t996, t997);
+    out[2 * os] = CMPLX(t1002, t1003);
+    out[3 * os] = CMPLX(t1008, t1009);
+    out[4 * os] = CMPLX(t1014, t1015);
+    out[5 * os] = CMPLX(t1020, t1021);
+    out[6 * os] = CMPLX(t1026, t1027);
+    out[7 * os] = CMPLX(t1032, t1033);
+    out[8 * os] = CMPLX(t1040, t1041);
+    out[9 * os] = CMPLX(t1046, t1047);
+    out[10 * os] = CMPLX(t1052, t1053);
+    out[11 * os] = CMPLX(t1058, t1059);
+    out[12 * os] = CMPLX(t1064, t1065);
+    out[13 * os] = CMPLX(t1070, t1071);
+    out[14 * os] = CMPLX(t1076, t1077);
+    out[15 * os] = CMPLX(t1082, t1083);
+    out[16 * os] = CMPLX(t1087, t1088);
+    out[17 * os] = CMPLX(t1093, t1094);
+    out[18 * os] = CMPLX(t1099, t1100);
+    out[19 * os] = CMPLX(t1105, t1106);
+    out[20 * os] = CMPLX(t1111, t1112);
+    out[21 * os] = CMPLX(t1117, t1118);
+    out[22 * os] = CMPLX(t1123, t1124);
+    out[23 * os] = CMPLX(t1129, t1130);
+    out[24 * os] = CMPLX(t1137, t1138);
+    out[25 * os] = CMPLX(t1143, t1144);
+    out[26 * os] = CMPLX(t1149, t1150);
+    out[27 * os] = CMPLX(t1155, t1156);
+    out[28 * os] = CMPLX(t1161, t1162);
+    out[29 * os] = CMPLX(t1167, t1168);
+    out[30 * os] = CMPLX(t1173, t1174);
+    out[31 * os] = CMPLX(t1179, t1180);
+    out[32 * os] = CMPLX(t992, t993);
+    out[33 * os] = CMPLX(t998, t999);
+    out[34 * os] = CMPLX(t1004, t1005);
+    out[35 * os] = CMPLX(t1010, t1011);
+    out[36 * os] = CMPLX(t1016, t1017);
+    out[37 * os] = CMPLX(t1022, t1023);
+    out[38 * os] = CMPLX(t1028, t1029);
+    out[39 * os] = CMPLX(t1034, t1035);
+    out[40 * os] = CMPLX(t1042, t1043);
+    out[41 * os] = CMPLX(t1048, t1049);
+    out[42 * os] = CMPLX(t1054, t1055);
+    out[43 * os] = CMPLX(t1060, t1061);
+    out[44 * os] = CMPLX(t1066, t1067);
+    out[45 * os] = CMPLX(t1072, t1073);
+    out[46 * os] = CMPLX(t1078, t1079);
+    out[47 * os] = CMPLX(t1084, t1085);
+    out[48 * os] = CMPLX(t1089, t1090);
+    out[49 * os] = CMPLX(t1095, t1096);
+    out[50 * os] = CMPLX(t1101, t1102);
+    out[51 * os] = CMPLX(t1107, t1108);
+    out[52 * os] = CMPLX(t1113, t1114);
+    out[53 * os] = CMPLX(t1119, t1120);
+    out[54 * os] = CMPLX(t1125, t1126);
+    out[55 * os] = CMPLX(t1131, t1132);
+    out[56 * os] = CMPLX(t1139, t1140);
+    out[57 * os] = CMPLX(t1145, t1146);
+    out[58 * os] = CMPLX(t1151, t1152);
+    out[59 * os] = CMPLX(t1157, t1158);
+    out[60 * os] = CMPLX(t1163, t1164);
+    out[61 * os] = CMPLX(t1169, t1170);
+    out[62 * os] = CMPLX(t1175, t1176);
+    out[63 * os] = CMPLX(t1181, t1182);
+}
+
+void
+leaf_2(double complex *buf)
+{
+    const double t0 = creal(buf[0]);
+    const double t1 = cimag(buf[0]);
+    const double t2 = creal(buf[1]);
+    const double t3 = cimag(buf[1]);
+    const double t4 = t0 + t2;
+    const double t5 = t1 + t3;
+    const double t6 = t0 - t2;
+    const double t7 = t1 - t3;
+    buf[0] = CMPLX(t4, t5);
+    buf[1] = CMPLX(t6, t7);
+}
+
+void
+leaf_4(double complex *buf)
+{
+    const double t0 = creal(buf[0]);
+    const double t1 = cimag(buf[0]);
+    const double t2 = creal(buf[2]);
+    const double t3 = cimag(buf[2]);
+    const double t4 = creal(buf[1]);
+    const double t5 = cimag(buf[1]);
+    const double t6 = creal(buf[3]);
+    const double t7 = cimag(buf[3]);
+    const double t8 = t0 + t4;
+    const double t9 = t1 + t5;
+    const double t10 = t0 - t4;
+    const double t11 = t1 - t5;
+    const double t12 = t2 + t6;
+    const double t13 = t3 + t7;
+    const double t14 = t2 - t6;
+    const double t15 = t3 - t7;
+    const double t16 = t8 + t12;
+    const double t17 = t9 + t13;
+    const double t18 = t8 - t12;
+    const double t19 = t9 - t13;
+    const double t20 = -t15;
+    const double t21 = t10 + t20;
+    const double t22 = t11 + t14;
+    const double t23 = t10 - t20;
+    const double t24 = t11 - t14;
+    buf[0] = CMPLX(t16, t17);
+    buf[1] = CMPLX(t21, t22);
+    buf[2] = CMPLX(t18, t19);
+    buf[3] = CMPLX(t23, t24);
+}
+
+void
+leaf_8(double complex *buf)
+{
+    const double t0 = creal(buf[0]);
+    const double t1 = cimag(buf[0]);
+    const double t2 = creal(buf[4]);
+    const double t3 = cimag(buf[4]);
+    const double t4 = creal(buf[2]);
+    const double t5 = cimag(buf[2]);
+    const double t6 = creal(buf[6]);
+    const double t7 = cimag(buf[6]);
+    const double t8 = creal(buf[1]);
+    const double t9 = cimag(buf[1]);
+    const double t10 = creal(buf[5]);
+    const double t11 = cimag(buf[5]);
+    const double t12 = creal(buf[3]);
+    const double t13 = cimag(buf[3]);
+    const double t14 = creal(buf[7]);
+    const double t15 = cimag(buf[7]);
+    const double t16 = t0 + t8;
+    const double t17 = t1 + t9;
+    const double t18 = t0 - t8;
+    const double t19 = t1 - t9;
+    const double t20 = t4 + t12;
+    const double t21 = t5 + t13;
+    const double t22 = t4 - t12;
+    const double t23 = t5 - t13;
+    const double t24 = t16 + t20;
+    const double t25 = t17 + t21;
+    const double t26 = t16 - t20;
+    const double t27 = t17 - t21;
+    const double t28 = -t23;
+    const double t29 = t18 + t28;
+    const double t30 = t19 + t22;
+    const double t31 = t18 - t28;
+    const double t32 = t19 - t22;
+    const double t33 = t2 + t10;
+    const double t34 = t3 + t11;
+    const double t35 = t2 - t10;
+    const double t36 = t3 - t11;
+    const double t37 = t6 + t14;
+    const double t38 = t7 + t15;
+    const double t39 = t6 - t14;
+    const double t40 = t7 - t15;
+    const double t41 = t33 + t37;
+    const double t42 = t34 + t38;
+    const double t43 = t33 - t37;
+    const double t44 = t34 - t38;
+    const double t45 = -t40;
+    const double t46 = t35 + t45;
+    const double t47 = t36 + t39;
+    const double t48 = t35 - t45;
+    const double t49 = t36 - t39;
+    const double t50 = t24 + t41;
+    const double t51 = t25 + t42;
+    const double t52 = t24 - t41;
+    const double t53 = t25 - t42;
+    const double t54 = t46 - t47;
+    const double t55 = t46 + t47;
+    const double t56 = 0.70710678118654757 * t54;
+    const double t57 = 0.70710678118654757 * t55;
+    const double t58 = t29 + t56;
+    const double t59 = t30 + t57;
+    const double t60 = t29 - t56;
+    const double t61 = t30 - t57;
+    const double t62 = -t44;
+    const double t63 = t26 + t62;
+    const double t64 = t27 + t43;
+    const double t65 = t26 - t62;
+    const double t66 = t27 - t43;
+    const double t67 = t48 + t49;
+    const double t68 = t49 - t48;
+    const double t69 = -0.70710678118654757 * t67;
+    const double t70 = -0.70710678118654757 * t68;
+    const double t71 = t31 + t69;
+    const double t72 = t32 + t70;
+    const double t73 = t31 - t69;
+    const double t74 = t32 - t70;
+    buf[0] = CMPLX(t50, t51);
+    buf[1] = CMPLX(t58, t59);
+    buf[2] = CMPLX(t63, t64);
+    buf[3] = CMPLX(t71, t72);
+    buf[4] = CMPLX(t52, t53);
+    buf[5] = CMPLX(t60, t61);
+    buf[6] = CMPLX(t65, t66);
+    buf[7] = CMPLX(t73, t74);
+}
+
+void
+leaf_16(double complex *buf)
+{
+    const double t0 = creal(buf[0]);
+    const double t1 = cimag(buf[0]);
+    const double t2 = creal(buf[8]);
+    const double t3 = cimag(buf[8]);
+    const double t4 = creal(buf[4]);
+    const double t5 = cimag(buf[4]);
+    const double t6 = creal(buf[12]);
+    const double t7 = cimag(buf[12]);
+    const double t8 = creal(buf[2]);
+    const double t9 = cimag(buf[2]);
+    const double t10 = creal(buf[10]);
+    const double t11 = cimag(buf[10]);
+    const double t12 = creal(buf[6]);
+    const double t13 = cimag(buf[6]);
+    const double t14 = creal(buf[14]);
+    const double t15 = cimag(buf[14]);
+    const double t16 = creal(buf[1]);
+    const double t17 = cimag(buf[1]);
+    const double t18 = creal(buf[9]);
+    const double t19 = cimag(buf[9]);
+    const double t20 = creal(buf[5]);
+    const double t21 = cimag(buf[5]);
+    const double t22 = creal(buf[13]);
+    const double t23 = cimag(buf[13]);
+    const double t24 = creal(buf[3]);
+    const double t25 = cimag(buf[3]);
+    const double t26 = creal(buf[11]);
+    const double t27 = cimag(buf[11]);
+    const double t28 = creal(buf[7]);
+    const double t29 = cimag(buf[7]);
+    const double t30 = creal(buf[15]);
+    const double t31 = cimag(buf[15]);
+    const double t32 = t0 + t16;
+    const double t33 = t1 + t17;
+    const double t34 = t0 - t16;
+    const double t35 = t1 - t17;
+    const double t36 = t8 + t24;
+    const double t37 = t9 + t25;
+    const double t38 = t8 - t24;
+    const double t39 = t9 - t25;
+    const double t40 = t32 + t36;
+    const double t41 = t33 + t37;
+    const double t42 = t32 - t36;
+    const double t43 = t33 - t37;
+    const double t44 = -t39;
+    const double t45 = t34 + t44;
+    const double t46 = t35 + t38;
+    const double t47 = t34 - t44;
+    const double t48 = t35 - t38;
+    const double t49 = t4 + t20;
+    const double t50 = t5 + t21;
+    const double t51 = t4 - t20;
+    const double t52 = t5 - t21;
+    const double t53 = t12 + t28;
+    const double t54 = t13 + t29;
+    const double t55 = t12 - t28;
+    const double t56 = t13 - t29;
+    const double t57 = t49 + t53;
+    const double t58 = t50 + t54;
+    const double t59 = t49 - t53;
+    const double t60 = t50 - t54;
+    const double t61 = -t56;
+    const double t62 = t51 + t61;
+    const double t63 = t52 + t55;
+    const double t64 = t51 - t61;
+    const double t65 = t52 - t55;
+    const double t66 = t40 + t57;
+    const double t67 = t41 + t58;
+    const double t68 = t40 - t57;
+    const double t69 = t41 - t58;
+    const double t70 = t62 - t63;
+    const double t71 = t62 + t63;
+    const double t72 = 0.70710678118654757 * t70;
+    const double t73 = 0.70710678118654757 * t71;
+    const double t74 = t45 + t72;
+    const double t75 = t46 + t73;
+    const double t76 = t45 - t72;
+    const double t77 = t46 - t73;
+    const double t78 = -t60;
+    const double t79 = t42 + t78;
+    const double t80 = t43 + t59;
+    const double t81 = t42 - t78;
+    const double t82 = t43 - t59;
+    const double t83 = t64 + t65;
+    const double t84 = t65 - t64;
+    const double t85 = -0.70710678118654757 * t83;
+    const double t86 = -0.70710678118654757 * t84;
+    const double t87 = t47 + t85;
+    const double t88 = t48 + t86;
+    const double t89 = t47 - t85;
+    const double t90 = t48 - t86;
+    const double t91 = t2 + t18;
+    const double t92 = t3 + t19;
+    const double t93 = t2 - t18;
+    const double t94 = t3 - t19;
+    const double t95 = t10 + t26;
+    const double t96 = t11 + t27;
+    const double t97 = t10 - t26;
+    const double t98 = t11 - t27;
+    const double t99 = t91 + t95;
+    const double t100 = t92 + t96;
+    const double t101 = t91 - t95;
+    const double t102 = t92 - t96;
+    const double t103 = -t98;
+    const double t104 = t93 + t103;
+    const double t105 = t94 + t97;
+    const double t106 = t93 - t103;
+    const double t107 = t94 - t97;
+    const double t108 = t6 + t22;
+    const double t109 = t7 + t23;
+    const double t110 = t6 - t22;
+    const double t111 = t7 - t23;
+    const double t112 = t14 + t30;
+    const double t113 = t15 + t31;
+    const double t114 = t14 - t30;
+    const double t115 = t15 - t31;
+    const double t116 = t108 + t112;
+    const double t117 = t109 + t113;
+    const double t118 = t108 - t112;
+    const double t119 = t109 - t113;
+    const double t120 = -t115;
+    const double t121 = t110 + t120;
+    const double t122 = t111 + t114;
+    const double t123 = t110 - t120;
+    const double t124 = t111 - t114;
+    const double t125 = t99 + t116;
+    const double t126 = t100 + t117;
+    const double t127 = t99 - t116;
+    const double t128 = t100 - t117;
+    const double t129 = t121 - t122;
+    const double t130 = t121 + t122;
+    const double t131 = 0.70710678118654757 * t129;
+    const double t132 = 0.70710678118654757 * t130;
+    const double t133 = t104 + t131;
+    const double t134 = t105 + t132;
+    const double t135 = t104 - t131;
+    const double t136 = t105 - t132;
+    const double t137 = -t119;
+    const double t138 = t101 + t137;
+    const double t139 = t102 + t118;
+    const double t140 = t101 - t137;
+    const double t141 = t102 - t118;
+    const double t142 = t123 + t124;
+    const double t143 = t124 - t123;
+    const double t144 = -0.70710678118654757 * t142;
+    const double t145 = -0.70710678118654757 * t143;
+    const double t146 = t106 + t144;
+    const double t147 = t107 + t145;
+    const double t148 = t106 - t144;
+    const double t149 = t107 - t145;
+    const double t150 = t66 + t125;
+    const double t151 = t67 + t126;
+    const double t152 = t66 - t125;
+    const double t153 = t67 - t126;
+    const double t154 = 0.92387953251128674 * t133 - 0.38268343236508978 * t134;
+    const double t155 = 0.38268343236508978 * t133 + 0.92387953251128674 * t134;
+    const double t156 = t74 + t154;
+    const double t157 = t75 + t155;
+    const double t158 = t74 - t154;
+    const double t159 = t75 - t155;
+    const double t160 = t138 - t139;
+    const double t161 = t138 + t139;
+    const double t162 = 0.70710678118654757 * t160;
+    const double t163 = 0.70710678118654757 * t161;
+    const double t164 = t79 + t162;
+    const double t165 = t80 + t163;
+    const double t166 = t79 - t162;
+    const double t167 = t80 - t163;
+    const double t168 = 0.38268343236508978 * t146 - 0.92387953251128674 * t147;
+    const double t169 = 0.92387953251128674 * t146 + 0.38268343236508978 * t147;
+    const double t170 = t87 + t168;
+    const double t171 = t88 + t169;
+    const double t172 = t87 - t168;
+    const double t173 = t88 - t169;
+    const double t174 = -t128;
+    const double t175 = t68 + t174;
+    const double t176 = t69 + t127;
+    const double t177 = t68 - t174;
+    const double t178 = t69 - t127;
+    const double t179 = -0.38268343236508978 * t135 - 0.92387953251128674 * t136;
+    const double t180 = 0.92387953251128674 * t135 + -0.38268343236508978 * t136;
+    const double t181 = t76 + t179;
+    const double t182 = t77 + t180;
+    const double t183 = t76 - t179;
+    const double t184 = t77 - t180;
+    const double t185 = t140 + t141;
+    const double t186 = t141 - t140;
+    const double t187 = -0.70710678118654757 * t185;
+    const double t188 = -0.70710678118654757 * t186;
+    const double t189 = t81 + t187;
+    const double t190 = t82 + t188;
+    const double t191 = t81 - t187;
+    const double t192 = t82 - t188;
+    const double t193 = -0.92387953251128674 * t148 - 0.38268343236508978 * t149;
+    const double t194 = 0.38268343236508978 * t148 + -0.92387953251128674 * t149;
+    const double t195 = t89 + t193;
+    const double t196 = t90 + t194;
+    const double t197 = t89 - t193;
+    const double t198 = t90 - t194;
+    buf[0] = CMPLX(t150, t151);
+    buf[1] = CMPLX(t156, t157);
+    buf[2] = CMPLX(t164, t165);
+    buf[3] = CMPLX(t170, t171);
+    buf[4] = CMPLX(t175, t176);
+    buf[5] = CMPLX(t181, t182);
+    buf[6] = CMPLX(t189, t190);
+    buf[7] = CMPLX(t195, t196);
+    buf[8] = CMPLX(t152, t153);
+    buf[9] = CMPLX(t158, t159);
+    buf[10] = CMPLX(t166, t167);
+    buf[11] = CMPLX(t172, t173);
+    buf[12] = CMPLX(t177, t178);
+    buf[13] = CMPLX(t183, t184);
+    buf[14] = CMPLX(t191, t192);
+    buf[15] = CMPLX(t197, t198);
+}
+
+void
+leaf_32(double complex *buf)
+{
+    const double t0 = creal(buf[0]);
+    const double t1 = cimag(buf[0]);
+    const double t2 = creal(buf[16]);
+    const double t3 = cimag(buf[16]);
+    const double t4 = creal(buf[8]);
+    const double t5 = cimag(buf[8]);
+    const double t6 = creal(buf[24]);
+    const double t7 = cimag(buf[24]);
+    const double t8 = creal(buf[4]);
+    const double t9 = cimag(buf[4]);
+    const double t10 = creal(buf[20]);
+    const double t11 = cimag(buf[20]);
+    const double t12 = creal(buf[12]);
+    const double t13 = cimag(buf[12]);
+    const double t14 = creal(buf[28]);
+    const double t15 = cimag(buf[28]);
+    const double t16 = creal(buf[2]);
+    const double t17 = cimag(buf[2]);
+    const double t18 = creal(buf[18]);
+    const double t19 = cimag(buf[18]);
+    const double t20 = creal(buf[10]);
+    const double t21 = cimag(buf[10]);
+    const double t22 = creal(buf[26]);
+    const double t23 = cimag(buf[26]);
+    const double t24 = creal(buf[6]);
+    const double t25 = cimag(buf[6]);
+    const double t26 = creal(buf[22]);
+    const double t27 = cimag(buf[22]);
+    const double t28 = creal(buf[14]);
+    const double t29 = cimag(buf[14]);
+    const double t30 = creal(buf[30]);
+    const double t31 = cimag(buf[30]);
+    const double t32 = creal(buf[1]);
+    const double t33 = cimag(buf[1]);
+    const double t34 = creal(buf[17]);
+    const double t35 = cimag(buf[17]);
+    const double t36 = creal(buf[9]);
+    const double t37 = cimag(buf[9]);
+    const double t38 = creal(buf[25]);
+    const double t39 = cimag(buf[25]);
+    const double t40 = creal(buf[5]);
+    const double t41 = cimag(buf[5]);
+    const double t42 = creal(buf[21]);
+    const double t43 = cimag(buf[21]);
+    const double t44 = creal(buf[13]);
+    const double t45 = cimag(buf[13]);
+    const double t46 = creal(buf[29]);
+    const double t47 = cimag(buf[29]);
+    const double t48 = creal(buf[3]);
+    const double t49 = cimag(buf[3]);
+    const double t50 = creal(buf[19]);
+    const double t51 = cimag(buf[19]);
+    const double t52 = creal(buf[11]);
+    const double t53 = cimag(buf[11]);
+    const double t54 = creal(buf[27]);
+    const double t55 = cimag(buf[27]);
+    const double t56 = creal(buf[7]);
+    const double t57 = cimag(buf[7]);
+    const double t58 = creal(buf[23]);
+    const double t59 = cimag(buf[23]);
+    const double t60 = creal(buf[15]);
+    const double t61 = cimag(buf[15]);
+    const double t62 = creal(buf[31]);
+    const double t63 = cimag(buf[31]);
+    const double t64 = t0 + t32;
+    const double t65 = t1 + t33;
+    const double t66 = t0 - t32;
+    const double t67 = t1 - t33;
+    const double t68 = t16 + t48;
+    const double t69 = t17 + t49;
+    const double t70 = t16 - t48;
+    const double t71 = t17 - t49;
+    const double t72 = t64 + t68;
+    const double t73 = t65 + t69;
+    const double t74 = t64 - t68;
+    const double t75 = t65 - t69;
+    const double t76 = -t71;
+    const double t77 = t66 + t76;
+    const double t78 = t67 + t70;
+    const double t79 = t66 - t76;
+    const double t80 = t67 - t70;
+    const double t81 = t8 + t40;
+    const double t82 = t9 + t41;
+    const double t83 = t8 - t40;
+    const double t84 = t9 - t41;
+    const double t85 = t24 + t56;
+    const double t86 = t25 + t57;
+    const double t87 = t24 - t56;
+    const double t88 = t25 - t57;
+    const double t89 = t81 + t85;
+    const double t90 = t82 + t86;
+    const double t91 = t81 - t85;
+    const double t92 = t82 - t86;
+    const double t93 = -t88;
+    const double t94 = t83 + t93;
+    const double t95 = t84 + t87;
+    const double t96 = t83 - t93;
+    const double t97 = t84 - t87;
+    const double t98 = t72 + t89;
+    const double t99 = t73 + t90;
+    const double t100 = t72 - t89;
+    const double t101 = t73 - t90;
+    const double t102 = t94 - t95;
+    const double t103 = t94 + t95;
+    const double t104 = 0.70710678118654757 * t102;
+    const double t105 = 0.70710678118654757 * t103;
+    const double t106 = t77 + t104;
+    const double t107 = t78 + t105;
+    const double t108 = t77 - t104;
+    const double t109 = t78 - t105;
+    const double t110 = -t92;
+    const double t111 = t74 + t110;
+    const double t112 = t75 + t91;
+    const double t113 = t74 - t110;
+    const double t114 = t75 - t91;
+    const double t115 = t96 + t97;
+    const double t116 = t97 - t96;
+    const double t117 = -0.70710678118654757 * t115;
+    const double t118 = -0.70710678118654757 * t116;
+    const double t119 = t79 + t117;
+    const double t120 = t80 + t118;
+    const double t121 = t79 - t117;
+    const double t122 = t80 - t118;
+    const double t123 = t4 + t36;
+    const double t124 = t5 + t37;
+    const double t125 = t4 - t36;
+    const double t126 = t5 - t37;
+    const double t127 = t20 + t52;
+    const double t128 = t21 + t53;
+    const double t129 = t20 - t52;
+    const double t130 = t21 - t53;
+    const double t131 = t123 + t127;
+    const double t132 = t124 + t128;
+    const double t133 = t123 - t127;
+    const double t134 = t124 - t128;
+    const double t135 = -t130;
+    const double t136 = t125 + t135;
+    const double t137 = t126 + t129;
+    const double t138 = t125 - t135;
+    const double t139 = t126 - t129;
+    const double t140 = t12 + t44;
+    const double t141 = t13 + t45;
+    const double t142 = t12 - t44;
+    const double t143 = t13 - t45;
+    const double t144 = t28 + t60;
+    const double t145 = t29 + t61;
+    const double t146 = t28 - t60;
+    const double t147 = t29 - t61;
+    const double t148 = t140 + t144;
+    const double t149 = t141 + t145;
+    const double t150 = t140 - t144;
+    const double t151 = t141 - t145;
+    const double t152 = -t147;
+    const double t153 = t142 + t152;
+    const double t154 = t143 + t146;
+    const double t155 = t142 - t152;
+    const double t156 = t143 - t146;
+    const double t157 = t131 + t148;
+    const double t158 = t132 + t149;
+    const double t159 = t131 - t148;
+    const double t160 = t132 - t149;
+    const double t161 = t153 - t154;
+    const double t162 = t153 + t154;
+    const double t163 = 0.70710678118654757 * t161;
+    const double t164 = 0.70710678118654757 * t162;
+    const double t165 = t136 + t163;
+    const double t166 = t137 + t164;
+    const double t167 = t136 - t163;
+    const double t168 = t137 - t164;
+    const double t169 = -t151;
+    const double t170 = t133 + t169;
+    const double t171 = t134 + t150;
+    const double t172 = t133 - t169;
+    const double t173 = t134 - t150;
+    const double t174 = t155 + t156;
+    const double t175 = t156 - t155;
+    const double t176 = -0.70710678118654757 * t174;
+    const double t177 = -0.70710678118654757 * t175;
+    const double t178 = t138 + t176;
+    const double t179 = t139 + t177;
+    const double t180 = t138 - t176;
+    const double t181 = t139 - t177;
+    const double t182 = t98 + t157;
+    const double t183 = t99 + t158;
+    const double t184 = t98 - t157;
+    const double t185 = t99 - t158;
+    const double t186 = 0.92387953251128674 * t165 - 0.38268343236508978 * t166;
+    const double t187 = 0.38268343236508978 * t165 + 0.92387953251128674 * t166;
+    const double t188 = t106 + t186;
+    const double t189 = t107 + t187;
+    const double t190 = t106 - t186;
+    const double t191 = t107 - t187;
+    const double t192 = t170 - t171;
+    const double t193 = t170 + t171;
+    const double t194 = 0.70710678118654757 * t192;
+    const double t195 = 0.70710678118654757 * t193;
+    const double t196 = t111 + t194;
+    const double t197 = t112 + t195;
+    const double t198 = t111 - t194;
+    const double t199 = t112 - t195;
+    const double t200 = 0.38268343236508978 * t178 - 0.92387953251128674 * t179;
+    const double t201 = 0.92387953251128674 * t178 + 0.38268343236508978 * t179;
+    const double t202 = t119 + t200;
+    const double t203 = t120 + t201;
+    const double t204 = t119 - t200;
+    const double t205 = t120 - t201;
+    const double t206 = -t160;
+    const double t207 = t100 + t206;
+    const double t208 = t101 + t159;
+    const double t209 = t100 - t206;
+    const double t210 = t101 - t159;
+    const double t211 = -0.38268343236508978 * t167 - 0.92387953251128674 * t168;
+    const double t212 = 0.92387953251128674 * t167 + -0.38268343236508978 * t168;
+    const double t213 = t108 + t211;
+    const double t214 = t109 + t212;
+    const double t215 = t108 - t211;
+    const double t216 = t109 - t212;
+    const double t217 = t172 + t173;
+    const double t218 = t173 - t172;
+    const double t219 = -0.70710678118654757 * t217;
+    const double t220 = -0.70710678118654757 * t218;
+    const double t221 = t113 + t219;
+    const double t222 = t114 + t220;
+    const double t223 = t113 - t219;
+    const double t224 = t114 - t220;
+    const double t225 = -0.92387953251128674 * t180 - 0.38268343236508978 * t181;
+    const double t226 = 0.38268343236508978 * t180 + -0.92387953251128674 * t181;
+    const double t227 = t121 + t225;
+    const double t228 = t122 + t226;
+    const double t229 = t121 - t225;
+    const double t230 = t122 - t226;
+    const double t231 = t2 + t34;
+    const double t232 = t3 + t35;
+    const double t233 = t2 - t34;
+    const double t234 = t3 - t35;
+    const double t235 = t18 + t50;
+    const double t236 = t19 + t51;
+    const double t237 = t18 - t50;
+    const double t238 = t19 - t51;
+    const double t239 = t231 + t235;
+    const double t240 = t232 + t236;
+    const double t241 = t231 - t235;
+    const double t242 = t232 - t236;
+    const double t243 = -t238;
+    const double t244 = t233 + t243;
+    const double t245 = t234 + t237;
+    const double t246 = t233 - t243;
+    const double t247 = t234 - t237;
+    const double t248 = t10 + t42;
+    const double t249 = t11 + t43;
+    const double t250 = t10 - t42;
+    const double t251 = t11 - t43;
+    const double t252 = t26 + t58;
+    const double t253 = t27 + t59;
+    const double t254 = t26 - t58;
+    const double t255 = t27 - t59;
+    const double t256 = t248 + t252;
+    const double t257 = t249 + t253;
+    const double t258 = t248 - t252;
+    const double t259 = t249 - t253;
+    const double t260 = -t255;
+    const double t261 = t250 + t260;
+    const double t262 = t251 + t254;
+    const double t263 = t250 - t260;
+    const double t264 = t251 - t254;
+    const double t265 = t239 + t256;
+    const double t266 = t240 + t257;
+    const double t267 = t239 - t256;
+    const double t268 = t240 - t257;
+    const double t269 = t261 - t262;
+    const double t270 = t261 + t262;
+    const double t271 = 0.70710678118654757 * t269;
+    const double t272 = 0.70710678118654757 * t270;
+    const double t273 = t244 + t271;
+    const double t274 = t245 + t272;
+    const double t275 = t244 - t271;
+    const double t276 = t245 - t272;
+    const double t277 = -t259;
+    const double t278 = t241 + t277;
+    const double t279 = t242 + t258;
+    const double t280 = t241 - t277;
+    const double t281 = t242 - t258;
+    const double t282 = t263 + t264;
+    const double t283 = t264 - t263;
+    const double t284 = -0.70710678118654757 * t282;
+    const double t285 = -0.70710678118654757 * t283;
+    const double t286 = t246 + t284;
+    const double t287 = t247 + t285;
+    const double t288 = t246 - t284;
+    const double t289 = t247 - t285;
+    const double t290 = t6 + t38;
+    const double t291 = t7 + t39;
+    const double t292 = t6 - t38;
+    const double t293 = t7 - t39;
+    const double t294 = t22 + t54;
+    const double t295 = t23 + t55;
+    const double t296 = t22 - t54;
+    const double t297 = t23 - t55;
+    const double t298 = t290 + t294;
+    const double t299 = t291 + t295;
+    const double t300 = t290 - t294;
+    const double t301 = t291 - t295;
+    const double t302 = -t297;
+    const double t303 = t292 + t302;
+    const double t304 = t293 + t296;
+    const double t305 = t292 - t302;
+    const double t306 = t293 - t296;
+    const double t307 = t14 + t46;
+    const double t308 = t15 + t47;
+    const double t309 = t14 - t46;
+    const double t310 = t15 - t47;
+    const double t311 = t30 + t62;
+    const double t312 = t31 + t63;
+    const double t313 = t30 - t62;
+    const double t314 = t31 - t63;
+    const double t315 = t307 + t311;
+    const double t316 = t308 + t312;
+    const double t317 = t307 - t311;
+    const double t318 = t308 - t312;
+    const double t319 = -t314;
+    const double t320 = t309 + t319;
+    const double t321 = t310 + t313;
+    const double t322 = t309 - t319;
+    const double t323 = t310 - t313;
+    const double t324 = t298 + t315;
+    const double t325 = t299 + t316;
+    const double t326 = t298 - t315;
+    const double t327 = t299 - t316;
+    const double t328 = t320 - t321;
+    const double t329 = t320 + t321;
+    const double t330 = 0.70710678118654757 * t328;
+    const double t331 = 0.70710678118654757 * t329;
+    const double t332 = t303 + t330;
+    const double t333 = t304 + t331;
+    const double t334 = t303 - t330;
+    const double t335 = t304 - t331;
+    const double t336 = -t318;
+    const double t337 = t300 + t336;
+    const double t338 = t301 + t317;
+    const double t339 = t300 - t336;
+    const double t340 = t301 - t317;
+    const double t341 = t322 + t323;
+    const double t342 = t323 - t322;
+    const double t343 = -0.70710678118654757 * t341;
+    const double t344 = -0.70710678118654757 * t342;
+    const double t345 = t305 + t343;
+    const double t346 = t306 + t344;
+    const double t347 = t305 - t343;
+    const double t348 = t306 - t344;
+    const double t349 = t265 + t324;
+    const double t350 = t266 + t325;
+    const double t351 = t265 - t324;
+    const double t352 = t266 - t325;
+    const double t353 = 0.92387953251128674 * t332 - 0.38268343236508978 * t333;
+    const double t354 = 0.38268343236508978 * t332 + 0.92387953251128674 * t333;
+    const double t355 = t273 + t353;
+    const double t356 = t274 + t354;
+    const double t357 = t273 - t353;
+    const double t358 = t274 - t354;
+    const double t359 = t337 - t338;
+    const double t360 = t337 + t338;
+    const double t361 = 0.70710678118654757 * t359;
+    const double t362 = 0.70710678118654757 * t360;
+    const double t363 = t278 + t361;
+    const double t364 = t279 + t362;
+    const double t365 = t278 - t361;
+    const double t366 = t279 - t362;
+    const double t367 = 0.38268343236508978 * t345 - 0.92387953251128674 * t346;
+    const double t368 = 0.92387953251128674 * t345 + 0.38268343236508978 * t346;
+    const double t369 = t286 + t367;
+    const double t370 = t287 + t368;
+    const double t371 = t286 - t367;
+    const double t372 = t287 - t368;
+    const double t373 = -t327;
+    const double t374 = t267 + t373;
+    const double t375 = t268 + t326;
+    const double t376 = t267 - t373;
+    const double t377 = t268 - t326;
+    const double t378 = -0.38268343236508978 * t334 - 0.92387953251128674 * t335;
+    const double t379 = 0.92387953251128674 * t334 + -0.38268343236508978 * t335;
+    const double t380 = t275 + t378;
+    const double t381 = t276 + t379;
+    const double t382 = t275 - t378;
+    const double t383 = t276 - t379;
+    const double t384 = t339 + t340;
+    const double t385 = t340 - t339;
+    const double t386 = -0.70710678118654757 * t384;
+    const double t387 = -0.70710678118654757 * t385;
+    const double t388 = t280 + t386;
+    const double t389 = t281 + t387;
+    const double t390 = t280 - t386;
+    const double t391 = t281 - t387;
+    const double t392 = -0.92387953251128674 * t347 - 0.38268343236508978 * t348;
+    const double t393 = 0.38268343236508978 * t347 + -0.92387953251128674 * t348;
+    const double t394 = t288 + t392;
+    const double t395 = t289 + t393;
+    const double t396 = t288 - t392;
+    const double t397 = t289 - t393;
+    const double t398 = t182 + t349;
+    const double t399 = t183 + t350;
+    const double t400 = t182 - t349;
+    const double t401 = t183 - t350;
+    const double t402 = 0.98078528040323043 * t355 - 0.19509032201612828 * t356;
+    const double t403 = 0.19509032201612828 * t355 + 0.98078528040323043 * t356;
+    const double t404 = t188 + t402;
+    const double t405 = t189 + t403;
+    const double t406 = t188 - t402;
+    const double t407 = t189 - t403;
+    const double t408 = 0.92387953251128674 * t363 - 0.38268343236508978 * t364;
+    const double t409 = 0.38268343236508978 * t363 + 0.92387953251128674 * t364;
+    const double t410 = t196 + t408;
+    const double t411 = t197 + t409;
+    const double t412 = t196 - t408;
+    const double t413 = t197 - t409;
+    const double t414 = 0.83146961230254524 * t369 - 0.55557023301960218 * t370;
+    const double t415 = 0.55557023301960218 * t369 + 0.83146961230254524 * t370;
+    const double t416 = t202 + t414;
+    const double t417 = t203 + t415;
+    const double t418 = t202 - t414;
+    const double t419 = t203 - t415;
+    const double t420 = t374 - t375;
+    const double t421 = t374 + t375;
+    const double t422 = 0.70710678118654757 * t420;
+    const double t423 = 0.70710678118654757 * t421;
+    const double t424 = t207 + t422;
+    const double t425 = t208 + t423;
+    const double t426 = t207 - t422;
+    const double t427 = t208 - t423;
+    const double t428 = 0.55557023301960218 * t380 - 0.83146961230254524 * t381;
+    const double t429 = 0.83146961230254524 * t380 + 0.55557023301960218 * t381;
+    const double t430 = t213 + t428;
+    const double t431 = t214 + t429;
+    const double t432 = t213 - t428;
+    const double t433 = t214 - t429;
+    const double t434 = 0.38268343236508978 * t388 - 0.92387953251128674 * t389;
+    const double t435 = 0.92387953251128674 * t388 + 0.38268343236508978 * t389;
+    const double t436 = t221 + t434;
+    const double t437 = t222 + t435;
+    const double t438 = t221 - t434;
+    const double t439 = t222 - t435;
+    const double t440 = 0.19509032201612828 * t394 - 0.98078528040323043 * t395;
+    const double t441 = 0.98078528040323043 * t394 + 0.19509032201612828 * t395;
+    const double t442 = t227 + t440;
+    const double t443 = t228 + t441;
+    const double t444 = t227 - t440;
+    const double t445 = t228 - t441;
+    const double t446 = -t352;
+    const double t447 = t184 + t446;
+    const double t448 = t185 + t351;
+    const double t449 = t184 - t446;
+    const double t450 = t185 - t351;
+    const double t451 = -0.19509032201612828 * t357 - 0.98078528040323043 * t358;
+    const double t452 = 0.98078528040323043 * t357 + -0.19509032201612828 * t358;
+    const double t453 = t190 + t451;
+    const double t454 = t191 + t452;
+    const double t455 = t190 - t451;
+    const double t456 = t191 - t452;
+    const double t457 = -0.38268343236508978 * t365 - 0.92387953251128674 * t366;
+    const double t458 = 0.92387953251128674 * t365 + -0.38268343236508978 * t366;
+    const double t459 = t198 + t457;
+    const double t460 = t199 + t458;
+    const double t461 = t198 - t457;
+    const double t462 = t199 - t458;
+    const double t463 = -0.55557023301960218 * t371 - 0.83146961230254524 * t372;
+    const double t464 = 0.83146961230254524 * t371 + -0.55557023301960218 * t372;
+    const double t465 = t204 + t463;
+    const double t466 = t205 + t464;
+    const double t467 = t204 - t463;
+    const double t468 = t205 - t464;
+    const double t469 = t376 + t377;
+    const double t470 = t377 - t376;
+    const double t471 = -0.70710678118654757 * t469;
+    const double t472 = -0.70710678118654757 * t470;
+    const double t473 = t209 + t471;
+    const double t474 = t210 + t472;
+    const double t475 = t209 - t471;
+    const double t476 = t210 - t472;
+    const double t477 = -0.83146961230254524 * t382 - 0.55557023301960218 * t383;
+    const double t478 = 0.55557023301960218 * t382 + -0.83146961230254524 * t383;
+    const double t479 = t215 + t477;
+    const double t480 = t216 + t478;
+    const double t481 = t215 - t477;
+    const double t482 = t216 - t478;
+    const double t483 = -0.92387953251128674 * t390 - 0.38268343236508978 * t391;
+    const double t484 = 0.38268343236508978 * t390 + -0.92387953251128674 * t391;
+    const double t485 = t223 + t483;
+    const double t486 = t224 + t484;
+    const double t487 = t223 - t483;
+    const double t488 = t224 - t484;
+    const double t489 = -0.98078528040323043 * t396 - 0.19509032201612828 * t397;
+    const double t490 = 0.19509032201612828 * t396 + -0.98078528040323043 * t397;
+    const double t491 = t229 + t489;
+    const double t492 = t230 + t490;
+    const double t493 = t229 - t489;
+    const double t494 = t230 - t490;
+    buf[0] = CMPLX(t398, t399);
+    buf[1] = CMPLX(t404, t405);
+    buf[2] = CMPLX(t410, t411);
+    buf[3] = CMPLX(t416, t417);
+    buf[4] = CMPLX(t424, t425);
+    buf[5] = CMPLX(t430, t431);
+    buf[6] = CMPLX(t436, t437);
+    buf[7] = CMPLX(t442, t443);
+    buf[8] = CMPLX(t447, t448);
+    buf[9] = CMPLX(t453, t454);
+    buf[10] = CMPLX(t459, t460);
+    buf[11] = CMPLX(t465, t466);
+    buf[12] = CMPLX(t473, t474);
+    buf[13] = CMPLX(t479, t480);
+    buf[14] = CMPLX(t485, t486);
+    buf[15] = CMPLX(t491, t492);
+    buf[16] = CMPLX(t400, t401);
+    buf[17] = CMPLX(t406, t407);
+    buf[18] = CMPLX(t412, t413);
+    buf[19] = CMPLX(t418, t419);
+    buf[20] = CMPLX(t426, t427);
+    buf[21] = CMPLX(t432, t433);
+    buf[22] = CMPLX(t438, t439);
+    buf[23] = CMPLX(t444, t445);
+    buf[24] = CMPLX(t449, t450);
+    buf[25] = CMPLX(t455, t456);
+    buf[26] = CMPLX(t461, t462);
+    buf[27] = CMPLX(t467, t468);
+    buf[28] = CMPLX(t475, t476);
+    buf[29] = CMPLX(t481, t482);
+    buf[30] = CMPLX(t487, t488);
+    buf[31] = CMPLX(t493, t494);
+}
+
+dft_codelet_t
+dft_codelet(size_t n)
+{
+    switch (n) {
+    case 2:
+        return dft_2;
+    case 4:
+        return dft_4;
+    case 8:
+        return dft_8;
+    case 16:
+        return dft_16;
+    case 32:
+        return dft_32;
+    case 64:
+        return dft_64;
+    default:
+        return NULL;
+    }
+}
+
+leaf_codelet_t
+leaf_codelet(size_t n)
+{
+    switch (n) {
+    case 2:
+        return leaf_2;
+    case 4:
+        return leaf_4;
+    case 8:
+        return leaf_8;
+    case 16:
+        return leaf_16;
+    case 32:
+        return leaf_32;
+    default:
+        return NULL;
+    }
+}
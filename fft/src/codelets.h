@@ -0,0 +1,63 @@
+/*
+ * Generated by tools/gencodelets.py; do not edit.
+ */
+
+#ifndef FOURIER_CODELETS_H
+#define FOURIER_CODELETS_H
+
+#include <stdlib.h>
+#include <complex.h>
+
+/**
+ * The largest size of the codelets.
+ */
+#define CODELET_MAX  64
+
+/**
+ * Straight-line DFT of N points in the natural order.
+ *
+ * @param in    the input.
+ * @param is    the stride of the input.
+ * @param out   the output, which must not overlap the input.
+ * @param os    the stride of the output.
+ */
+typedef void (*dft_codelet_t)(const double complex *in, size_t is,
+                              double complex *out, size_t os);
+
+/**
+ * Straight-line DFT of N points in place, taking the input in the
+ * bit-reversed order.  Equivalent to the first log2(N) stages of
+ * fft() over a block of N points.
+ */
+typedef void (*leaf_codelet_t)(double complex *buf);
+
+void dft_2(const double complex *in, size_t is, double complex *out,
+           size_t os);
+void dft_4(const double complex *in, size_t is, double complex *out,
+           size_t os);
+void dft_8(const double complex *in, size_t is, double complex *out,
+           size_t os);
+void dft_16(const double complex *in, size_t is, double complex *out,
+            size_t os);
+void dft_32(const double complex *in, size_t is, double complex *out,
+            size_t os);
+void dft_64(const double complex *in, size_t is, double complex *out,
+            size_t os);
+
+void leaf_2(double complex *buf);
+void leaf_4(double complex *buf);
+void leaf_8(double complex *buf);
+void leaf_16(double complex *buf);
+void leaf_32(double complex *buf);
+
+/**
+ * Returns the codelet of the size, or NULL if there is none.
+ */
+dft_codelet_t dft_codelet(size_t n);
+
+/**
+ * Returns the leaf codelet of the size, or NULL if there is none.
+ */
+leaf_codelet_t leaf_codelet(size_t n);
+
+#endif /* FOURIER_CODELETS_H */
@@ -0,0 +1,346 @@
+/**
+ * Partitioned convolution
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <complex.h>
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+#include "convolve.h"
+
+static size_t
+block_length(size_t block)
+{
+    return (size_t)1 << to_exp(block - 1);
+}
+
+/*
+ * Rounds the bins up so that every row starts on the workspace alignment.
+ */
+static size_t
+row_stride(size_t block)
+{
+    size_t n = WORKSPACE_ALIGN / sizeof(double);
+    return (block + 1 + n - 1) / n * n;
+}
+
+/*
+ * Returns the number of partitions of each level for a response of the
+ * given length, 0 if the level is not used.
+ */
+static void
+split_response(size_t block, size_t length, size_t parts[2])
+{
+    size_t head = CONV_GROWTH * block;
+
+    if (length <= head) {
+        parts[0] = length > 0 ? (length + block - 1) / block : 1;
+        parts[1] = 0;
+        return;
+    }
+    parts[0] = CONV_GROWTH;
+    parts[1] = (length - head + head - 1) / head;
+}
+
+static size_t
+level_size(size_t block, size_t parts)
+{
+    return fft_plan_size(2 * block)
+         + 2 * workspace_align(sizeof(double) * parts * row_stride(block));
+}
+
+size_t
+conv_plan_size(size_t block, size_t length)
+{
+    size_t parts[2];
+
+    block = block_length(block);
+    split_response(block, length, parts);
+
+    /* The transform buffer is needed only to compute the spectra. */
+    size_t size = level_size(block, parts[0])
+                + fft_buffer_size(2 * CONV_GROWTH * block);
+    if (parts[1] > 0) {
+        size += level_size(CONV_GROWTH * block, parts[1]);
+    }
+    return size;
+}
+
+static int
+level_init(conv_level_t *level, size_t block, size_t parts, const double *ir,
+           size_t length, double complex *buf, workspace_t *ws)
+{
+    level->block = block;
+    level->parts = parts;
+    level->stride = row_stride(block);
+
+    if (fft_plan_init(&level->fft, 2 * block, ws) < 0) {
+        return -1;
+    }
+    level->re = workspace_get(ws, sizeof(double) * parts * level->stride);
+    level->im = workspace_get(ws, sizeof(double) * parts * level->stride);
+    if (level->im == NULL) {
+        return -1;
+    }
+
+    for (size_t p = 0; p < parts; p++) {
+        size_t offset = p * block;
+        size_t count = offset < length ? length - offset : 0;
+        if (count > block) {
+            count = block;
+        }
+        fft_execute(&level->fft, ir + offset, count, buf);
+
+        double *re = level->re + p * level->stride;
+        double *im = level->im + p * level->stride;
+        for (size_t k = 0; k <= block; k++) {
+            re[k] = creal(buf[k]);
+            im[k] = cimag(buf[k]);
+        }
+    }
+
+    return 0;
+}
+
+int
+conv_plan_init(conv_plan_t *plan, size_t block, const double *ir,
+               size_t length, workspace_t *ws)
+{
+    size_t parts[2];
+
+    if (block == 0) {
+        return -1;
+    }
+
+    plan->block = block_length(block);
+    split_response(plan->block, length, parts);
+    plan->levels = parts[1] > 0 ? 2 : 1;
+
+    size_t head = CONV_GROWTH * plan->block;
+    double complex *buf = workspace_get(ws, fft_buffer_size(2 * head));
+    if (buf == NULL ||
+        level_init(&plan->level[0], plan->block, parts[0], ir,
+                   length < head ? length : head, buf, ws) < 0) {
+        return -1;
+    }
+    if (plan->levels > 1 &&
+        level_init(&plan->level[1], head, parts[1], ir + head, length - head,
+                   buf, ws) < 0) {
+        return -1;
+    }
+
+    return 0;
+}
+
+static size_t
+line_size(size_t block, size_t parts)
+{
+    size_t stride = row_stride(block);
+
+    return 2 * workspace_align(sizeof(double) * parts * stride)
+         + 2 * workspace_align(sizeof(double) * stride)
+         + workspace_align(sizeof(double) * 2 * block)
+         + fft_buffer_size(2 * block);
+}
+
+size_t
+conv_state_size(size_t block, size_t length)
+{
+    size_t parts[2];
+
+    block = block_length(block);
+    split_response(block, length, parts);
+
+    size_t size = line_size(block, parts[0]);
+    if (parts[1] > 0) {
+        size_t head = CONV_GROWTH * block;
+        size += line_size(head, parts[1])
+              + 2 * workspace_align(sizeof(double) * head);
+    }
+    return size;
+}
+
+static int
+line_init(conv_line_t *line, const conv_level_t *level, workspace_t *ws)
+{
+    size_t rows = level->parts * level->stride;
+
+    line->head = 0;
+    line->re = workspace_get(ws, sizeof(double) * rows);
+    line->im = workspace_get(ws, sizeof(double) * rows);
+    line->acc_re = workspace_get(ws, sizeof(double) * level->stride);
+    line->acc_im = workspace_get(ws, sizeof(double) * level->stride);
+    line->input = workspace_get(ws, sizeof(double) * 2 * level->block);
+    line->buf = workspace_get(ws, fft_buffer_size(2 * level->block));
+    if (line->buf == NULL) {
+        return -1;
+    }
+
+    memset(line->re, 0, sizeof(double) * rows);
+    memset(line->im, 0, sizeof(double) * rows);
+    memset(line->input, 0, sizeof(double) * 2 * level->block);
+
+    return 0;
+}
+
+int
+conv_state_init(conv_state_t *state, const conv_plan_t *plan,
+                workspace_t *ws)
+{
+    state->plan = plan;
+    state->pos = 0;
+    state->gather = NULL;
+    state->tail = NULL;
+
+    for (size_t l = 0; l < plan->levels; l++) {
+        if (line_init(&state->line[l], &plan->level[l], ws) < 0) {
+            return -1;
+        }
+    }
+
+    if (plan->levels > 1) {
+        size_t head = plan->level[1].block;
+        state->gather = workspace_get(ws, sizeof(double) * head);
+        state->tail = workspace_get(ws, sizeof(double) * head);
+        if (state->tail == NULL) {
+            return -1;
+        }
+        memset(state->tail, 0, sizeof(double) * head);
+    }
+
+    return 0;
+}
+
+/*
+ * acc += x * h over n bins of rows aligned to WORKSPACE_ALIGN.
+ */
+static inline void
+multiply_add(double *restrict acc_re, double *restrict acc_im,
+             const double *restrict x_re, const double *restrict x_im,
+             const double *restrict h_re, const double *restrict h_im,
+             size_t n)
+{
+    size_t i = 0;
+
+#if defined(__AVX__)
+    for (; i + 4 <= n; i += 4) {
+        __m256d xr = _mm256_load_pd(x_re + i);
+        __m256d xi = _mm256_load_pd(x_im + i);
+        __m256d hr = _mm256_load_pd(h_re + i);
+        __m256d hi = _mm256_load_pd(h_im + i);
+        __m256d ar = _mm256_load_pd(acc_re + i);
+        __m256d ai = _mm256_load_pd(acc_im + i);
+#if defined(__FMA__)
+        ar = _mm256_fnmadd_pd(xi, hi, _mm256_fmadd_pd(xr, hr, ar));
+        ai = _mm256_fmadd_pd(xi, hr, _mm256_fmadd_pd(xr, hi, ai));
+#else
+        ar = _mm256_add_pd(ar, _mm256_sub_pd(_mm256_mul_pd(xr, hr),
+                                             _mm256_mul_pd(xi, hi)));
+        ai = _mm256_add_pd(ai, _mm256_add_pd(_mm256_mul_pd(xr, hi),
+                                             _mm256_mul_pd(xi, hr)));
+#endif
+        _mm256_store_pd(acc_re + i, ar);
+        _mm256_store_pd(acc_im + i, ai);
+    }
+#elif defined(__SSE2__)
+    for (; i + 2 <= n; i += 2) {
+        __m128d xr = _mm_load_pd(x_re + i);
+        __m128d xi = _mm_load_pd(x_im + i);
+        __m128d hr = _mm_load_pd(h_re + i);
+        __m128d hi = _mm_load_pd(h_im + i);
+        __m128d ar = _mm_load_pd(acc_re + i);
+        __m128d ai = _mm_load_pd(acc_im + i);
+        ar = _mm_add_pd(ar, _mm_sub_pd(_mm_mul_pd(xr, hr),
+                                       _mm_mul_pd(xi, hi)));
+        ai = _mm_add_pd(ai, _mm_add_pd(_mm_mul_pd(xr, hi),
+                                       _mm_mul_pd(xi, hr)));
+        _mm_store_pd(acc_re + i, ar);
+        _mm_store_pd(acc_im + i, ai);
+    }
+#endif
+
+    for (; i < n; i++) {
+        acc_re[i] += x_re[i] * h_re[i] - x_im[i] * h_im[i];
+        acc_im[i] += x_re[i] * h_im[i] + x_im[i] * h_re[i];
+    }
+}
+
+/*
+ * Pushes a block into the delay line of a level and computes the output.
+ */
+static void
+line_process(conv_line_t *line, const conv_level_t *level, const double *in,
+             double *out)
+{
+    size_t b = level->block;
+    size_t stride = level->stride;
+
+    memmove(line->input, line->input + b, sizeof(double) * b);
+    memcpy(line->input + b, in, sizeof(double) * b);
+    fft_execute(&level->fft, line->input, 2 * b, line->buf);
+
+    line->head = line->head + 1 < level->parts ? line->head + 1 : 0;
+    double *re = line->re + line->head * stride;
+    double *im = line->im + line->head * stride;
+    for (size_t k = 0; k <= b; k++) {
+        re[k] = creal(line->buf[k]);
+        im[k] = cimag(line->buf[k]);
+    }
+
+    /* Partition p meets the spectrum of p blocks ago. */
+    memset(line->acc_re, 0, sizeof(double) * stride);
+    memset(line->acc_im, 0, sizeof(double) * stride);
+    size_t row = line->head;
+    for (size_t p = 0; p < level->parts; p++) {
+        multiply_add(line->acc_re, line->acc_im,
+                     line->re + row * stride, line->im + row * stride,
+                     level->re + p * stride, level->im + p * stride, b + 1);
+        row = row > 0 ? row - 1 : level->parts - 1;
+    }
+
+    for (size_t k = 0; k <= b; k++) {
+        line->buf[k] = CMPLX(line->acc_re[k], line->acc_im[k]);
+    }
+    for (size_t k = 1; k < b; k++) {
+        line->buf[2 * b - k] = conj(line->buf[k]);
+    }
+    fft_inverse(&level->fft, line->buf);
+
+    /* The first half wraps around; the second is the linear result. */
+    for (size_t i = 0; i < b; i++) {
+        out[i] = creal(line->buf[b + i]);
+    }
+}
+
+void
+conv_process(conv_state_t *state, const double *in, double *out)
+{
+    const conv_plan_t *plan = state->plan;
+    size_t b = plan->block;
+
+    if (plan->levels == 1) {
+        line_process(&state->line[0], &plan->level[0], in, out);
+        return;
+    }
+
+    /*
+     * The tail starts CONV_GROWTH blocks into the response, so the output
+     * of the blocks gathered so far is due only after the next ones.
+     */
+    double *gather = state->gather + state->pos * b;
+    memcpy(gather, in, sizeof(double) * b);
+    line_process(&state->line[0], &plan->level[0], in, out);
+
+    const double *tail = state->tail + state->pos * b;
+    for (size_t i = 0; i < b; i++) {
+        out[i] += tail[i];
+    }
+
+    if (++state->pos == CONV_GROWTH) {
+        line_process(&state->line[1], &plan->level[1], state->gather,
+                     state->tail);
+        state->pos = 0;
+    }
+}
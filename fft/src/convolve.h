@@ -0,0 +1,192 @@
+#ifndef FOURIER_CONVOLVE_H
+#define FOURIER_CONVOLVE_H
+
+#include <stdlib.h>
+#include <complex.h>
+#include "transform.h"
+#include "workspace.h"
+
+/**
+ * The default number of samples of a block, i.e. the latency.
+ */
+#define CONV_BLOCK      128
+
+/**
+ * The ratio between the partitions of the tail and those of the head.
+ */
+#define CONV_GROWTH     16
+
+/**
+ * The partitions of one segment of the impulse response, all of the same
+ * size.
+ */
+typedef struct conv_level
+{
+    /**
+     * The number of samples of a partition, a power of 2.
+     */
+    size_t block;
+
+    /**
+     * The number of partitions.
+     */
+    size_t parts;
+
+    /**
+     * The distance between the rows of the spectra in doubles, block + 1
+     * rounded up to the workspace alignment.
+     */
+    size_t stride;
+
+    /**
+     * The plan of 2 * block points.
+     */
+    fft_plan_t fft;
+
+    /**
+     * The spectra of the partitions, parts rows each.
+     */
+    double *re;
+    double *im;
+} conv_level_t;
+
+/**
+ * Partitioned convolution with a long impulse response.
+ *
+ * The response is cut into partitions whose spectra of twice their size
+ * are computed once.  Every block of input is transformed together with
+ * the previous one and its spectrum is pushed into a frequency-domain
+ * delay line; the output is the inverse of the sum of the products of the
+ * delay line and the partitions, of which the second half is kept
+ * (overlap-save).  As the samples are real, only the bins 0 to block are
+ * stored, with the real and imaginary parts in separate rows for the
+ * multiply-accumulate.
+ *
+ * The head of the response, CONV_GROWTH * B samples, is cut into
+ * partitions of B samples, so that the latency is B samples.  The rest is
+ * cut into partitions CONV_GROWTH times larger, which are delayed enough
+ * to be computed once every CONV_GROWTH blocks; the cost per sample then
+ * grows with a sixteenth of the length of the response.
+ */
+typedef struct conv_plan
+{
+    /**
+     * The number of samples of a block, a power of 2.
+     */
+    size_t block;
+
+    /**
+     * The number of levels, 2 if the response is longer than its head.
+     */
+    size_t levels;
+
+    conv_level_t level[2];
+} conv_plan_t;
+
+/**
+ * The delay line of a level.
+ */
+typedef struct conv_line
+{
+    /**
+     * The row holding the newest spectrum.
+     */
+    size_t head;
+
+    /**
+     * The spectra of the past blocks, parts rows each.
+     */
+    double *re;
+    double *im;
+
+    /**
+     * The sum of the products.
+     */
+    double *acc_re;
+    double *acc_im;
+
+    /**
+     * The previous and the current block.
+     */
+    double *input;
+
+    /**
+     * The transform buffer.
+     */
+    double complex *buf;
+} conv_line_t;
+
+/**
+ * The state of a stream convolved with a plan.
+ */
+typedef struct conv_state
+{
+    const conv_plan_t *plan;
+
+    conv_line_t line[2];
+
+    /**
+     * The number of blocks gathered for the tail.
+     */
+    size_t pos;
+
+    /**
+     * The input gathered for the tail, and the output of the tail added
+     * to the next CONV_GROWTH blocks.
+     */
+    double *gather;
+    double *tail;
+} conv_state_t;
+
+/**
+ * Returns the size of the workspace needed for the spectra of a plan.
+ *
+ * @param block     the number of samples of a block.
+ * @param length    the number of samples of the impulse response.
+ */
+size_t conv_plan_size(size_t block, size_t length);
+
+/**
+ * Initializes the plan with the spectra of the impulse response.
+ *
+ * @param plan      the plan.
+ * @param block     the number of samples of a block, rounded up to a power
+ *                  of 2.
+ * @param ir        the impulse response.
+ * @param length    the number of samples of the impulse response.
+ * @param ws        the workspace with at least conv_plan_size() bytes
+ *                  left.
+ * @return          0 on success, -1 on failure.
+ */
+int conv_plan_init(conv_plan_t *plan, size_t block, const double *ir,
+                   size_t length, workspace_t *ws);
+
+/**
+ * Returns the size of the workspace needed for the state of a stream.
+ *
+ * @param block     the number of samples of a block.
+ * @param length    the number of samples of the impulse response.
+ */
+size_t conv_state_size(size_t block, size_t length);
+
+/**
+ * Initializes the state of a stream with silence before its start.
+ *
+ * @param state the state.
+ * @param plan  the plan, which may be shared by several streams.
+ * @param ws    the workspace with at least conv_state_size() bytes left.
+ * @return      0 on success, -1 if the workspace is exhausted.
+ */
+int conv_state_init(conv_state_t *state, const conv_plan_t *plan,
+                    workspace_t *ws);
+
+/**
+ * Convolves the next block of a stream.
+ *
+ * @param state the state.
+ * @param in    the plan->block input samples.
+ * @param out   the plan->block output samples, which may be the input.
+ */
+void conv_process(conv_state_t *state, const double *in, double *out);
+
+#endif /* FOURIER_CONVOLVE_H */
@@ -0,0 +1,176 @@
+/**
+ * Correlation through the Fast Fourier Transform
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include <complex.h>
+#include "correlate.h"
+
+size_t
+corr_plan_size(size_t count)
+{
+    return fft_plan_size(2 * count - 1);
+}
+
+size_t
+corr_buffer_size(size_t count)
+{
+    /* The spectrum and the packed samples. */
+    return 2 * fft_buffer_size(2 * count - 1);
+}
+
+int
+corr_plan_init(corr_plan_t *plan, size_t count, workspace_t *ws)
+{
+    plan->count = count;
+    return fft_plan_init(&plan->fft, 2 * count - 1, ws);
+}
+
+void
+corr_execute(const corr_plan_t *plan, const double *x, const double *y,
+             size_t count, double complex *buf)
+{
+    size_t n = plan->fft.length;
+
+    if (count > plan->count) {
+        count = plan->count;
+    }
+
+    if (y == NULL) {
+        fft_execute(&plan->fft, x, count, buf);
+        for (size_t k = 0; k < n; k++) {
+            buf[k] = creal(buf[k]) * creal(buf[k])
+                   + cimag(buf[k]) * cimag(buf[k]);
+        }
+    }
+    else {
+        /*
+         * Transform x + iy at once.  As x and y are real, X[k] is the
+         * even part (Z[k] + conj(Z[n - k])) / 2 and Y[k] the odd part
+         * (Z[k] - conj(Z[n - k])) / 2i; the spectrum of the correlation
+         * is X[k] * conj(Y[k]).
+         */
+        double complex *z = buf + n;
+        for (size_t i = 0; i < count; i++) {
+            z[i] = CMPLX(x[i], y[i]);
+        }
+        fft_execute_complex(&plan->fft, z, count, buf);
+
+        for (size_t k = 0; k <= n / 2; k++) {
+            size_t j = (n - k) & (n - 1);
+            double complex zk = buf[k];
+            double complex zj = buf[j];
+            double complex xk = (zk + conj(zj)) * 0.5;
+            double complex yk = (zk - conj(zj)) * -0.5 * I;
+            double complex xj = (zj + conj(zk)) * 0.5;
+            double complex yj = (zj - conj(zk)) * -0.5 * I;
+            buf[k] = xk * conj(yk);
+            buf[j] = xj * conj(yj);
+        }
+    }
+
+    fft_inverse(&plan->fft, buf);
+}
+
+double
+corr_energy(const double *samples, size_t count)
+{
+    double sum = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        sum += samples[i] * samples[i];
+    }
+    return sum;
+}
+
+int
+corr_find_peak(const corr_plan_t *plan, const double complex *buf,
+               long min_lag, long max_lag, corr_peak_t *peak)
+{
+    long limit = (long)plan->count - 1;
+
+    if (min_lag < -limit) {
+        min_lag = -limit;
+    }
+    if (max_lag > limit) {
+        max_lag = limit;
+    }
+    if (min_lag > max_lag) {
+        return -1;
+    }
+
+    long best = min_lag;
+    for (long l = min_lag + 1; l <= max_lag; l++) {
+        if (corr_at(plan, buf, l) > corr_at(plan, buf, best)) {
+            best = l;
+        }
+    }
+
+    peak->lag = (double)best;
+    peak->value = corr_at(plan, buf, best);
+
+    /* Fit a parabola through the neighbours of an inner maximum. */
+    if (best > -limit && best < limit) {
+        double a = corr_at(plan, buf, best - 1);
+        double b = peak->value;
+        double c = corr_at(plan, buf, best + 1);
+        double d = a - 2.0 * b + c;
+        if (d < 0.0) {
+            double p = 0.5 * (a - c) / d;
+            peak->lag += p;
+            peak->value = b - 0.25 * (a - c) * p;
+        }
+    }
+
+    return 0;
+}
+
+double
+corr_pitch(const corr_plan_t *plan, const double complex *buf,
+           double sample_rate, double f_lo, double f_hi, double *clarity)
+{
+    double energy = corr_at(plan, buf, 0);
+    corr_peak_t peak;
+
+    *clarity = 0.0;
+    if (energy <= 0.0 || f_lo <= 0.0 || f_hi < f_lo) {
+        return 0.0;
+    }
+
+    long min_lag = (long)floor(sample_rate / f_hi);
+    long max_lag = (long)ceil(sample_rate / f_lo);
+    long limit = (long)plan->count - 1;
+    if (min_lag < 1) {
+        min_lag = 1;
+    }
+    if (max_lag > limit - 1) {
+        max_lag = limit - 1;
+    }
+
+    /* The highest local maximum, then the first one close enough to it. */
+    double highest = 0.0;
+    for (long l = min_lag; l <= max_lag; l++) {
+        double c = corr_at(plan, buf, l);
+        if (c > highest && c > corr_at(plan, buf, l - 1) &&
+            c >= corr_at(plan, buf, l + 1)) {
+            highest = c;
+        }
+    }
+
+    long lag = 0;
+    for (long l = min_lag; l <= max_lag && lag == 0; l++) {
+        double c = corr_at(plan, buf, l);
+        if (c >= CORR_PITCH_THRESHOLD * highest && c > 0.0 &&
+            c > corr_at(plan, buf, l - 1) && c >= corr_at(plan, buf, l + 1)) {
+            lag = l;
+        }
+    }
+
+    if (lag == 0 || corr_find_peak(plan, buf, lag, lag, &peak) < 0 ||
+        peak.value <= 0.0 || peak.lag <= 0.0) {
+        return 0.0;
+    }
+
+    *clarity = peak.value / energy;
+    return sample_rate / peak.lag;
+}
@@ -0,0 +1,139 @@
+#ifndef FOURIER_CORRELATE_H
+#define FOURIER_CORRELATE_H
+
+#include <stdlib.h>
+#include <complex.h>
+#include "transform.h"
+#include "workspace.h"
+
+/**
+ * The fraction of the highest maximum of the autocorrelation that the
+ * first maximum must reach to be taken as the period.
+ */
+#define CORR_PITCH_THRESHOLD    0.9
+
+/**
+ * Linear auto- and cross-correlation through the transform.
+ *
+ * The samples are padded to twice their count so that the circular
+ * correlation of the transform equals the linear one.  The correlation
+ * at lag l is sum x[n + l] * y[n]; a positive lag hence means that x
+ * lags behind y.
+ */
+typedef struct corr_plan
+{
+    /**
+     * The number of samples of each signal.
+     */
+    size_t count;
+
+    /**
+     * The plan of 2 * count - 1 points at least.
+     */
+    fft_plan_t fft;
+} corr_plan_t;
+
+/**
+ * The maximum of the correlation in a range of lags.
+ */
+typedef struct corr_peak
+{
+    /**
+     * The lag refined by parabolic interpolation, in samples.
+     */
+    double lag;
+
+    /**
+     * The correlation at the refined lag.
+     */
+    double value;
+} corr_peak_t;
+
+/**
+ * Returns the size of the workspace needed for the tables of a plan.
+ *
+ * @param count the number of samples.
+ */
+size_t corr_plan_size(size_t count);
+
+/**
+ * Returns the size of the workspace needed for a correlation buffer.
+ *
+ * @param count the number of samples.
+ */
+size_t corr_buffer_size(size_t count);
+
+/**
+ * Initializes the plan with the tables in the workspace.
+ *
+ * @param plan  the plan.
+ * @param count the number of samples.
+ * @param ws    the workspace with at least corr_plan_size() bytes left.
+ * @return      0 on success, -1 if the workspace is exhausted.
+ */
+int corr_plan_init(corr_plan_t *plan, size_t count, workspace_t *ws);
+
+/**
+ * Correlates two signals.  Both are packed into a single complex
+ * transform.
+ *
+ * @param plan  the plan.
+ * @param x     the first signal.
+ * @param y     the second signal, or NULL for the autocorrelation of x.
+ * @param count the count of samples of each signal.
+ * @param buf   the buffer of corr_buffer_size() bytes.  The correlation
+ *              is left in its real parts; see corr_at().
+ */
+void corr_execute(const corr_plan_t *plan, const double *x, const double *y,
+                  size_t count, double complex *buf);
+
+/**
+ * Returns the correlation at the lag, which may be negative.
+ */
+static inline double
+corr_at(const corr_plan_t *plan, const double complex *buf, long lag)
+{
+    return creal(buf[(size_t)lag & (plan->fft.length - 1)]);
+}
+
+/**
+ * Returns the sum of the squares of the samples, i.e. the
+ * autocorrelation at lag 0, to normalize the correlation.
+ */
+double corr_energy(const double *samples, size_t count);
+
+/**
+ * Finds the maximum of the correlation in a range of lags.
+ *
+ * @param plan      the plan.
+ * @param buf       the correlation.
+ * @param min_lag   the smallest lag.
+ * @param max_lag   the largest lag.
+ * @param peak      the maximum found.
+ * @return          0 on success, -1 if the range is empty.
+ */
+int corr_find_peak(const corr_plan_t *plan, const double complex *buf,
+                   long min_lag, long max_lag, corr_peak_t *peak);
+
+/**
+ * Estimates the fundamental frequency from an autocorrelation.
+ *
+ * A periodic signal correlates as well at every multiple of its period,
+ * so the period is the first local maximum reaching CORR_PITCH_THRESHOLD
+ * of the highest one in the range, as in the McLeod pitch method, rather
+ * than the highest one, which may be an octave below.
+ *
+ * @param plan          the plan.
+ * @param buf           the autocorrelation.
+ * @param sample_rate   the sampling rate in Hz.
+ * @param f_lo          the lowest frequency in Hz.
+ * @param f_hi          the highest frequency in Hz.
+ * @param clarity       the autocorrelation at the period relative to lag
+ *                      0, in [0, 1] for a periodic signal.
+ * @return              the frequency in Hz, 0 if none has been found.
+ */
+double corr_pitch(const corr_plan_t *plan, const double complex *buf,
+                  double sample_rate, double f_lo, double f_hi,
+                  double *clarity);
+
+#endif /* FOURIER_CORRELATE_H */
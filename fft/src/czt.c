@@ -0,0 +1,143 @@
+/**
+ * Chirp-z transform for zooming into a band
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include <complex.h>
+#include "czt.h"
+
+static inline size_t
+conv_length(size_t count, size_t bins)
+{
+    return count + bins - 1;
+}
+
+size_t
+czt_plan_size(size_t count, size_t bins)
+{
+    size_t len = conv_length(count, bins);
+    return fft_plan_size(len)
+         + workspace_align(sizeof(double complex) * count)
+         + workspace_align(sizeof(double complex) * bins)
+         + fft_buffer_size(len);
+}
+
+size_t
+czt_buffer_size(size_t count, size_t bins)
+{
+    return fft_buffer_size(conv_length(count, bins));
+}
+
+/*
+ * Returns exp(i * a * n^2).  The square is reduced in long double so that
+ * the phase stays accurate for long transforms.
+ */
+static double complex
+chirp(double a, size_t n)
+{
+    long double phase = (long double)a * (long double)n * (long double)n;
+    phase = fmodl(phase, 2.0L * M_PI);
+    return CMPLX(cos((double)phase), sin((double)phase));
+}
+
+int
+czt_plan_init(czt_plan_t *plan, size_t count, size_t bins, double f_lo,
+              double f_hi, double sample_rate, workspace_t *ws)
+{
+    if (count == 0 || bins == 0 || sample_rate <= 0.0) {
+        return -1;
+    }
+
+    plan->count = count;
+    plan->bins = bins;
+    plan->f_lo = f_lo;
+    plan->step = bins > 1 ? (f_hi - f_lo) / (double)(bins - 1) : 0.0;
+
+    if (fft_plan_init(&plan->fft, conv_length(count, bins), ws) < 0) {
+        return -1;
+    }
+
+    plan->pre = workspace_get(ws, sizeof(double complex) * count);
+    plan->post = workspace_get(ws, sizeof(double complex) * bins);
+    plan->kernel = workspace_get(ws, fft_buffer_size(plan->fft.count));
+    if (plan->pre == NULL || plan->post == NULL || plan->kernel == NULL) {
+        return -1;
+    }
+
+    /*
+     * With nk = (n^2 + k^2 - (k - n)^2) / 2, the bin
+     *   X(k) = sum x(n) exp(i (theta n + phi n k))
+     * is the convolution of x(n) exp(i (theta n + phi n^2 / 2)) with
+     * exp(-i phi m^2 / 2), chirped by exp(i phi k^2 / 2).
+     */
+    double theta = 2.0 * M_PI * f_lo / sample_rate;
+    double phi = 2.0 * M_PI * plan->step / sample_rate;
+
+    for (size_t n = 0; n < count; n++) {
+        long double shift = fmodl((long double)theta * n, 2.0L * M_PI);
+        plan->pre[n] = CMPLX(cos((double)shift), sin((double)shift))
+                     * chirp(phi / 2.0, n);
+    }
+    for (size_t k = 0; k < bins; k++) {
+        plan->post[k] = chirp(phi / 2.0, k);
+    }
+
+    /*
+     * The kernel is indexed from -(count - 1) to bins - 1; the negative
+     * part is wrapped around to the end of the circular buffer.
+     */
+    size_t length = plan->fft.length;
+    double complex *kernel = plan->kernel;
+    for (size_t m = 0; m < length; m++) {
+        kernel[m] = 0;
+    }
+    for (size_t m = 0; m < bins; m++) {
+        kernel[m] = conj(chirp(phi / 2.0, m));
+    }
+    for (size_t m = 1; m < count; m++) {
+        kernel[length - m] = conj(chirp(phi / 2.0, m));
+    }
+
+    /* Transform the kernel in place through the bit-reversed order. */
+    for (size_t i = 0; i < length; i++) {
+        size_t j = plan->fft.itable[i];
+        if (i < j) {
+            double complex tmp = kernel[i];
+            kernel[i] = kernel[j];
+            kernel[j] = tmp;
+        }
+    }
+    fft(kernel, plan->fft.exp);
+
+    return 0;
+}
+
+void
+czt_execute(const czt_plan_t *plan, const double *samples, size_t count,
+            double complex *buf)
+{
+    const fft_plan_t *p = &plan->fft;
+
+    if (plan->count < count) {
+        count = plan->count;
+    }
+
+    /* Chirp the samples while sorting them for the butterflies. */
+    for (size_t n = 0; n < count; n++) {
+        buf[p->itable[n]] = samples[n] * plan->pre[n];
+    }
+    for (size_t n = count; n < p->length; n++) {
+        buf[p->itable[n]] = 0;
+    }
+    fft(buf, p->exp);
+
+    for (size_t i = 0; i < p->length; i++) {
+        buf[i] *= plan->kernel[i];
+    }
+    fft_inverse(p, buf);
+
+    for (size_t k = 0; k < plan->bins; k++) {
+        buf[k] *= plan->post[k];
+    }
+}
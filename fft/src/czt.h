@@ -0,0 +1,112 @@
+#ifndef FOURIER_CZT_H
+#define FOURIER_CZT_H
+
+#include <stdlib.h>
+#include <complex.h>
+#include "transform.h"
+#include "workspace.h"
+
+/**
+ * Chirp-z transform evaluating M bins evenly spread over a band.
+ *
+ * The bins are computed with Bluestein's algorithm as a convolution of
+ * the chirped samples, so the cost depends on the number of samples and
+ * bins, not on the resolution of the band.  The spectrum has the same
+ * sign convention as fft().
+ */
+typedef struct czt_plan
+{
+    /**
+     * The number of samples given to the transform.
+     */
+    size_t count;
+
+    /**
+     * The number of bins.
+     */
+    size_t bins;
+
+    /**
+     * The frequency of the first bin in Hz.
+     */
+    double f_lo;
+
+    /**
+     * The distance between the bins in Hz.
+     */
+    double step;
+
+    /**
+     * The plan of the convolution of count + bins - 1 points at least.
+     */
+    fft_plan_t fft;
+
+    /**
+     * The chirp applied to the samples, including the shift to f_lo.
+     */
+    double complex *pre;
+
+    /**
+     * The chirp applied to the bins.
+     */
+    double complex *post;
+
+    /**
+     * The transform of the convolution kernel.
+     */
+    double complex *kernel;
+} czt_plan_t;
+
+/**
+ * Returns the size of the workspace needed for the tables of a plan.
+ *
+ * @param count the number of samples.
+ * @param bins  the number of bins.
+ */
+size_t czt_plan_size(size_t count, size_t bins);
+
+/**
+ * Returns the size of the workspace needed for a transform buffer.
+ *
+ * @param count the number of samples.
+ * @param bins  the number of bins.
+ */
+size_t czt_buffer_size(size_t count, size_t bins);
+
+/**
+ * Initializes the plan with the tables in the workspace.
+ *
+ * @param plan          the plan.
+ * @param count         the number of samples.
+ * @param bins          the number of bins.
+ * @param f_lo          the frequency of the first bin in Hz.
+ * @param f_hi          the frequency of the last bin in Hz.
+ * @param sample_rate   the sampling rate in Hz.
+ * @param ws            the workspace with at least czt_plan_size() bytes
+ *                      left.
+ * @return              0 on success, -1 on failure.
+ */
+int czt_plan_init(czt_plan_t *plan, size_t count, size_t bins, double f_lo,
+                  double f_hi, double sample_rate, workspace_t *ws);
+
+/**
+ * Transforms the samples.  The bins are left in buf[0..bins-1].
+ *
+ * @param plan      the plan.
+ * @param samples   the signal samples.
+ * @param count     the count of samples.
+ * @param buf       the buffer of czt_buffer_size() bytes.
+ */
+void czt_execute(const czt_plan_t *plan, const double *samples, size_t count,
+                 double complex *buf);
+
+/**
+ * Returns the frequency of the bin in Hz.
+ */
+static inline double
+czt_freq(const czt_plan_t *plan, double bin)
+{
+    return plan->f_lo + plan->step * bin;
+}
+
+#endif /* FOURIER_CZT_H */
@@ -0,0 +1,256 @@
+/**
+ * Discrete Cosine Transforms and MDCT
+ */
+
+#include <string.h>
+#include <math.h>
+#include <complex.h>
+#include "dct.h"
+
+static const char *const names[] = { "dct2", "dct3", "dct4" };
+
+int
+dct_parse(const char *name)
+{
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+        if (strcmp(name, names[i]) == 0) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+static size_t
+dct_length(size_t count)
+{
+    return count < 2 ? 2 : (size_t)1 << to_exp(count - 1);
+}
+
+size_t
+dct_plan_size(size_t count)
+{
+    size_t n = dct_length(count);
+
+    return fft_plan_size(n) + fft_plan_size(n / 2)
+         + workspace_align(sizeof(double complex) * n)
+         + 2 * workspace_align(sizeof(double complex) * (n / 2));
+}
+
+size_t
+dct_buffer_size(size_t count)
+{
+    return fft_buffer_size(dct_length(count));
+}
+
+int
+dct_plan_init(dct_plan_t *plan, size_t count, workspace_t *ws)
+{
+    size_t n = dct_length(count);
+
+    plan->length = n;
+    if (fft_plan_init(&plan->full, n, ws) < 0 ||
+        fft_plan_init(&plan->half, n / 2, ws) < 0) {
+        return -1;
+    }
+    plan->shift = workspace_get(ws, sizeof(double complex) * n);
+    plan->pre = workspace_get(ws, sizeof(double complex) * (n / 2));
+    plan->post = workspace_get(ws, sizeof(double complex) * (n / 2));
+    if (plan->post == NULL) {
+        return -1;
+    }
+
+    for (size_t k = 0; k < n; k++) {
+        plan->shift[k] = cexp(I * M_PI * (double)k / (2.0 * (double)n));
+    }
+    for (size_t k = 0; k < n / 2; k++) {
+        plan->pre[k] = cexp(I * M_PI * (4.0 * (double)k + 1.0) /
+                            (4.0 * (double)n));
+        plan->post[k] = cexp(I * M_PI * (double)k / (double)n);
+    }
+
+    return 0;
+}
+
+static void
+dct2(const dct_plan_t *plan, const double *in, double *out,
+     double complex *buf)
+{
+    size_t n = plan->length;
+    const size_t *itable = plan->full.itable;
+
+    for (size_t i = 0; i < n / 2; i++) {
+        buf[itable[i]] = in[2 * i];
+        buf[itable[n - 1 - i]] = in[2 * i + 1];
+    }
+    fft(buf, plan->full.exp);
+
+    for (size_t k = 0; k < n; k++) {
+        out[k] = creal(buf[k]) * creal(plan->shift[k])
+               - cimag(buf[k]) * cimag(plan->shift[k]);
+    }
+}
+
+static void
+dct3(const dct_plan_t *plan, const double *in, double *out,
+     double complex *buf)
+{
+    size_t n = plan->length;
+    const size_t *itable = plan->full.itable;
+
+    /* The spectrum of the reordered samples, halved. */
+    buf[itable[0]] = 0.5 * in[0];
+    for (size_t k = 1; k < n; k++) {
+        buf[itable[k]] = 0.5 * plan->shift[k] * CMPLX(in[k], -in[n - k]);
+    }
+    fft(buf, plan->full.exp);
+
+    for (size_t i = 0; i < n / 2; i++) {
+        out[2 * i] = creal(buf[i]);
+        out[2 * i + 1] = creal(buf[n - 1 - i]);
+    }
+}
+
+static void
+dct4(const dct_plan_t *plan, const double *in, double *out,
+     double complex *buf)
+{
+    size_t n = plan->length;
+    size_t m = n / 2;
+    const size_t *itable = plan->half.itable;
+
+    for (size_t i = 0; i < m; i++) {
+        buf[itable[i]] = plan->pre[i] * CMPLX(in[2 * i], -in[n - 1 - 2 * i]);
+    }
+    fft(buf, plan->half.exp);
+
+    for (size_t k = 0; k < m; k++) {
+        double complex d = buf[k] * plan->post[k];
+        out[2 * k] = creal(d);
+        out[n - 1 - 2 * k] = cimag(d);
+    }
+}
+
+void
+dct_execute(const dct_plan_t *plan, enum dct_type type, const double *in,
+            double *out, double complex *buf)
+{
+    switch (type) {
+    case DCT_II:
+        dct2(plan, in, out, buf);
+        break;
+    case DCT_III:
+        dct3(plan, in, out, buf);
+        break;
+    case DCT_IV:
+        dct4(plan, in, out, buf);
+        break;
+    }
+}
+
+void
+dct_execute_batch(const dct_plan_t *plan, enum dct_type type,
+                  const double *in, double *out, size_t rows,
+                  double complex *buf)
+{
+    size_t n = plan->length;
+
+    for (size_t r = 0; r < rows; r++) {
+        dct_execute(plan, type, in + r * n, out + r * n, buf);
+    }
+}
+
+size_t
+mdct_plan_size(size_t count)
+{
+    size_t m = dct_length(count);
+
+    return dct_plan_size(m) + workspace_align(sizeof(double) * 2 * m);
+}
+
+size_t
+mdct_buffer_size(size_t count)
+{
+    size_t m = dct_length(count);
+
+    return workspace_align(sizeof(double) * m) + dct_buffer_size(m);
+}
+
+int
+mdct_plan_init(mdct_plan_t *plan, size_t count, workspace_t *ws)
+{
+    size_t m = dct_length(count);
+
+    plan->length = m;
+    if (dct_plan_init(&plan->dct, m, ws) < 0) {
+        return -1;
+    }
+    plan->window = workspace_get(ws, sizeof(double) * 2 * m);
+    if (plan->window == NULL) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < 2 * m; i++) {
+        plan->window[i] = sin(M_PI * ((double)i + 0.5) / (2.0 * (double)m));
+    }
+
+    return 0;
+}
+
+/*
+ * The buffer holds the M folded samples followed by the DCT buffer.
+ */
+static double complex *
+dct_buf(const mdct_plan_t *plan, void *buf)
+{
+    return (double complex *)((char *)buf +
+                              workspace_align(sizeof(double) * plan->length));
+}
+
+void
+mdct_execute(const mdct_plan_t *plan, const double *samples, size_t frames,
+             double *out, void *buf)
+{
+    size_t m = plan->length;
+    size_t h = m / 2;
+    const double *w = plan->window;
+    double *u = buf;
+
+    for (size_t f = 0; f < frames; f++) {
+        const double *x = samples + f * m;
+
+        /*
+         * The quarters a, b, c, d of the windowed frame fold into
+         * (-c reversed - d, a - b reversed).
+         */
+        for (size_t i = 0; i < h; i++) {
+            u[i] = -x[3 * h - 1 - i] * w[3 * h - 1 - i]
+                 - x[3 * h + i] * w[3 * h + i];
+            u[h + i] = x[i] * w[i] - x[2 * h - 1 - i] * w[2 * h - 1 - i];
+        }
+        dct_execute(&plan->dct, DCT_IV, u, out + f * m, dct_buf(plan, buf));
+    }
+}
+
+void
+imdct_execute(const mdct_plan_t *plan, const double *coeffs, size_t frames,
+              double *samples, void *buf)
+{
+    size_t m = plan->length;
+    size_t h = m / 2;
+    const double *w = plan->window;
+    double *u = buf;
+    double scale = 2.0 / (double)m;
+
+    for (size_t f = 0; f < frames; f++) {
+        double *y = samples + f * m;
+
+        /* The unfolding is the transpose of the folding. */
+        dct_execute(&plan->dct, DCT_IV, coeffs + f * m, u, dct_buf(plan, buf));
+        for (size_t i = 0; i < h; i++) {
+            y[i] += scale * w[i] * u[h + i];
+            y[h + i] -= scale * w[h + i] * u[m - 1 - i];
+            y[2 * h + i] -= scale * w[2 * h + i] * u[h - 1 - i];
+            y[3 * h + i] -= scale * w[3 * h + i] * u[i];
+        }
+    }
+}
@@ -0,0 +1,197 @@
+#ifndef FOURIER_DCT_H
+#define FOURIER_DCT_H
+
+#include <stdlib.h>
+#include <complex.h>
+#include "transform.h"
+#include "workspace.h"
+
+/**
+ * The real-to-real transforms, without normalization:
+ *
+ *   II   X[k] = sum x[n] cos(pi (n + 1/2) k / N)
+ *   III  X[k] = x[0] / 2 + sum_{n>0} x[n] cos(pi n (k + 1/2) / N)
+ *   IV   X[k] = sum x[n] cos(pi (n + 1/2) (k + 1/2) / N)
+ *
+ * DCT-III undoes DCT-II and DCT-IV undoes itself, both up to N / 2.
+ */
+enum dct_type
+{
+    DCT_II,
+    DCT_III,
+    DCT_IV
+};
+
+/**
+ * Discrete Cosine Transforms of N points, a power of 2, over the complex
+ * transform.
+ *
+ * DCT-II reorders the samples, even ones first and odd ones reversed, so
+ * that their N-point transform rotated by pi k / 2N gives the result
+ * (Makhoul); DCT-III runs the same steps backwards.  DCT-IV packs the
+ * samples into N / 2 complex ones, x[2n] + i x[N - 1 - 2n], and rotates
+ * them before and after an N / 2-point transform.  The rotations are
+ * tables of the plan, written straight into the butterfly order.
+ */
+typedef struct dct_plan
+{
+    /**
+     * The number of points, a power of 2.
+     */
+    size_t length;
+
+    /**
+     * The plans of N and N / 2 points.
+     */
+    fft_plan_t full;
+    fft_plan_t half;
+
+    /**
+     * exp(i pi k / 2N) for k < N, after DCT-II and before DCT-III.
+     */
+    double complex *shift;
+
+    /**
+     * exp(i pi (4n + 1) / 4N) and exp(i pi k / N) for n, k < N / 2,
+     * before and after DCT-IV.
+     */
+    double complex *pre;
+    double complex *post;
+} dct_plan_t;
+
+/**
+ * Modified Discrete Cosine Transform of 2M samples into M coefficients,
+ * through a DCT-IV of the folded frame.
+ *
+ * The frames overlap by half and are weighted by the sine window, which
+ * satisfies the Princen-Bradley condition: the aliasing of the inverse of
+ * a frame cancels out with its neighbours' once they have been windowed
+ * and added (TDAC), and the sum equals the signal.
+ */
+typedef struct mdct_plan
+{
+    /**
+     * The number of coefficients M, a power of 2, and the hop.
+     */
+    size_t length;
+
+    /**
+     * The DCT-IV of M points.
+     */
+    dct_plan_t dct;
+
+    /**
+     * The window of 2M samples.
+     */
+    double *window;
+} mdct_plan_t;
+
+/**
+ * Returns the transform of the name, or -1 if there is none.
+ */
+int dct_parse(const char *name);
+
+/**
+ * Returns the size of the workspace needed for the tables of a plan.
+ *
+ * @param count the number of points.
+ */
+size_t dct_plan_size(size_t count);
+
+/**
+ * Returns the size of the workspace needed for a transform buffer.
+ *
+ * @param count the number of points.
+ */
+size_t dct_buffer_size(size_t count);
+
+/**
+ * Initializes the plan with the tables in the workspace.
+ *
+ * @param plan  the plan.
+ * @param count the number of points, rounded up to a power of 2 of at
+ *              least 2.
+ * @param ws    the workspace with at least dct_plan_size() bytes left.
+ * @return      0 on success, -1 if the workspace is exhausted.
+ */
+int dct_plan_init(dct_plan_t *plan, size_t count, workspace_t *ws);
+
+/**
+ * Transforms plan->length samples.
+ *
+ * @param plan  the plan.
+ * @param type  the transform.
+ * @param in    the samples.
+ * @param out   the result, which may be the input.
+ * @param buf   the buffer of dct_buffer_size() bytes.
+ */
+void dct_execute(const dct_plan_t *plan, enum dct_type type, const double *in,
+                 double *out, double complex *buf);
+
+/**
+ * Transforms consecutive rows of plan->length samples with the same
+ * tables.
+ *
+ * @param plan  the plan.
+ * @param type  the transform.
+ * @param in    the rows of samples.
+ * @param out   the rows of results, which may be the input.
+ * @param rows  the number of rows.
+ * @param buf   the buffer of dct_buffer_size() bytes.
+ */
+void dct_execute_batch(const dct_plan_t *plan, enum dct_type type,
+                       const double *in, double *out, size_t rows,
+                       double complex *buf);
+
+/**
+ * Returns the size of the workspace needed for the tables of a plan.
+ *
+ * @param count the number of coefficients.
+ */
+size_t mdct_plan_size(size_t count);
+
+/**
+ * Returns the size of the workspace needed for a transform buffer.
+ *
+ * @param count the number of coefficients.
+ */
+size_t mdct_buffer_size(size_t count);
+
+/**
+ * Initializes the plan with the tables in the workspace.
+ *
+ * @param plan  the plan.
+ * @param count the number of coefficients, rounded up to a power of 2 of
+ *              at least 2.
+ * @param ws    the workspace with at least mdct_plan_size() bytes left.
+ * @return      0 on success, -1 if the workspace is exhausted.
+ */
+int mdct_plan_init(mdct_plan_t *plan, size_t count, workspace_t *ws);
+
+/**
+ * Transforms consecutive frames of a signal, 2M samples every M.
+ *
+ * @param plan      the plan.
+ * @param samples   the (frames + 1) * M samples.
+ * @param frames    the number of frames.
+ * @param out       the M coefficients of each frame.
+ * @param buf       the buffer of mdct_buffer_size() bytes.
+ */
+void mdct_execute(const mdct_plan_t *plan, const double *samples,
+                  size_t frames, double *out, void *buf);
+
+/**
+ * Inverts consecutive frames and adds them to the signal, so that the
+ * result of mdct_execute() is reconstructed but for the first and the
+ * last M samples, which lack a neighbour.
+ *
+ * @param plan      the plan.
+ * @param coeffs    the M coefficients of each frame.
+ * @param frames    the number of frames.
+ * @param samples   the (frames + 1) * M samples to be added to.
+ * @param buf       the buffer of mdct_buffer_size() bytes.
+ */
+void imdct_execute(const mdct_plan_t *plan, const double *coeffs,
+                   size_t frames, double *samples, void *buf);
+
+#endif /* FOURIER_DCT_H */
@@ -0,0 +1,127 @@
+/**
+ * Parallel decoding of wave data
+ */
+
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "decode.h"
+#include "pool.h"
+
+#define BITS_PER_BYTE   8
+
+typedef struct decode_job
+{
+    const uint8_t *data;
+    size_t frames;
+    size_t channels;
+    size_t bits;
+    float *const *planes;
+} decode_job_t;
+
+uint64_t
+wave_decode_frames(wave_handle_t *h)
+{
+    size_t bits = h->bits_per_sample;
+
+    if (h->unbounded || h->follow >= 0 || h->writer || h->data_offset < 0 ||
+        h->num_channels == 0 ||
+        (bits != BITS_PER_SAMPLE_8 && bits != BITS_PER_SAMPLE_16 &&
+         bits != BITS_PER_SAMPLE_24) ||
+        h->block_size != h->num_channels * bits / BITS_PER_BYTE) {
+        return 0;
+    }
+    return h->length / h->block_size;
+}
+
+/*
+ * Converts the frames of a chunk one channel at a time, so that every
+ * inner loop writes a single contiguous slice of a plane.  The chunk is
+ * small enough to stay in the cache across the channels.
+ */
+static void
+decode_chunk(size_t task, size_t worker, void *arg)
+{
+    const decode_job_t *d = arg;
+    size_t lo = task * DECODE_CHUNK;
+    size_t n = d->frames - lo < DECODE_CHUNK ? d->frames - lo : DECODE_CHUNK;
+    size_t nch = d->channels;
+
+    for (size_t c = 0; c < nch; c++) {
+        float *dst = d->planes[c] + lo;
+
+        if (d->bits == BITS_PER_SAMPLE_8) {
+            const uint8_t *src = d->data + lo * nch + c;
+            for (size_t i = 0; i < n; i++) {
+                dst[i] = (float)src[i * nch] / (float)UINT8_MAX;
+            }
+        }
+        else if (d->bits == BITS_PER_SAMPLE_16) {
+            const int16_t *src = (const int16_t *)d->data + lo * nch + c;
+            for (size_t i = 0; i < n; i++) {
+                dst[i] = (float)src[i * nch] * (1.0f / 32768.0f);
+            }
+        }
+        else {
+            /* Shifted into the top of an int32_t to extend the sign. */
+            const uint8_t *src = d->data + 3 * (lo * nch + c);
+            for (size_t i = 0; i < n; i++) {
+                const uint8_t *p = src + 3 * i * nch;
+                int32_t v = (int32_t)((uint32_t)p[0] << 8 |
+                                      (uint32_t)p[1] << 16 |
+                                      (uint32_t)p[2] << 24) >> 8;
+                dst[i] = (float)v * (1.0f / 8388608.0f);
+            }
+        }
+    }
+}
+
+ssize_t
+wave_decode(wave_handle_t *h, uint64_t first, size_t frames,
+            float *const *planes, size_t nthreads)
+{
+    uint64_t total = wave_decode_frames(h);
+    struct stat st;
+
+    if (total == 0 || fstat(h->fd, &st) < 0) {
+        return -1;
+    }
+
+    /* A file cut short, e.g. by a crashed writer, has fewer frames. */
+    size_t bsize = h->block_size;
+    uint64_t held = st.st_size > h->data_offset
+                  ? (uint64_t)(st.st_size - h->data_offset) / bsize : 0;
+    if (held < total) {
+        total = held;
+    }
+    if (first >= total) {
+        return 0;
+    }
+    if (frames > total - first) {
+        frames = total - first;
+    }
+    if (frames == 0) {
+        return 0;
+    }
+
+    /* The mapping starts at the page holding the first frame. */
+    uint64_t start = h->data_offset + first * bsize;
+    uint64_t page = sysconf(_SC_PAGESIZE);
+    uint64_t base = start - start % page;
+    size_t length = start - base + frames * bsize;
+    uint8_t *map = mmap(NULL, length, PROT_READ, MAP_SHARED, h->fd, base);
+    if (map == MAP_FAILED) {
+        return -1;
+    }
+    /* The kernel reads ahead of every worker, not only of the first. */
+    madvise(map, length, MADV_WILLNEED);
+
+    decode_job_t d = { map + (start - base), frames, h->num_channels,
+                       h->bits_per_sample, planes };
+    size_t ntasks = (frames + DECODE_CHUNK - 1) / DECODE_CHUNK;
+    int ret = pool_run(ntasks, nthreads, decode_chunk, &d);
+
+    munmap(map, length);
+    return ret < 0 ? -1 : (ssize_t)frames;
+}
@@ -0,0 +1,49 @@
+#ifndef FOURIER_DECODE_H
+#define FOURIER_DECODE_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include "wave.h"
+
+/**
+ * The frames converted by a task.  Large enough to amortize the dispatch,
+ * small enough for the slices of a few tasks per worker to fit in its
+ * cache and to balance the load.
+ */
+#define DECODE_CHUNK    ((size_t)1 << 15)
+
+/**
+ * The frames of the planes written at a time by the decoding mode.
+ */
+#define DECODE_WINDOW   ((size_t)1 << 20)
+
+/**
+ * Returns the number of frames of the data chunk, or 0 if it cannot be
+ * decoded in parallel: the length is unknown, the file cannot be mapped
+ * or the format is not 8, 16 or 24-bit PCM.
+ */
+uint64_t wave_decode_frames(wave_handle_t *handle);
+
+/**
+ * Decodes a range of frames into one float plane per channel, with the
+ * samples scaled as wave_single_channel() does.
+ *
+ * The PCM frames have a fixed size, hence the range is split at frame
+ * boundaries into chunks of DECODE_CHUNK frames, which the workers convert
+ * straight from a mapping of the file into their slice of every plane.
+ * Neither the file offset nor the reads of the handle are touched, so the
+ * frames can be decoded in any order.
+ *
+ * @param handle    the handle of a regular file.
+ * @param first     the first frame.
+ * @param frames    the number of frames.
+ * @param planes    the planes of at least frames samples, one per channel.
+ * @param nthreads  the number of workers, 0 for the number of CPUs.
+ * @return          the number of frames decoded, fewer if the file is
+ *                  shorter than its header says, or -1 on failure.
+ */
+ssize_t wave_decode(wave_handle_t *handle, uint64_t first, size_t frames,
+                    float *const *planes, size_t nthreads);
+
+#endif /* FOURIER_DECODE_H */
@@ -3,175 +3,1253 @@
 #include <stdint.h>
 #include <string.h>
 #include <fcntl.h>
+#include <unistd.h>
+#include <getopt.h>
 #include <math.h>
 #include <complex.h>
 #include "wave.h"
+#include "reader.h"
+#include "workspace.h"
+#include "analysis.h"
+#include "batch.h"
+#include "cache.h"
+#include "convolve.h"
+#include "correlate.h"
+#include "fpindex.h"
+#include "dct.h"
+#include "decode.h"
+#include "hilbert.h"
+#include "outofcore.h"
+#include "stats.h"
 
-static inline size_t
-to_exp(size_t count)
+/*
+ * The channel the spectra are computed from.
+ */
+#define SPECTRUM_CHANNEL    0
+
+static void
+usage(const char *name)
+{
+    fprintf(stderr, "usage: %s [-a] [-n frames] [-F frame] [-H hop] "
+                    "[-R rate:ch:bits]\n"
+                    "           [-k peaks [-t level]] [-z lo:hi:bins] "
+                    "[-r rate] [-q] [-S]\n"
+                    "           [-m mels:coeffs] [-w window] "
+                    "[-s bins[:tolerance]] [-c dir[:MiB]]\n"
+                    "           [-f] <wav file|->\n",
+            name);
+    fprintf(stderr, "       %s -O dir [-M memory] [-F frame] [-k peaks] "
+                    "<wav file|->\n", name);
+    fprintf(stderr, "       %s [-P lo:hi | -D delay] [-n frames] [-F frame] "
+                    "[-H hop] <wav file|->\n", name);
+    fprintf(stderr, "       %s -C ir [-F block] [-o output] <wav file|->\n",
+            name);
+    fprintf(stderr, "       %s -E [-F block] <wav file|->\n", name);
+    fprintf(stderr, "       %s -T type [-n frames] [-F frame] <wav file|->\n",
+            name);
+    fprintf(stderr, "       %s -d [-j threads] <wav file>\n", name);
+    fprintf(stderr, "       %s -b <dir|list> [-j threads] [-o output] "
+                    "[-n frames] [-w window] [-m mels:coeffs]\n", name);
+    fprintf(stderr, "       %s -I index -b <dir|list> [-j threads]\n", name);
+    fprintf(stderr, "       %s -I index [-k matches] <wav file|->\n", name);
+    fprintf(stderr, "  -k peaks   write only the strongest peaks\n");
+    fprintf(stderr, "  -t level   minimum magnitude of a peak (0)\n");
+    fprintf(stderr, "  -m mels:n  write n MFCCs as float32 instead of the "
+                    "spectrum\n");
+    fprintf(stderr, "  -w window  none, hann, hamming or blackman (none)\n");
+    fprintf(stderr, "  -s bins    recover only the largest bins with the "
+                    "sparse transform,\n"
+                    "             falling back to the full one beyond the "
+                    "relative error (%g)\n", SPARSE_TOLERANCE);
+    fprintf(stderr, "  -z band    zoom into lo..hi Hz with the given bins\n");
+    fprintf(stderr, "  -r rate    resample to the rate before the transform\n");
+    fprintf(stderr, "  -q         fixed-point transform of the raw PCM\n");
+    fprintf(stderr, "  -c dir     reuse the spectra cached in dir, kept "
+                    "under MiB (%zu)\n", CACHE_BUDGET >> 20);
+    fprintf(stderr, "  -f, --follow\n"
+                    "             keep reading the file as it is written, "
+                    "until it is closed\n");
+    fprintf(stderr, "  -S         write per-stage statistics to stderr\n");
+    fprintf(stderr, "  -a         prefetch blocks on a background thread\n");
+    fprintf(stderr, "  -n frames  number of frames, 0 for all (1)\n");
+    fprintf(stderr, "  -F frame   samples per frame (sample rate)\n");
+    fprintf(stderr, "  -H hop     samples between frames (frame)\n");
+    fprintf(stderr, "  -R format  read raw PCM at rate:channels:bits\n");
+    fprintf(stderr, "  -O dir     transform one frame out of core in dir\n");
+    fprintf(stderr, "  -M memory  MiB of memory for the out-of-core tiles "
+                    "(256)\n");
+    fprintf(stderr, "  -P band    track the pitch within lo..hi Hz\n");
+    fprintf(stderr, "  -D delay   estimate the delay of channel 0 behind 1 "
+                    "up to delay ms\n");
+    fprintf(stderr, "  -C ir      convolve with the impulse response in "
+                    "blocks of %d samples\n", CONV_BLOCK);
+    fprintf(stderr, "  -E         write the envelope and the instantaneous "
+                    "frequency of channel 0\n"
+                    "             as float32 in blocks of %d samples\n",
+            HILBERT_BLOCK);
+    fprintf(stderr, "  -T type    write the dct2, dct3, dct4 or mdct of "
+                    "channel 0 as float32;\n"
+                    "             the mdct has frame coefficients from "
+                    "frames of twice as many\n"
+                    "             samples overlapping by half\n");
+    fprintf(stderr, "  -d         decode every channel to float32 on -j "
+                    "threads, %zu frames\n"
+                    "             at a time\n", DECODE_WINDOW);
+    fprintf(stderr, "  -b src     analyze every file in a directory or list\n");
+    fprintf(stderr, "  -I index   fingerprint the files of -b into the "
+                    "index, or find the best\n"
+                    "             %d matches of the input in it\n",
+            FP_MATCHES);
+    fprintf(stderr, "  -j threads number of batch or decoding workers, 0 for "
+                    "all CPUs (0)\n");
+    fprintf(stderr, "  -o output  write the batch or convolved output to a "
+                    "file\n");
+}
+
+/**
+ * Transforms the first frame of the input with the out-of-core transform.
+ *
+ * @param handle    the input.
+ * @param frame     the number of samples.
+ * @param dir       the directory for the scratch file.
+ * @param memory    the memory for the tiles in bytes.
+ * @param opts      the selection of the result to be written.
+ * @return          EXIT_SUCCESS or EXIT_FAILURE.
+ */
+static int
+out_of_core(wave_handle_t *handle, size_t frame, const char *dir,
+            size_t memory, const output_options_t *opts)
+{
+    int status = EXIT_FAILURE;
+    size_t rlen = wave_read_buffer_size(handle, 1);
+    size_t blen = rlen / wave_bsize(handle);
+    workspace_t *ws = workspace_create(workspace_align(rlen)
+                                       + workspace_align(sizeof(double) * blen),
+                                       0);
+    ooc_fft_t *ooc = ooc_fft_create(dir, frame, memory);
+    if (ws == NULL || ooc == NULL) {
+        goto exit;
+    }
+
+    wave_read_buffer_t rbuf;
+    wave_init_read_buffer(&rbuf, workspace_get(ws, rlen), rlen);
+    double *tmp = workspace_get(ws, sizeof(double) * blen);
+
+    size_t total = 0;
+    while (total < frame) {
+        uint64_t t0 = stats_begin();
+        ssize_t length = wave_rawread(handle, &rbuf);
+        stats_end(STATS_READ, t0);
+        if (length < 0) {
+            goto exit;
+        }
+        if (length == 0) {
+            break;
+        }
+
+        size_t len = length / wave_bsize(handle);
+        STATS_ADD(bytes_read, length);
+        STATS_ADD(samples_decoded, len);
+
+        t0 = stats_begin();
+        wave_single_channel(handle, &rbuf, tmp, len, 0);
+        stats_end(STATS_DECODE, t0);
+        if (ooc_fft_write(ooc, tmp, len) < 0) {
+            goto exit;
+        }
+        total += len;
+    }
+    printf("# %zu samples to be processed.\n",
+           total < frame ? total : frame);
+
+    const double complex *result = ooc_fft_execute(ooc);
+    if (result == NULL) {
+        goto exit;
+    }
+
+    uint64_t t0 = stats_begin();
+    size_t bytes = output_result(stdout, opts, &ooc->plan, wave_sr(handle),
+                                 result);
+    stats_end(STATS_OUTPUT, t0);
+    STATS_ADD(output_bytes, bytes);
+    stats_frame();
+    status = EXIT_SUCCESS;
+
+exit:
+    if (ooc != NULL) {
+        ooc_fft_destroy(ooc);
+    }
+    if (ws != NULL) {
+        workspace_destroy(ws);
+    }
+    return status;
+}
+
+/**
+ * Correlates a frame and writes the pitch or the delay found.
+ */
+static void
+correlate_frame(const corr_plan_t *plan, double *const *win, size_t avail,
+                double time, double sample_rate, double f_lo, double f_hi,
+                long max_lag, double complex *buf)
 {
-    size_t exp;
-    for (exp = 0; count > 0; count >>= 1, exp++) ;
-    return exp;
+    if (max_lag <= 0) {
+        double clarity;
+        corr_execute(plan, win[0], NULL, avail, buf);
+        double f = corr_pitch(plan, buf, sample_rate, f_lo, f_hi, &clarity);
+        printf("%f %f %f\n", time, f, clarity);
+        return;
+    }
+
+    corr_peak_t peak = { 0.0, 0.0 };
+    corr_execute(plan, win[0], win[1], avail, buf);
+    corr_find_peak(plan, buf, -max_lag, max_lag, &peak);
+
+    double norm = sqrt(corr_energy(win[0], avail) * corr_energy(win[1], avail));
+    printf("%f %f %f %f\n", time, peak.lag, peak.lag / sample_rate,
+           norm > 0.0 ? peak.value / norm : 0.0);
 }
 
-static inline size_t*
-create_index_table(size_t exp)
+/**
+ * Tracks the pitch of channel 0, or the delay of channel 0 behind
+ * channel 1, frame by frame.
+ *
+ * @param handle    the input.
+ * @param frame     the samples per frame.
+ * @param hop       the samples between frames.
+ * @param nframes   the number of frames, 0 for all.
+ * @param f_lo      the lowest pitch in Hz.
+ * @param f_hi      the highest pitch in Hz.
+ * @param delay     the largest delay in ms, 0 to track the pitch.
+ * @return          EXIT_SUCCESS or EXIT_FAILURE.
+ */
+static int
+correlation(wave_handle_t *handle, size_t frame, size_t hop, size_t nframes,
+            double f_lo, double f_hi, double delay)
 {
-    size_t length = 1 << exp;
-    size_t *table = malloc(sizeof(size_t) * length);
+    int status = EXIT_FAILURE;
+    size_t nch = delay > 0.0 ? 2 : 1;
+    double sample_rate = wave_sr(handle);
+    long max_lag = (long)(delay * sample_rate / 1000.0);
+
+    if (wave_ch(handle) < nch) {
+        fprintf(stderr, "the delay needs two channels\n");
+        return EXIT_FAILURE;
+    }
+
+    size_t rlen = hop * wave_bsize(handle);
+    size_t wsize = workspace_align(rlen)
+                 + nch * workspace_align(sizeof(double) * frame)
+                 + corr_plan_size(frame) + corr_buffer_size(frame);
+    workspace_t *ws = workspace_create(wsize, 0);
+    if (ws == NULL) {
+        return EXIT_FAILURE;
+    }
+
+    corr_plan_t plan;
+    wave_read_buffer_t rbuf;
+    double *win[2] = { NULL, NULL };
+    if (corr_plan_init(&plan, frame, ws) < 0) {
+        goto exit;
+    }
+    wave_init_read_buffer(&rbuf, workspace_get(ws, rlen), rlen);
+    for (size_t c = 0; c < nch; c++) {
+        win[c] = workspace_get(ws, sizeof(double) * frame);
+    }
+    double complex *buf = workspace_get(ws, corr_buffer_size(frame));
+
+    if (max_lag > 0) {
+        printf("# time lag_samples lag_seconds coefficient\n");
+    }
+    else {
+        printf("# time frequency clarity\n");
+    }
+
+    /* The same sliding window as the spectra, over each channel. */
+    size_t avail = 0;
+    size_t start = 0;
+    size_t n = 0;
+    while (nframes == 0 || n < nframes) {
+        ssize_t length = wave_rawread(handle, &rbuf);
+        if (length < 0) {
+            goto exit;
+        }
+        if (length == 0) {
+            if (avail > 0 && avail < frame) {
+                correlate_frame(&plan, win, avail, start / sample_rate,
+                                sample_rate, f_lo, f_hi, max_lag, buf);
+            }
+            break;
+        }
 
-    if (table != NULL) {
-        for (size_t i = 0; i < length; i++) {
-            size_t res = 0;
-            for (size_t b = 0; b < exp; b++) {
-                res |= ((i >> b) & 1) << (exp - b - 1);
+        size_t len = length / wave_bsize(handle);
+        if (avail + len > frame) {
+            size_t shift = avail + len - frame;
+            for (size_t c = 0; c < nch; c++) {
+                memmove(win[c], win[c] + shift,
+                        sizeof(double) * (avail - shift));
             }
-            table[i] = res;
+            avail -= shift;
+            start += shift;
+        }
+        for (size_t c = 0; c < nch; c++) {
+            wave_single_channel(handle, &rbuf, win[c] + avail, len, c);
+        }
+        avail += len;
+
+        if (avail == frame || len < hop) {
+            correlate_frame(&plan, win, avail, start / sample_rate,
+                            sample_rate, f_lo, f_hi, max_lag, buf);
+            n++;
+        }
+        if (len < hop) {
+            break;
         }
     }
+    status = EXIT_SUCCESS;
 
-    return table;
+exit:
+    workspace_destroy(ws);
+    return status;
 }
 
-static inline void
-destroy_index_table(size_t *table)
+/**
+ * Convolves every channel of the input with the impulse response and
+ * writes the result, including the tail of the response, as 16-bit PCM.
+ * Channel c is convolved with channel c of the response, or its last one.
+ *
+ * @param handle    the input.
+ * @param ir        the path of the impulse response.
+ * @param block     the samples per partition, i.e. the latency.
+ * @param output    the path of the output, or WAVE_STDOUT.
+ * @return          EXIT_SUCCESS or EXIT_FAILURE.
+ */
+static int
+convolution(wave_handle_t *handle, const char *ir, size_t block,
+            const char *output)
 {
-    free(table);
+    int status = EXIT_FAILURE;
+    wave_handle_t *response = wave_open(ir, O_RDONLY);
+    wave_handle_t *out = NULL;
+    workspace_t *ws = NULL;
+
+    if (response == NULL) {
+        return EXIT_FAILURE;
+    }
+    if (response->unbounded || response->length == 0) {
+        fprintf(stderr, "the impulse response needs a known length\n");
+        goto exit;
+    }
+
+    size_t nch = wave_ch(handle);
+    size_t nir = wave_ch(response);
+    size_t length = response->length / wave_bsize(response);
+    block = (size_t)1 << to_exp(block - 1);
+
+    size_t ilen = response->length;
+    size_t rlen = block * wave_bsize(handle);
+    size_t wsize = workspace_align(ilen)
+                 + workspace_align(sizeof(double) * length)
+                 + nir * workspace_align(sizeof(conv_plan_t))
+                 + nir * conv_plan_size(block, length)
+                 + nch * workspace_align(sizeof(conv_state_t))
+                 + nch * conv_state_size(block, length)
+                 + workspace_align(rlen)
+                 + 2 * workspace_align(sizeof(double) * nch * block);
+    ws = workspace_create(wsize, 0);
+    if (ws == NULL) {
+        goto exit;
+    }
+
+    wave_read_buffer_t rbuf;
+    wave_init_read_buffer(&rbuf, workspace_get(ws, ilen), ilen);
+    double *tmp = workspace_get(ws, sizeof(double) * length);
+    if (wave_rawread(response, &rbuf) < (ssize_t)ilen) {
+        goto exit;
+    }
+
+    conv_plan_t *plans = workspace_get(ws, sizeof(conv_plan_t) * nir);
+    for (size_t c = 0; c < nir; c++) {
+        wave_single_channel(response, &rbuf, tmp, length, c);
+        if (conv_plan_init(&plans[c], block, tmp, length, ws) < 0) {
+            goto exit;
+        }
+    }
+
+    conv_state_t *states = workspace_get(ws, sizeof(conv_state_t) * nch);
+    for (size_t c = 0; c < nch; c++) {
+        if (conv_state_init(&states[c], &plans[c < nir ? c : nir - 1],
+                            ws) < 0) {
+            goto exit;
+        }
+    }
+
+    wave_init_read_buffer(&rbuf, workspace_get(ws, rlen), rlen);
+    double *in = workspace_get(ws, sizeof(double) * nch * block);
+    double *interleaved = workspace_get(ws, sizeof(double) * nch * block);
+
+    out = wave_create(output, wave_sr(handle), nch, BITS_PER_SAMPLE_16);
+    if (out == NULL) {
+        goto exit;
+    }
+
+    /*
+     * The input is followed by silence until the tail of the response has
+     * been written, i.e. length - 1 samples after the last one.
+     */
+    uint64_t total = 0;
+    uint64_t written = 0;
+    int eof = 0;
+    while (!eof || written < total + length - 1) {
+        size_t len = 0;
+        if (!eof) {
+            ssize_t sz = wave_rawread(handle, &rbuf);
+            if (sz < 0) {
+                goto exit;
+            }
+            len = sz / wave_bsize(handle);
+            eof = len < block;
+            total += len;
+        }
+
+        for (size_t c = 0; c < nch; c++) {
+            double *x = in + c * block;
+            if (len > 0) {
+                wave_single_channel(handle, &rbuf, x, len, c);
+            }
+            memset(x + len, 0, sizeof(double) * (block - len));
+            conv_process(&states[c], x, x);
+            for (size_t i = 0; i < block; i++) {
+                interleaved[i * nch + c] = x[i];
+            }
+        }
+
+        uint64_t end = eof ? total + length - 1 : written + block;
+        size_t n = end - written < block ? end - written : block;
+        wave_buffer_t wbuf = { n * nch, interleaved };
+        if (wave_write(out, &wbuf) < 0) {
+            goto exit;
+        }
+        written += n;
+    }
+    status = EXIT_SUCCESS;
+
+exit:
+    if (out != NULL) {
+        wave_close(out);
+    }
+    if (ws != NULL) {
+        workspace_destroy(ws);
+    }
+    wave_close(response);
+    return status;
 }
 
 /**
- * Copies the given samples so that they are aligned for the butterfly
- * calculation.
+ * Writes the envelope and the instantaneous frequency of channel 0, block
+ * by block, in constant memory whatever the length of the input.
  *
- * @param dest  the destination buffer.
- * @param exp   the size of the destination in the power of two.
- * @param src   the original samples.
- * @param count the count of samples.
+ * @param handle    the input.
+ * @param block     the samples per block.
+ * @return          EXIT_SUCCESS or EXIT_FAILURE.
  */
 static int
-copy_and_sort(double complex *dest, size_t exp, double *src, size_t count)
+envelope(wave_handle_t *handle, size_t block)
 {
-    size_t *itable = create_index_table(exp);
-    if (itable == NULL) {
-        return -1;
+    int status = EXIT_FAILURE;
+    size_t rlen = block * wave_bsize(handle);
+    size_t wsize = workspace_align(rlen)
+                 + hilbert_plan_size(block) + hilbert_state_size(block)
+                 + 2 * workspace_align(sizeof(double) * block)
+                 + workspace_align(sizeof(float) * 2 * block);
+    workspace_t *ws = workspace_create(wsize, 0);
+    if (ws == NULL) {
+        return EXIT_FAILURE;
     }
 
-    if ((1 << exp) < count) {
-        count = 1 << exp;
+    hilbert_plan_t plan;
+    hilbert_state_t state;
+    if (hilbert_plan_init(&plan, block, wave_sr(handle), ws) < 0 ||
+        hilbert_state_init(&state, &plan, ws) < 0) {
+        goto exit;
     }
 
-    /* Sort the samples for the butterfly calculation. */
-    for (int i = 0; i < count; i++) {
-        dest[itable[i]] = src[i];
+    wave_read_buffer_t rbuf;
+    wave_init_read_buffer(&rbuf, workspace_get(ws, rlen), rlen);
+    double *in = workspace_get(ws, sizeof(double) * block);
+    double *freq = workspace_get(ws, sizeof(double) * block);
+    float *pairs = workspace_get(ws, sizeof(float) * 2 * block);
+
+    printf("# %zu samples of delay.\n", plan.guard);
+
+    /* The guard after the last block is computed from silence. */
+    int eof = 0;
+    while (!eof || state.written < state.total) {
+        size_t len = 0;
+        if (!eof) {
+            ssize_t sz = wave_rawread(handle, &rbuf);
+            if (sz < 0) {
+                goto exit;
+            }
+            len = sz / wave_bsize(handle);
+            eof = len < block;
+            if (len > 0) {
+                wave_single_channel(handle, &rbuf, in, len, 0);
+            }
+        }
+
+        size_t n = hilbert_process(&state, in, len, in, freq);
+        for (size_t i = 0; i < n; i++) {
+            pairs[2 * i] = (float)in[i];
+            pairs[2 * i + 1] = (float)freq[i];
+        }
+        if (n > 0) {
+            output_envelope(stdout, pairs, n);
+        }
     }
+    status = EXIT_SUCCESS;
 
-    destroy_index_table(itable);
-    return 0;
+exit:
+    workspace_destroy(ws);
+    return status;
 }
 
 /**
- * Fast Fourier Transform.
+ * Writes the cosine transform of channel 0, frame by frame.  The MDCT
+ * frames start a frame before the input and end a frame after it, so that
+ * their inverse reconstructs all of it.
  *
- * @param input         the signal samples aligned in power of 2.
- * @param num_stages    the number of stages.
+ * @param handle    the input.
+ * @param name      the name of the transform.
+ * @param type      the DCT, or -1 for the MDCT.
+ * @param frame     the samples per frame, or the coefficients of the MDCT,
+ *                  rounded up to a power of 2.
+ * @param nframes   the number of frames, 0 for all.
+ * @return          EXIT_SUCCESS or EXIT_FAILURE.
  */
-static inline void
-fft(double complex *input, size_t num_stages)
+static int
+cosine(wave_handle_t *handle, const char *name, int type, size_t frame,
+       size_t nframes)
 {
-    for (size_t s = 1; s <= num_stages; s++) {
-        unsigned int N = 1 << s;        // Unit of batterfly
-        double a = 2.0 * M_PI / (double)N;
-        for (int i = 0; i < (1 << num_stages) / N; i++) {
-            for (int j = 0; j < N / 2; j++) {
-                double real = cos(a * j);
-                double imag = sin(a * j);
-                unsigned int m = i * N + j;
-                unsigned int n = m + N / 2;
-                double complex delta = CMPLX(real, imag) * input[n];
-                input[n] = input[m] - delta;
-                input[m] = input[m] + delta;
+    int status = EXIT_FAILURE;
+    size_t n = frame < 2 ? 2 : (size_t)1 << to_exp(frame - 1);
+    size_t rlen = n * wave_bsize(handle);
+    size_t wsize = workspace_align(rlen)
+                 + mdct_plan_size(n) + mdct_buffer_size(n)
+                 + dct_buffer_size(n)
+                 + workspace_align(sizeof(double) * 3 * n)
+                 + workspace_align(sizeof(float) * n);
+    workspace_t *ws = workspace_create(wsize, 0);
+    if (ws == NULL) {
+        return EXIT_FAILURE;
+    }
+
+    /* The MDCT plan holds the DCT plan of the same size. */
+    mdct_plan_t plan;
+    if (mdct_plan_init(&plan, n, ws) < 0) {
+        goto exit;
+    }
+
+    wave_read_buffer_t rbuf;
+    wave_init_read_buffer(&rbuf, workspace_get(ws, rlen), rlen);
+    void *mbuf = workspace_get(ws, mdct_buffer_size(n));
+    double complex *buf = workspace_get(ws, dct_buffer_size(n));
+    double *x = workspace_get(ws, sizeof(double) * 3 * n);
+    double *y = x + 2 * n;
+    float *coeffs = workspace_get(ws, sizeof(float) * n);
+    memset(x, 0, sizeof(double) * 2 * n);
+
+    /*
+     * An MDCT frame is the previous block and the current one; the last
+     * frame is the last block followed by silence.
+     */
+    size_t count = 0;
+    int eof = 0;
+    while (nframes == 0 || count < nframes) {
+        size_t len = 0;
+        if (!eof) {
+            ssize_t sz = wave_rawread(handle, &rbuf);
+            if (sz < 0) {
+                goto exit;
+            }
+            len = sz / wave_bsize(handle);
+            eof = len < n;
+        }
+        if (len == 0 && (type >= 0 || count == 0)) {
+            break;
+        }
+
+        if (type < 0) {
+            memcpy(x, x + n, sizeof(double) * n);
+            memset(x + n, 0, sizeof(double) * n);
+            if (len > 0) {
+                wave_single_channel(handle, &rbuf, x + n, len, 0);
             }
+            mdct_execute(&plan, x, 1, y, mbuf);
+        }
+        else {
+            wave_single_channel(handle, &rbuf, x, len, 0);
+            memset(x + len, 0, sizeof(double) * (n - len));
+            dct_execute(&plan.dct, type, x, y, buf);
+        }
+
+        for (size_t k = 0; k < n; k++) {
+            coeffs[k] = (float)y[k];
+        }
+        output_coefficients(stdout, name, coeffs, n);
+        count++;
+
+        if (len == 0 || (eof && type >= 0)) {
+            break;
         }
     }
+    status = EXIT_SUCCESS;
+
+exit:
+    workspace_destroy(ws);
+    return status;
 }
 
+/**
+ * Writes the spectra of channel 0, frame by frame.
+ *
+ * @param handle    the input.
+ * @param opts      the transform and the selection of its result.
+ * @param frame     the samples per frame.
+ * @param hop       the samples between frames.
+ * @param nframes   the number of frames, 0 for all.
+ * @param depth     the number of blocks read ahead.
+ * @param stats     whether to write per-stage statistics to stderr.
+ * @return          EXIT_SUCCESS or EXIT_FAILURE.
+ */
 static int
-do_fft(double *samples, size_t count)
+spectrum(wave_handle_t *handle, const analysis_options_t *opts, size_t frame,
+         size_t hop, size_t nframes, size_t depth, int stats)
 {
+    /* Both consume each block exactly once. */
+    if (hop != frame && (opts->fixed || opts->rate > 0)) {
+        fprintf(stderr, "unsupported combination of options\n");
+        return EXIT_FAILURE;
+    }
+
     /*
-     * Expand and align the buffer size to power of 2, which is the
-     * precondition of FFT.
+     * Everything the transform needs is carved out of a single workspace
+     * up front, so that reading and transforming a block allocates
+     * nothing.
      */
-    size_t exp = to_exp(count - 1);
-    size_t exp_len = 1 << exp;
+    size_t rlen = hop * wave_bsize(handle);
+    size_t asize = analysis_size(opts, frame, wave_sr(handle));
+    if (asize == 0) {
+        fprintf(stderr, "unsupported combination of options\n");
+        return EXIT_FAILURE;
+    }
+    size_t wsize = wave_reader_size(rlen, depth)
+                 + workspace_align(sizeof(double) * frame)
+                 + asize;
+
+    workspace_t *ws = workspace_create(wsize, WORKSPACE_HUGEPAGE);
+    if (ws == NULL) {
+        return EXIT_FAILURE;
+    }
+
+    wave_reader_t reader;
+    analysis_t analysis;
+    double *tmp = workspace_get(ws, sizeof(double) * frame);
 
-    double complex *buf = calloc(exp_len, sizeof(double complex));
-    if (buf == NULL) {
-        return -1;
+    if (analysis_init(&analysis, opts, frame, wave_sr(handle), ws) < 0 ||
+        wave_reader_start(&reader, handle, rlen, depth, ws) < 0) {
+        workspace_destroy(ws);
+        return EXIT_FAILURE;
     }
 
-    if (copy_and_sort(buf, exp, samples, count) < 0) {
-        free(buf);
-        return -1;
+    if (stats && stats_enable(STATS_FRAMES) < 0) {
+        wave_reader_stop(&reader);
+        workspace_destroy(ws);
+        return EXIT_FAILURE;
     }
 
-    fft(buf, exp);
+    /*
+     * The window holds the last avail samples.  Every block of hop samples
+     * slides it; a frame is transformed as soon as the window is full, so
+     * the latency is bounded by the hop.  A short block marks the end of
+     * the stream and flushes what is left.
+     */
+    /*
+     * Frames which do not overlap are loaded straight from the raw PCM,
+     * skipping the window of samples.
+     */
+    int pcm = hop == frame && analysis_accepts_pcm(&analysis);
+
+    /* A stream or a pipe is flushed frame by frame, even with a length. */
+    int live = handle->unbounded || handle->data_offset < 0;
+
+    int status = EXIT_SUCCESS;
+    size_t avail = 0;
+    size_t n = 0;
+    while (nframes == 0 || n < nframes) {
+        wave_read_buffer_t *rbuf;
+        uint64_t t0 = stats_begin();
+        ssize_t length = wave_reader_next(&reader, &rbuf);
+        stats_end(STATS_READ, t0);
+        if (length < 0) {
+            status = EXIT_FAILURE;
+            break;
+        }
+        if (length == 0) {
+            /* The window has never been full; flush it. */
+            if (avail > 0 && avail < frame) {
+                analysis_run(&analysis, tmp, avail, stdout);
+                stats_frame();
+            }
+            break;
+        }
+        size_t len = length / wave_bsize(handle);
+        output_block(stdout, &opts->output, length, len);
+        STATS_ADD(bytes_read, length);
+        STATS_ADD(samples_decoded, len);
+
+        if (pcm) {
+            int ret = analysis_run_pcm(&analysis, handle, rbuf, len,
+                                       SPECTRUM_CHANNEL, stdout);
+            wave_reader_release(&reader);
+            if (ret < 0) {
+                status = EXIT_FAILURE;
+                break;
+            }
+            stats_frame();
+            n++;
+            if (live) {
+                fflush(stdout);
+            }
+            if (len < hop) {
+                break;
+            }
+            continue;
+        }
 
-    double res = (double)count / (double)exp_len;
-    /* Output only the left channel */
-    for (int i = 0; i < count / 2; i++) {
-        printf("%f %f %f 0 0\n", res * i, cabs(buf[i]), carg(buf[i]));
+        t0 = stats_begin();
+        if (avail + len > frame) {
+            size_t shift = avail + len - frame;
+            memmove(tmp, tmp + shift, sizeof(double) * (avail - shift));
+            avail -= shift;
+        }
+        wave_single_channel(handle, rbuf, tmp + avail, len,
+                            SPECTRUM_CHANNEL);
+        wave_reader_release(&reader);
+        avail += len;
+        stats_end(STATS_DECODE, t0);
+
+        if (avail == frame || len < hop) {
+            analysis_run(&analysis, tmp, avail, stdout);
+            stats_frame();
+            n++;
+            if (live) {
+                fflush(stdout);
+            }
+        }
+        if (len < hop) {
+            break;
+        }
+    }
+
+    if (stats) {
+        fflush(stdout);
+        stats_report(stderr);
+        stats_disable();
     }
 
-    free(buf);
+    wave_reader_stop(&reader);
+    workspace_destroy(ws);
 
-    return 0;
+    return status;
 }
 
-static void
-dump(wave_handle_t *h)
+/**
+ * Writes every channel of the input as float32, decoded on several threads
+ * a window of frames at a time.
+ *
+ * @param handle    the input, a regular file.
+ * @param nthreads  the number of workers, 0 for the number of CPUs.
+ * @return          EXIT_SUCCESS or EXIT_FAILURE.
+ */
+static int
+decode(wave_handle_t *handle, size_t nthreads)
 {
-    printf("# length %u\n", h->length);
-    printf("# num_channels %u\n", h->num_channels);
-    printf("# sample_rate %u\n", h->sample_rate);
-    printf("# byte_rate %u\n", h->byte_rate);
-    printf("# block_size %u\n", h->block_size);
-    printf("# bits_per_sample %u\n", h->bits_per_sample);
+    uint64_t total = wave_decode_frames(handle);
+    if (total == 0) {
+        fprintf(stderr, "cannot decode the input in parallel\n");
+        return EXIT_FAILURE;
+    }
+
+    int status = EXIT_FAILURE;
+    size_t nch = wave_ch(handle);
+    size_t window = total < DECODE_WINDOW ? total : DECODE_WINDOW;
+    float **planes = calloc(nch, sizeof(float *));
+    if (planes == NULL) {
+        return EXIT_FAILURE;
+    }
+    for (size_t c = 0; c < nch; c++) {
+        planes[c] = malloc(sizeof(float) * window);
+        if (planes[c] == NULL) {
+            goto exit;
+        }
+    }
+
+    for (uint64_t first = 0; first < total; first += window) {
+        ssize_t n = wave_decode(handle, first, window, planes, nthreads);
+        if (n < 0) {
+            goto exit;
+        }
+        if (n > 0) {
+            output_planes(stdout, planes, nch, n);
+        }
+        if ((size_t)n < window) {
+            break;
+        }
+    }
+    status = EXIT_SUCCESS;
+
+exit:
+    for (size_t c = 0; c < nch; c++) {
+        free(planes[c]);
+    }
+    free(planes);
+    return status;
+}
+
+/**
+ * Finds the files of the index the input has been taken from, and where.
+ *
+ * @param handle    the input.
+ * @param path      the path of the index.
+ * @param k         the number of matches.
+ * @return          EXIT_SUCCESS or EXIT_FAILURE.
+ */
+static int
+identify(wave_handle_t *handle, const char *path, size_t k)
+{
+    int status = EXIT_FAILURE;
+    fp_index_t index;
+    fp_list_t list = { NULL, 0, 0 };
+    fp_match_t *matches = calloc(k > 0 ? k : 1, sizeof(fp_match_t));
+
+    if (matches == NULL) {
+        return EXIT_FAILURE;
+    }
+    if (fp_index_open(&index, path) < 0) {
+        fprintf(stderr, "cannot read the index %s\n", path);
+        free(matches);
+        return EXIT_FAILURE;
+    }
+    if (fp_extract(handle, &list) < 0) {
+        goto exit;
+    }
+
+    ssize_t n = fp_index_query(&index, list.hashes, list.count, matches, k);
+    if (n < 0) {
+        goto exit;
+    }
+    printf("# %zu landmarks\n", list.count);
+    printf("# score offset path\n");
+    for (ssize_t i = 0; i < n; i++) {
+        printf("%u %f %s\n", matches[i].score,
+               matches[i].offset * (double)FP_HOP / FP_RATE,
+               fp_index_path(&index, matches[i].file));
+    }
+    status = EXIT_SUCCESS;
+
+exit:
+    fp_list_free(&list);
+    fp_index_close(&index);
+    free(matches);
+    return status;
 }
 
 int
 main(int argc, char *argv[])
 {
-    if (argc < 2) {
+    size_t depth = 1;
+    size_t nframes = 1;
+    size_t nthreads = 0;
+    size_t frame = 0;
+    size_t hop = 0;
+    unsigned int raw_rate = 0;
+    unsigned int raw_channels = 1;
+    unsigned int raw_bits = BITS_PER_SAMPLE_16;
+    int stats = 0;
+    int follow = 0;
+    int planes = 0;
+    int analytic = 0;
+    const char *cosine_name = NULL;
+    int cosine_type = -1;
+    const char *batch = NULL;
+    const char *output = NULL;
+    const char *scratch = NULL;
+    const char *ir = NULL;
+    const char *cache_dir = NULL;
+    const char *fp_index = NULL;
+    size_t cache_budget = CACHE_BUDGET;
+    size_t memory = OOC_MEMORY;
+    double pitch_lo = 0.0;
+    double pitch_hi = 0.0;
+    double delay = 0.0;
+    analysis_options_t opts = { { 0, 0.0, 0, 0, 0 }, 0, 0.0, 0.0, 0, 0,
+                                WINDOW_NONE, 0, SPARSE_TOLERANCE };
+    int window;
+    int opt;
+    static const struct option longopts[] = {
+        { "follow", no_argument, NULL, 'f' },
+        { NULL, 0, NULL, 0 }
+    };
+
+    while ((opt = getopt_long(argc, argv, "C:D:EF:H:I:M:O:P:R:ST:ab:c:d"
+                                          "fj:k:m:n:o:qr:s:t:w:z:", longopts,
+                              NULL)) != -1) {
+        switch (opt) {
+        case 'C':
+            ir = optarg;
+            break;
+        case 'D':
+            delay = strtod(optarg, NULL);
+            if (delay <= 0.0) {
+                usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'E':
+            analytic = 1;
+            break;
+        case 'F':
+            frame = strtoul(optarg, NULL, 0);
+            break;
+        case 'H':
+            hop = strtoul(optarg, NULL, 0);
+            break;
+        case 'I':
+            fp_index = optarg;
+            break;
+        case 'M':
+            memory = strtoul(optarg, NULL, 0) << 20;
+            break;
+        case 'O':
+            scratch = optarg;
+            break;
+        case 'P':
+            if (sscanf(optarg, "%lf:%lf", &pitch_lo, &pitch_hi) != 2 ||
+                pitch_lo <= 0.0 || pitch_hi < pitch_lo) {
+                usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'R':
+            if (sscanf(optarg, "%u:%u:%u", &raw_rate, &raw_channels,
+                       &raw_bits) < 1 || raw_rate == 0) {
+                usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'S':
+            stats = 1;
+            break;
+        case 'T':
+            cosine_name = optarg;
+            if (strcmp(optarg, "mdct") != 0 &&
+                (cosine_type = dct_parse(optarg)) < 0) {
+                usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'a':
+            depth = WAVE_READER_DEPTH;
+            break;
+        case 'b':
+            batch = optarg;
+            break;
+        case 'c':
+            cache_dir = optarg;
+            char *budget = strchr(optarg, ':');
+            if (budget != NULL) {
+                *budget = '\0';
+                cache_budget = strtoul(budget + 1, NULL, 0) << 20;
+            }
+            break;
+        case 'd':
+            planes = 1;
+            break;
+        case 'f':
+            follow = 1;
+            break;
+        case 'j':
+            nthreads = strtoul(optarg, NULL, 0);
+            break;
+        case 'k':
+            opts.output.peaks = strtoul(optarg, NULL, 0);
+            break;
+        case 'm':
+            if (sscanf(optarg, "%zu:%zu", &opts.output.mels,
+                       &opts.output.coeffs) != 2 ||
+                opts.output.mels == 0 || opts.output.mels > MEL_MAX ||
+                opts.output.coeffs == 0 ||
+                opts.output.coeffs > opts.output.mels) {
+                usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'n':
+            nframes = strtoul(optarg, NULL, 0);
+            break;
+        case 'o':
+            output = optarg;
+            break;
+        case 'q':
+            opts.fixed = 1;
+            break;
+        case 'r':
+            opts.rate = strtoul(optarg, NULL, 0);
+            break;
+        case 's':
+            if (sscanf(optarg, "%zu:%lf", &opts.sparse,
+                       &opts.sparse_tolerance) < 1 ||
+                opts.sparse == 0 || opts.sparse_tolerance <= 0.0) {
+                usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 't':
+            opts.output.threshold = strtod(optarg, NULL);
+            break;
+        case 'w':
+            if ((window = window_parse(optarg)) < 0) {
+                usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            opts.window = window;
+            break;
+        case 'z':
+            if (sscanf(optarg, "%lf:%lf:%zu", &opts.zoom_lo, &opts.zoom_hi,
+                       &opts.zoom_bins) != 3 || opts.zoom_bins == 0) {
+                usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            break;
+        default:
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (batch != NULL && fp_index != NULL) {
+        return fp_index_build(batch, fp_index, nthreads) < 0 ? EXIT_FAILURE
+                                                             : EXIT_SUCCESS;
+    }
+
+    if (batch != NULL) {
+        if (opts.zoom_bins > 0 || opts.rate > 0 || opts.fixed || stats ||
+            scratch != NULL || pitch_hi > 0.0 || delay > 0.0 ||
+            opts.sparse > 0 || ir != NULL || analytic ||
+            cosine_name != NULL || cache_dir != NULL || follow || planes ||
+            frame > 0 || hop > 0 || raw_rate > 0 || depth > 1) {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+        FILE *out = output != NULL ? fopen(output, "w") : stdout;
+        if (out == NULL) {
+            return EXIT_FAILURE;
+        }
+        int ret = batch_run(batch, out, nthreads, nframes, opts.window,
+                            &opts.output);
+        if (out != stdout) {
+            fclose(out);
+        }
+        return ret < 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
+    if (optind >= argc) {
+        usage(argv[0]);
         return EXIT_FAILURE;
     }
 
+    /*
+     * Only the spectra are cached, and a hit is served before the input is
+     * even opened.
+     */
+    char key[CACHE_KEY_MAX];
+    cache_entry_t entry;
+    int cached = 0;
+    if (cache_dir != NULL && !stats && ir == NULL && !analytic &&
+        cosine_name == NULL && fp_index == NULL && scratch == NULL &&
+        pitch_hi == 0.0 && delay == 0.0 && !follow && !planes) {
+        char params[CACHE_KEY_MAX];
+        snprintf(params, sizeof(params),
+                 "%u:%u:%u:%d:%zu:%zu:%zu:%zu:%.17g:%zu:%zu:%.17g:%.17g:%zu:"
+                 "%zu:%d:%d:%zu:%.17g", raw_rate, raw_channels, raw_bits,
+                 SPECTRUM_CHANNEL, frame, hop, nframes, opts.output.peaks,
+                 opts.output.threshold, opts.output.mels, opts.output.coeffs,
+                 opts.zoom_lo, opts.zoom_hi, opts.zoom_bins, opts.rate,
+                 opts.fixed, (int)opts.window, opts.sparse,
+                 opts.sparse_tolerance);
+        if (cache_key(key, argv[optind], params) == 0) {
+            int hit = cache_lookup(cache_dir, key, stdout);
+            if (hit != 0) {
+                return hit > 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+            }
+            cached = 1;
+        }
+    }
+
     wave_handle_t *handle;
-    handle = wave_open(argv[1], O_RDONLY);
+    if (raw_rate > 0) {
+        handle = wave_open_raw(argv[optind], raw_rate, raw_channels,
+                               raw_bits);
+    }
+    else {
+        handle = wave_open(argv[optind], O_RDONLY);
+    }
     if (handle == NULL) {
         return EXIT_FAILURE;
     }
+    if (follow && wave_follow(handle, argv[optind]) < 0) {
+        fprintf(stderr, "cannot follow %s\n", argv[optind]);
+        wave_close(handle);
+        return EXIT_FAILURE;
+    }
 
-    dump(handle);
+    if (ir != NULL) {
+        int status = EXIT_FAILURE;
+        if (scratch != NULL || pitch_hi > 0.0 || delay > 0.0 || hop > 0 ||
+            opts.fixed || opts.rate > 0 || opts.zoom_bins > 0 ||
+            opts.output.peaks > 0 || opts.output.mels > 0 ||
+            opts.window != WINDOW_NONE || opts.sparse > 0 || analytic ||
+            cosine_name != NULL) {
+            fprintf(stderr, "unsupported combination of options\n");
+        }
+        else {
+            status = convolution(handle, ir, frame > 0 ? frame : CONV_BLOCK,
+                                 output != NULL ? output : WAVE_STDOUT);
+        }
+        wave_close(handle);
+        return status;
+    }
 
-    wave_read_buffer_t *rbuf = wave_alloc_read_buffer(handle, 1);
+    if (fp_index != NULL) {
+        int status = EXIT_FAILURE;
+        if (scratch != NULL || pitch_hi > 0.0 || delay > 0.0 || hop > 0 ||
+            frame > 0 || opts.fixed || opts.rate > 0 ||
+            opts.zoom_bins > 0 || opts.output.mels > 0 ||
+            opts.window != WINDOW_NONE || opts.sparse > 0 || analytic ||
+            cosine_name != NULL || stats || follow || planes) {
+            fprintf(stderr, "unsupported combination of options\n");
+        }
+        else {
+            status = identify(handle, fp_index,
+                              opts.output.peaks > 0 ? opts.output.peaks
+                                                    : FP_MATCHES);
+        }
+        wave_close(handle);
+        return status;
+    }
 
-    ssize_t length = wave_rawread(handle, rbuf);
-    printf("# %zd samples read.\n", length);
+    if (cached && cache_begin(&entry, cache_dir, cache_budget, key) < 0) {
+        cached = 0;
+    }
+    opts.output.binary = cached;
+    output_header(stdout, &opts.output, handle);
 
-    size_t len = length / wave_bsize(handle);
-    double *tmp = calloc(len, sizeof(double));
-    printf("# %zu samples to be processed.\n", len);
+    if (planes) {
+        int status = EXIT_FAILURE;
+        if (scratch != NULL || pitch_hi > 0.0 || delay > 0.0 || hop > 0 ||
+            frame > 0 || opts.fixed || opts.rate > 0 ||
+            opts.zoom_bins > 0 || opts.output.peaks > 0 ||
+            opts.output.mels > 0 || opts.window != WINDOW_NONE ||
+            opts.sparse > 0 || analytic || cosine_name != NULL || follow) {
+            fprintf(stderr, "unsupported combination of options\n");
+        }
+        else {
+            status = decode(handle, nthreads);
+        }
+        wave_close(handle);
+        return status;
+    }
 
-    wave_single_channel(handle, rbuf, tmp, len, 0);
+    if (analytic) {
+        int status = EXIT_FAILURE;
+        if (scratch != NULL || pitch_hi > 0.0 || delay > 0.0 || hop > 0 ||
+            opts.fixed || opts.rate > 0 || opts.zoom_bins > 0 ||
+            opts.output.peaks > 0 || opts.output.mels > 0 ||
+            opts.window != WINDOW_NONE || opts.sparse > 0 ||
+            cosine_name != NULL) {
+            fprintf(stderr, "unsupported combination of options\n");
+        }
+        else {
+            status = envelope(handle, frame > 0 ? frame : HILBERT_BLOCK);
+        }
+        wave_close(handle);
+        return status;
+    }
 
-    do_fft(tmp, len);
+    if (cosine_name != NULL) {
+        int status = EXIT_FAILURE;
+        if (scratch != NULL || pitch_hi > 0.0 || delay > 0.0 || hop > 0 ||
+            opts.fixed || opts.rate > 0 || opts.zoom_bins > 0 ||
+            opts.output.peaks > 0 || opts.output.mels > 0 ||
+            opts.window != WINDOW_NONE || opts.sparse > 0) {
+            fprintf(stderr, "unsupported combination of options\n");
+        }
+        else {
+            status = cosine(handle, cosine_name, cosine_type,
+                            frame > 0 ? frame : wave_sr(handle), nframes);
+        }
+        wave_close(handle);
+        return status;
+    }
 
-    free(tmp);
-    wave_free_read_buffer(rbuf);
-    wave_close(handle);
+    if (frame == 0) {
+        frame = wave_sr(handle);
+    }
+    if (hop == 0 || hop > frame) {
+        hop = frame;
+    }
+    if (pitch_hi > 0.0 || delay > 0.0) {
+        int status = EXIT_FAILURE;
+        if ((pitch_hi > 0.0 && delay > 0.0) || scratch != NULL ||
+            opts.fixed || opts.rate > 0 || opts.zoom_bins > 0 ||
+            opts.output.peaks > 0 || opts.sparse > 0) {
+            fprintf(stderr, "unsupported combination of options\n");
+        }
+        else {
+            status = correlation(handle, frame, hop, nframes, pitch_lo,
+                                 pitch_hi, delay);
+        }
+        wave_close(handle);
+        return status;
+    }
 
-    return EXIT_SUCCESS;
-}
+    if (scratch != NULL) {
+        if (hop != frame || opts.fixed || opts.rate > 0 ||
+            opts.zoom_bins > 0 || opts.sparse > 0) {
+            fprintf(stderr, "unsupported combination of options\n");
+            wave_close(handle);
+            return EXIT_FAILURE;
+        }
+        if (stats && stats_enable(1) < 0) {
+            wave_close(handle);
+            return EXIT_FAILURE;
+        }
+        int status = out_of_core(handle, frame, scratch, memory,
+                                 &opts.output);
+        if (stats) {
+            fflush(stdout);
+            stats_report(stderr);
+            stats_disable();
+        }
+        wave_close(handle);
+        return status;
+    }
 
+    int status = spectrum(handle, &opts, frame, hop, nframes, depth, stats);
+    if (cached && cache_commit(&entry, status == EXIT_SUCCESS) < 0) {
+        status = EXIT_FAILURE;
+    }
+    wave_close(handle);
+    return status;
+}
@@ -0,0 +1,222 @@
+/**
+ * Landmark fingerprints
+ */
+
+#include <string.h>
+#include <complex.h>
+#include "fingerprint.h"
+#include "peaks.h"
+#include "resample.h"
+#include "transform.h"
+#include "window.h"
+#include "workspace.h"
+
+/*
+ * The peaks of a frame and the number of targets paired with each.
+ */
+typedef struct fp_frame
+{
+    size_t count;
+    uint32_t bin[FP_PEAKS];
+    size_t fanout[FP_PEAKS];
+} fp_frame_t;
+
+typedef struct fp_extractor
+{
+    fft_plan_t plan;
+    double *window;
+    double *frame;
+    double complex *buf;
+
+    /*
+     * The number of samples in the frame and the index of the next one.
+     */
+    size_t fill;
+    size_t time;
+
+    /*
+     * The frames of the target zone, the current one included.
+     */
+    fp_frame_t ring[FP_ZONE + 1];
+} fp_extractor_t;
+
+static int
+list_add(fp_list_t *list, uint32_t hash, uint32_t time)
+{
+    if (list->count == list->capacity) {
+        size_t capacity = list->capacity > 0 ? list->capacity * 2 : 4096;
+        fp_hash_t *hashes = realloc(list->hashes,
+                                    sizeof(fp_hash_t) * capacity);
+        if (hashes == NULL) {
+            return -1;
+        }
+        list->hashes = hashes;
+        list->capacity = capacity;
+    }
+
+    list->hashes[list->count].hash = hash;
+    list->hashes[list->count].time = time;
+    list->count++;
+
+    return 0;
+}
+
+void
+fp_list_free(fp_list_t *list)
+{
+    free(list->hashes);
+    list->hashes = NULL;
+    list->count = 0;
+    list->capacity = 0;
+}
+
+/*
+ * Picks the peaks of the full frame and pairs them with the anchors of
+ * the previous frames.
+ */
+static int
+process_frame(fp_extractor_t *fp, fp_list_t *list)
+{
+    peak_t peaks[FP_PEAKS];
+    size_t t = fp->time++;
+    fp_frame_t *cur = &fp->ring[t % (FP_ZONE + 1)];
+
+    fft_execute_window(&fp->plan, fp->frame, fp->window, FP_FRAME, fp->buf);
+    cur->count = find_peaks(fp->buf, FP_FRAME / 2, FP_THRESHOLD, peaks,
+                            FP_PEAKS);
+    for (size_t i = 0; i < cur->count; i++) {
+        cur->bin[i] = (uint32_t)(peaks[i].bin + 0.5);
+        cur->fanout[i] = 0;
+    }
+
+    /* The anchors meet their targets nearest first. */
+    for (size_t dt = 1; dt <= FP_ZONE && dt <= t; dt++) {
+        fp_frame_t *a = &fp->ring[(t - dt) % (FP_ZONE + 1)];
+        for (size_t i = 0; i < a->count; i++) {
+            for (size_t j = 0; j < cur->count && a->fanout[i] < FP_FANOUT;
+                 j++) {
+                uint32_t f1 = a->bin[i];
+                uint32_t f2 = cur->bin[j];
+                if ((f1 > f2 ? f1 - f2 : f2 - f1) > FP_SPAN) {
+                    continue;
+                }
+                uint32_t hash = (f1 << (FP_BIN_BITS + FP_DT_BITS))
+                              | (f2 << FP_DT_BITS) | (uint32_t)dt;
+                if (list_add(list, hash, (uint32_t)(t - dt)) < 0) {
+                    return -1;
+                }
+                a->fanout[i]++;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * Slides the samples through the frames.
+ */
+static int
+push(fp_extractor_t *fp, const double *x, size_t count, fp_list_t *list)
+{
+    while (count > 0) {
+        size_t n = FP_FRAME - fp->fill;
+        if (n > count) {
+            n = count;
+        }
+        memcpy(fp->frame + fp->fill, x, sizeof(double) * n);
+        fp->fill += n;
+        x += n;
+        count -= n;
+
+        if (fp->fill == FP_FRAME) {
+            if (process_frame(fp, list) < 0) {
+                return -1;
+            }
+            memmove(fp->frame, fp->frame + FP_HOP,
+                    sizeof(double) * (FP_FRAME - FP_HOP));
+            fp->fill = FP_FRAME - FP_HOP;
+        }
+    }
+
+    return 0;
+}
+
+int
+fp_extract(wave_handle_t *handle, fp_list_t *list)
+{
+    int ret = -1;
+    size_t rate = wave_sr(handle);
+    size_t rlen = wave_read_buffer_size(handle, 1);
+    size_t block = rlen / wave_bsize(handle);
+    int resample = rate != FP_RATE;
+    size_t rsize = resample ? resampler_size(rate, FP_RATE, block) : 0;
+    size_t outlen = resample ? resampler_max_output(rate, FP_RATE, block) : 0;
+    if (resample && rsize == 0) {
+        return -1;
+    }
+
+    size_t wsize = workspace_align(rlen)
+                 + workspace_align(sizeof(double) * block)
+                 + rsize + workspace_align(sizeof(double) * outlen)
+                 + fft_plan_size(FP_FRAME) + fft_buffer_size(FP_FRAME)
+                 + 2 * workspace_align(sizeof(double) * FP_FRAME)
+                 + workspace_align(sizeof(fp_extractor_t));
+    workspace_t *ws = workspace_create(wsize, 0);
+    if (ws == NULL) {
+        return -1;
+    }
+
+    wave_read_buffer_t rbuf;
+    resampler_t resampler;
+    wave_init_read_buffer(&rbuf, workspace_get(ws, rlen), rlen);
+    double *in = workspace_get(ws, sizeof(double) * block);
+    double *out = NULL;
+    if (resample) {
+        if (resampler_init(&resampler, rate, FP_RATE, block, ws) < 0) {
+            goto exit;
+        }
+        out = workspace_get(ws, sizeof(double) * outlen);
+    }
+
+    fp_extractor_t *fp = workspace_get(ws, sizeof(fp_extractor_t));
+    if (fp == NULL || fft_plan_init(&fp->plan, FP_FRAME, ws) < 0) {
+        goto exit;
+    }
+    fp->window = workspace_get(ws, sizeof(double) * FP_FRAME);
+    fp->frame = workspace_get(ws, sizeof(double) * FP_FRAME);
+    fp->buf = workspace_get(ws, fft_buffer_size(FP_FRAME));
+    if (fp->buf == NULL) {
+        goto exit;
+    }
+    window_init(fp->window, WINDOW_HANN, FP_FRAME);
+    fp->fill = 0;
+    fp->time = 0;
+
+    for (;;) {
+        ssize_t length = wave_rawread(handle, &rbuf);
+        if (length < 0) {
+            goto exit;
+        }
+        if (length == 0) {
+            break;
+        }
+
+        size_t len = length / wave_bsize(handle);
+        wave_single_channel(handle, &rbuf, in, len, 0);
+        int r = resample
+              ? push(fp, out, resampler_run(&resampler, in, len, out), list)
+              : push(fp, in, len, list);
+        if (r < 0) {
+            goto exit;
+        }
+        if (len < block) {
+            break;
+        }
+    }
+    ret = 0;
+
+exit:
+    workspace_destroy(ws);
+    return ret;
+}
@@ -0,0 +1,87 @@
+#ifndef FOURIER_FINGERPRINT_H
+#define FOURIER_FINGERPRINT_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include "wave.h"
+
+/**
+ * The rate the signal is resampled to, so that the files of any rate
+ * share their hashes.
+ */
+#define FP_RATE         11025
+
+/**
+ * The samples per frame and between frames at FP_RATE.
+ */
+#define FP_FRAME        1024
+#define FP_HOP          512
+
+/**
+ * The number of peaks picked from each frame.
+ */
+#define FP_PEAKS        5
+
+/**
+ * The minimum magnitude of a peak, about -50 dB of a full-scale sine.
+ */
+#define FP_THRESHOLD    1.0
+
+/**
+ * The target zone of an anchor: the FP_ZONE frames after it, within
+ * FP_SPAN bins of it, of which the FP_FANOUT nearest peaks are paired with
+ * the anchor.
+ */
+#define FP_ZONE         32
+#define FP_SPAN         96
+#define FP_FANOUT       5
+
+/**
+ * The bits of a hash: the bin of the anchor, the bin of the target and
+ * the frames between them.
+ */
+#define FP_BIN_BITS     9
+#define FP_DT_BITS      6
+#define FP_HASH_BITS    (2 * FP_BIN_BITS + FP_DT_BITS)
+
+/**
+ * A landmark: a pair of peaks and the frame of the first one.
+ */
+typedef struct fp_hash
+{
+    uint32_t hash;
+    uint32_t time;
+} fp_hash_t;
+
+/**
+ * A growing array of landmarks.
+ */
+typedef struct fp_list
+{
+    fp_hash_t *hashes;
+    size_t count;
+    size_t capacity;
+} fp_list_t;
+
+/**
+ * Extracts the landmarks of channel 0.
+ *
+ * The signal is resampled to FP_RATE and cut into Hann-windowed frames,
+ * of which the FP_PEAKS strongest spectral peaks make the constellation.
+ * Every peak is the anchor of the peaks in its target zone; each pair is
+ * hashed from both bins and their distance in frames, which does not
+ * depend on where the clip starts, and stamped with the frame of the
+ * anchor.  The file is streamed block by block.
+ *
+ * @param handle    the input.
+ * @param list      the list the landmarks are appended to.
+ * @return          0 on success, -1 on failure.
+ */
+int fp_extract(wave_handle_t *handle, fp_list_t *list);
+
+/**
+ * Releases the landmarks of a list.
+ */
+void fp_list_free(fp_list_t *list);
+
+#endif /* FOURIER_FINGERPRINT_H */
@@ -0,0 +1,187 @@
+/**
+ * Fixed-point Fast Fourier Transform
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+#include <complex.h>
+#include "fixed.h"
+#include "stats.h"
+
+/*
+ * A butterfly can grow a component by 1 + sqrt(2), so the block is halved
+ * as soon as a component may exceed INT32_MAX / (1 + sqrt(2)).
+ */
+#define FIXED_LIMIT     (1 << 29)
+
+size_t
+fixed_plan_size(size_t count)
+{
+    size_t length = (size_t)1 << to_exp(count - 1);
+    return fft_plan_size(count)
+         + workspace_align(sizeof(int16_t) * length);
+}
+
+size_t
+fixed_buffer_size(size_t count)
+{
+    size_t length = (size_t)1 << to_exp(count - 1);
+    return workspace_align(sizeof(int32_t) * 2 * length);
+}
+
+int
+fixed_plan_init(fixed_plan_t *plan, size_t count, workspace_t *ws)
+{
+    if (fft_plan_init(&plan->fft, count, ws) < 0) {
+        return -1;
+    }
+
+    size_t half = plan->fft.length / 2;
+    plan->twiddle = workspace_get(ws, sizeof(int16_t) * 2 * half);
+    if (plan->twiddle == NULL) {
+        return -1;
+    }
+
+    for (size_t j = 0; j < half; j++) {
+        double a = 2.0 * M_PI * (double)j / (double)plan->fft.length;
+        plan->twiddle[2 * j] = (int16_t)lrint(fmin(cos(a) * 32768.0, 32767.0));
+        plan->twiddle[2 * j + 1] = (int16_t)lrint(fmin(sin(a) * 32768.0,
+                                                       32767.0));
+    }
+
+    return 0;
+}
+
+static int
+load(const fixed_plan_t *plan, wave_handle_t *h, const wave_read_buffer_t *rbuf,
+     size_t count, unsigned int ch, int32_t *buf)
+{
+    const size_t *itable = plan->fft.itable;
+    size_t length = plan->fft.length;
+    size_t nch = h->num_channels;
+
+    if (!(ch < nch)) {
+        return -1;
+    }
+    if (rbuf->length / h->block_size < count) {
+        count = rbuf->length / h->block_size;
+    }
+    if (length < count) {
+        count = length;
+    }
+
+    if (h->bits_per_sample == BITS_PER_SAMPLE_16) {
+        const int16_t *ptr = (const int16_t *)rbuf->body + ch;
+        for (size_t i = 0; i < count; i++) {
+            size_t j = itable[i];
+            buf[2 * j] = (int32_t)ptr[i * nch] * (1 << FIXED_INPUT_SHIFT);
+            buf[2 * j + 1] = 0;
+        }
+    }
+    else if (h->bits_per_sample == BITS_PER_SAMPLE_8) {
+        /* The 8-bit samples are unsigned; widen them to the 16-bit scale. */
+        const uint8_t *ptr = rbuf->body + ch;
+        for (size_t i = 0; i < count; i++) {
+            size_t j = itable[i];
+            buf[2 * j] = ((int32_t)ptr[i * nch] - 128)
+                       * (1 << (FIXED_INPUT_SHIFT + 8));
+            buf[2 * j + 1] = 0;
+        }
+    }
+    else {
+        return -1;
+    }
+
+    for (size_t i = count; i < length; i++) {
+        size_t j = itable[i];
+        buf[2 * j] = 0;
+        buf[2 * j + 1] = 0;
+    }
+
+    return 0;
+}
+
+static int32_t
+peak(const int32_t *buf, size_t n)
+{
+    int32_t max = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        int32_t v = buf[i] < 0 ? -buf[i] : buf[i];
+        max = v > max ? v : max;
+    }
+    return max;
+}
+
+int
+fixed_execute(const fixed_plan_t *plan, wave_handle_t *h,
+              const wave_read_buffer_t *rbuf, size_t count, unsigned int ch,
+              int32_t *buf)
+{
+    size_t length = plan->fft.length;
+    const int16_t *tw = plan->twiddle;
+    int exp = 0;
+
+    uint64_t t0 = stats_begin();
+    if (load(plan, h, rbuf, count, ch, buf) < 0) {
+        return -1;
+    }
+    stats_end(STATS_SORT, t0);
+
+    t0 = stats_begin();
+
+    for (size_t s = 1; s <= plan->fft.exp; s++) {
+        size_t N = (size_t)1 << s;
+        size_t step = length / N;
+        int shift = 0;
+
+        /* The inputs of the stage are halved on the fly if needed. */
+        if (peak(buf, 2 * length) >= FIXED_LIMIT) {
+            shift = 1;
+            exp++;
+        }
+
+        for (size_t i = 0; i < length; i += N) {
+            for (size_t j = 0; j < N / 2; j++) {
+                int32_t *m = buf + 2 * (i + j);
+                int32_t *n = m + N;
+                int64_t wr = tw[2 * j * step];
+                int64_t wi = tw[2 * j * step + 1];
+                int64_t nr = n[0] >> shift;
+                int64_t ni = n[1] >> shift;
+                int32_t mr = m[0] >> shift;
+                int32_t mi = m[1] >> shift;
+
+                /* Q15 product with rounding. */
+                int32_t dr = (int32_t)((nr * wr - ni * wi + (1 << 14)) >> 15);
+                int32_t di = (int32_t)((nr * wi + ni * wr + (1 << 14)) >> 15);
+
+                n[0] = mr - dr;
+                n[1] = mi - di;
+                m[0] = mr + dr;
+                m[1] = mi + di;
+            }
+        }
+    }
+
+    stats_end(STATS_BUTTERFLY, t0);
+    STATS_ADD(transforms, 1);
+    STATS_ADD(butterflies, length / 2 * plan->fft.exp);
+
+    return exp;
+}
+
+void
+fixed_to_complex(const fixed_plan_t *plan, const int32_t *buf, int exp,
+                 size_t bins, double complex *out)
+{
+    double scale = ldexp(1.0, exp - FIXED_INPUT_SHIFT - 15);
+
+    if (bins > plan->fft.length) {
+        bins = plan->fft.length;
+    }
+    for (size_t i = 0; i < bins; i++) {
+        out[i] = CMPLX(buf[2 * i] * scale, buf[2 * i + 1] * scale);
+    }
+}
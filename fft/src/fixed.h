@@ -0,0 +1,86 @@
+#ifndef FOURIER_FIXED_H
+#define FOURIER_FIXED_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <complex.h>
+#include "transform.h"
+#include "wave.h"
+#include "workspace.h"
+
+/**
+ * The left shift applied to the samples when they are loaded, leaving
+ * enough headroom for the first stage.
+ */
+#define FIXED_INPUT_SHIFT   13
+
+/**
+ * Fixed-point Fast Fourier Transform with block floating-point scaling.
+ *
+ * The samples are taken from the raw PCM of the wave file and transformed
+ * as pairs of 32-bit integers with Q15 twiddles.  Before every stage the
+ * whole block is halved if it could overflow, and the number of halvings
+ * is kept as the common exponent of the block.
+ */
+typedef struct fixed_plan
+{
+    /**
+     * The tables shared with the floating-point transform.
+     */
+    fft_plan_t fft;
+
+    /**
+     * The Q15 twiddles, cosine and sine interleaved, for length / 2
+     * angles.
+     */
+    int16_t *twiddle;
+} fixed_plan_t;
+
+/**
+ * Returns the size of the workspace needed for the tables of a plan.
+ */
+size_t fixed_plan_size(size_t count);
+
+/**
+ * Returns the size of the workspace needed for a transform buffer.
+ */
+size_t fixed_buffer_size(size_t count);
+
+/**
+ * Initializes the plan with the tables in the workspace.
+ *
+ * @return  0 on success, -1 on failure.
+ */
+int fixed_plan_init(fixed_plan_t *plan, size_t count, workspace_t *ws);
+
+/**
+ * Loads a channel of the raw PCM in the butterfly order and transforms it.
+ *
+ * @param plan  the plan.
+ * @param h     the handle of the wave file.
+ * @param rbuf  the raw PCM.
+ * @param count the number of frames.
+ * @param ch    the channel.
+ * @param buf   the buffer of fixed_buffer_size() bytes, holding the real
+ *              and the imaginary parts of each bin on return.
+ * @return      the exponent of the block, or -1 if the format is not
+ *              supported.
+ */
+int fixed_execute(const fixed_plan_t *plan, wave_handle_t *h,
+                  const wave_read_buffer_t *rbuf, size_t count,
+                  unsigned int ch, int32_t *buf);
+
+/**
+ * Converts the result into floating-point bins on the scale of
+ * fft_execute() over samples normalized to [-1, 1).
+ *
+ * @param plan  the plan.
+ * @param buf   the result of fixed_execute().
+ * @param exp   the exponent of the block.
+ * @param bins  the number of bins to be converted.
+ * @param out   the converted bins.
+ */
+void fixed_to_complex(const fixed_plan_t *plan, const int32_t *buf, int exp,
+                      size_t bins, double complex *out);
+
+#endif /* FOURIER_FIXED_H */
@@ -0,0 +1,393 @@
+/**
+ * Inverted index of landmark fingerprints
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "fpindex.h"
+#include "batch.h"
+#include "pool.h"
+
+#define FP_INDEX_MAGIC      "FPIX"
+#define FP_INDEX_VERSION    1
+
+#define DIRECTORY_SIZE      (((size_t)1 << FP_INDEX_BITS) + 1)
+
+typedef struct fp_build
+{
+    const path_list_t *list;
+    fp_list_t *lists;
+    int *status;
+} fp_build_t;
+
+/*
+ * A vote for a file at an offset; the key is the file in the upper half
+ * and the offset in the lower one.
+ */
+typedef struct fp_vote
+{
+    uint64_t key;
+    uint32_t count;
+} fp_vote_t;
+
+static size_t
+prefix(uint32_t hash)
+{
+    return hash >> (FP_HASH_BITS - FP_INDEX_BITS);
+}
+
+static void
+extract(size_t task, size_t worker, void *arg)
+{
+    fp_build_t *b = arg;
+    wave_handle_t *handle = wave_open(b->list->paths[task], O_RDONLY);
+
+    b->status[task] = -1;
+    if (handle != NULL) {
+        b->status[task] = fp_extract(handle, &b->lists[task]);
+        wave_close(handle);
+    }
+}
+
+/*
+ * Sorts the postings by hash with a stable radix sort, 8 bits at a time,
+ * so that the order of the files and of the times is kept.
+ */
+static fp_posting_t *
+sort_postings(fp_posting_t *p, fp_posting_t *tmp, size_t n)
+{
+    for (size_t shift = 0; shift < FP_HASH_BITS; shift += 8) {
+        size_t counts[256] = { 0 };
+        for (size_t i = 0; i < n; i++) {
+            counts[(p[i].hash >> shift) & 0xff]++;
+        }
+        size_t sum = 0;
+        for (size_t d = 0; d < 256; d++) {
+            size_t c = counts[d];
+            counts[d] = sum;
+            sum += c;
+        }
+        for (size_t i = 0; i < n; i++) {
+            tmp[counts[(p[i].hash >> shift) & 0xff]++] = p[i];
+        }
+
+        fp_posting_t *swap = p;
+        p = tmp;
+        tmp = swap;
+    }
+    return p;
+}
+
+static int
+write_index(const char *path, const path_list_t *list,
+            const fp_posting_t *postings, size_t n)
+{
+    FILE *out = fopen(path, "wb");
+    if (out == NULL) {
+        return -1;
+    }
+
+    uint64_t *directory = malloc(sizeof(uint64_t) * DIRECTORY_SIZE);
+    uint64_t *names = malloc(sizeof(uint64_t) * (list->count + 1));
+    if (directory == NULL || names == NULL) {
+        goto error;
+    }
+    size_t p = 0;
+    for (size_t b = 0; b < DIRECTORY_SIZE; b++) {
+        while (p < n && prefix(postings[p].hash) < b) {
+            p++;
+        }
+        directory[b] = p;
+    }
+
+    fp_index_header_t h = { FP_INDEX_MAGIC, FP_INDEX_VERSION, FP_RATE,
+                            FP_HOP, list->count, n, 0, 0 };
+    uint64_t end = sizeof(h) + sizeof(uint64_t) * DIRECTORY_SIZE
+                 + sizeof(fp_posting_t) * n;
+    size_t pad = (8 - end % 8) % 8;
+    h.names = end + pad;
+    end = h.names + sizeof(uint64_t) * list->count;
+    for (size_t i = 0; i < list->count; i++) {
+        names[i] = end;
+        end += strlen(list->paths[i]) + 1;
+    }
+    h.size = end;
+
+    static const uint8_t zeros[8];
+    if (fwrite(&h, sizeof(h), 1, out) != 1 ||
+        fwrite(directory, sizeof(uint64_t), DIRECTORY_SIZE, out) !=
+            DIRECTORY_SIZE ||
+        fwrite(postings, sizeof(fp_posting_t), n, out) != n ||
+        fwrite(zeros, 1, pad, out) != pad ||
+        fwrite(names, sizeof(uint64_t), list->count, out) != list->count) {
+        goto error;
+    }
+    for (size_t i = 0; i < list->count; i++) {
+        if (fputs(list->paths[i], out) < 0 || fputc('\0', out) < 0) {
+            goto error;
+        }
+    }
+
+    free(names);
+    free(directory);
+    return fclose(out) == 0 ? 0 : -1;
+
+error:
+    free(names);
+    free(directory);
+    fclose(out);
+    unlink(path);
+    return -1;
+}
+
+int
+fp_index_build(const char *src, const char *path, size_t nthreads)
+{
+    int ret = -1;
+    path_list_t list = { NULL, 0, 0 };
+    fp_build_t b = { &list, NULL, NULL };
+    fp_posting_t *postings = NULL;
+    fp_posting_t *tmp = NULL;
+
+    if (path_list_load(&list, src) < 0) {
+        goto exit;
+    }
+    b.lists = calloc(list.count > 0 ? list.count : 1, sizeof(fp_list_t));
+    b.status = calloc(list.count > 0 ? list.count : 1, sizeof(int));
+    if (b.lists == NULL || b.status == NULL ||
+        pool_run(list.count, nthreads, extract, &b) < 0) {
+        goto exit;
+    }
+
+    /* A file which cannot be read is left out, but fails the build. */
+    size_t n = 0;
+    int failed = 0;
+    for (size_t i = 0; i < list.count; i++) {
+        if (b.status[i] < 0) {
+            fprintf(stderr, "cannot fingerprint %s\n", list.paths[i]);
+            failed = 1;
+            continue;
+        }
+        n += b.lists[i].count;
+    }
+
+    postings = malloc(sizeof(fp_posting_t) * (n > 0 ? n : 1));
+    tmp = malloc(sizeof(fp_posting_t) * (n > 0 ? n : 1));
+    if (postings == NULL || tmp == NULL) {
+        goto exit;
+    }
+    size_t p = 0;
+    for (size_t i = 0; i < list.count; i++) {
+        for (size_t j = 0; b.status[i] == 0 && j < b.lists[i].count; j++) {
+            postings[p].hash = b.lists[i].hashes[j].hash;
+            postings[p].file = (uint32_t)i;
+            postings[p].time = b.lists[i].hashes[j].time;
+            p++;
+        }
+        fp_list_free(&b.lists[i]);
+    }
+
+    const fp_posting_t *sorted = sort_postings(postings, tmp, n);
+    if (write_index(path, &list, sorted, n) == 0 && !failed) {
+        ret = 0;
+    }
+
+exit:
+    if (b.lists != NULL) {
+        for (size_t i = 0; i < list.count; i++) {
+            fp_list_free(&b.lists[i]);
+        }
+    }
+    free(b.lists);
+    free(b.status);
+    free(postings);
+    free(tmp);
+    path_list_free(&list);
+    return ret;
+}
+
+int
+fp_index_open(fp_index_t *index, const char *path)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return -1;
+    }
+
+    struct stat st;
+    index->map = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(fp_index_header_t)) {
+        index->size = st.st_size;
+        index->map = mmap(NULL, index->size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (index->map == MAP_FAILED) {
+        return -1;
+    }
+
+    const fp_index_header_t *h = index->map;
+    size_t postings = sizeof(*h) + sizeof(uint64_t) * DIRECTORY_SIZE;
+    if (memcmp(h->magic, FP_INDEX_MAGIC, sizeof(h->magic)) != 0 ||
+        h->version != FP_INDEX_VERSION || h->rate != FP_RATE ||
+        h->hop != FP_HOP || h->size != index->size ||
+        h->names < postings + sizeof(fp_posting_t) * h->postings ||
+        h->names + sizeof(uint64_t) * h->files > h->size) {
+        munmap(index->map, index->size);
+        return -1;
+    }
+
+    const uint8_t *base = index->map;
+    index->header = h;
+    index->directory = (const uint64_t *)(base + sizeof(*h));
+    index->postings = (const fp_posting_t *)(base + postings);
+    index->names = (const uint64_t *)(base + h->names);
+
+    /*
+     * The lookups and the paths are not checked, so a truncated or
+     * corrupt index is refused here: the directory must split the
+     * postings in order and the paths must lie within the file and end
+     * there at the latest.
+     */
+    const uint64_t *dir = index->directory;
+    int valid = h->names % sizeof(uint64_t) == 0 && dir[0] == 0 &&
+                dir[DIRECTORY_SIZE - 1] == h->postings &&
+                (h->files == 0 || base[h->size - 1] == '\0');
+    for (size_t b = 1; valid && b < DIRECTORY_SIZE; b++) {
+        valid = dir[b - 1] <= dir[b];
+    }
+    uint64_t paths = h->names + sizeof(uint64_t) * h->files;
+    for (size_t i = 0; valid && i < h->files; i++) {
+        valid = index->names[i] >= paths && index->names[i] < h->size;
+    }
+    if (!valid) {
+        munmap(index->map, index->size);
+        return -1;
+    }
+
+    return 0;
+}
+
+void
+fp_index_close(fp_index_t *index)
+{
+    munmap(index->map, index->size);
+}
+
+const char *
+fp_index_path(const fp_index_t *index, uint32_t file)
+{
+    return (const char *)index->map + index->names[file];
+}
+
+/*
+ * Finds the postings of a hash within its entry of the directory.
+ */
+static void
+lookup(const fp_index_t *index, uint32_t hash, size_t *first, size_t *last)
+{
+    const fp_posting_t *p = index->postings;
+    size_t b = prefix(hash);
+    size_t lo = index->directory[b];
+    size_t hi = index->directory[b + 1];
+
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (p[mid].hash < hash) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    *first = lo;
+
+    hi = index->directory[b + 1];
+    while (lo < hi && p[lo].hash == hash) {
+        lo++;
+    }
+    *last = lo;
+}
+
+ssize_t
+fp_index_query(const fp_index_t *index, const fp_hash_t *hashes,
+               size_t count, fp_match_t *matches, size_t k)
+{
+    if (k == 0) {
+        return 0;
+    }
+
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        size_t first, last;
+        lookup(index, hashes[i].hash, &first, &last);
+        total += last - first;
+    }
+
+    /* An open-addressing table of the votes, at most half full. */
+    size_t slots = 64;
+    while (slots < 2 * total) {
+        slots *= 2;
+    }
+    fp_vote_t *votes = calloc(slots, sizeof(fp_vote_t));
+    if (votes == NULL) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        size_t first, last;
+        lookup(index, hashes[i].hash, &first, &last);
+        for (size_t j = first; j < last; j++) {
+            const fp_posting_t *p = &index->postings[j];
+            if (p->file >= index->header->files) {
+                continue;
+            }
+            uint64_t key = (uint64_t)p->file << 32
+                         | (uint32_t)(p->time - hashes[i].time);
+            size_t s = (size_t)((key * 0x9e3779b97f4a7c15) >> 32)
+                     & (slots - 1);
+            while (votes[s].count > 0 && votes[s].key != key) {
+                s = (s + 1) & (slots - 1);
+            }
+            votes[s].key = key;
+            votes[s].count++;
+        }
+    }
+
+    /*
+     * The k best files by insertion, as k is small; the offsets next to the
+     * best one of a file only blur it and are left out.
+     */
+    size_t n = 0;
+    for (size_t s = 0; s < slots; s++) {
+        if (votes[s].count == 0 ||
+            (n == k && votes[s].count <= matches[n - 1].score)) {
+            continue;
+        }
+        uint32_t file = (uint32_t)(votes[s].key >> 32);
+        size_t i = 0;
+        while (i < n && matches[i].file != file) {
+            i++;
+        }
+        if (i < n && matches[i].score >= votes[s].count) {
+            continue;
+        }
+        if (i == n) {
+            i = n < k ? n++ : n - 1;
+        }
+        while (i > 0 && matches[i - 1].score < votes[s].count) {
+            matches[i] = matches[i - 1];
+            i--;
+        }
+        matches[i].file = file;
+        matches[i].offset = (int32_t)(uint32_t)votes[s].key;
+        matches[i].score = votes[s].count;
+    }
+
+    free(votes);
+    return (ssize_t)n;
+}
@@ -0,0 +1,134 @@
+#ifndef FOURIER_FPINDEX_H
+#define FOURIER_FPINDEX_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include "fingerprint.h"
+
+/**
+ * The bits of the hash the directory of the index is addressed with.
+ */
+#define FP_INDEX_BITS   16
+
+/**
+ * The default number of matches of a query.
+ */
+#define FP_MATCHES      5
+
+/**
+ * A landmark of a file of the library.
+ */
+typedef struct fp_posting
+{
+    uint32_t hash;
+    uint32_t file;
+    uint32_t time;
+} fp_posting_t;
+
+/**
+ * The header of an index file, followed by:
+ *
+ *   uint64_t directory[2^FP_INDEX_BITS + 1]  the first posting of each
+ *                                            prefix of the hashes
+ *   fp_posting_t postings[postings]          sorted by hash, then by file
+ *                                            and time
+ *   uint64_t names[files]                    the offsets of the paths
+ *   char paths[]                             the null-terminated paths
+ *
+ * All the offsets are from the start of the file, which is mapped as it
+ * is.
+ */
+typedef struct fp_index_header
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t rate;
+    uint32_t hop;
+    uint64_t files;
+    uint64_t postings;
+    uint64_t names;
+    uint64_t size;
+} fp_index_header_t;
+
+/**
+ * An index mapped for queries.
+ */
+typedef struct fp_index
+{
+    void *map;
+    size_t size;
+    const fp_index_header_t *header;
+    const uint64_t *directory;
+    const fp_posting_t *postings;
+    const uint64_t *names;
+} fp_index_t;
+
+/**
+ * A file of the library matching a query.
+ */
+typedef struct fp_match
+{
+    uint32_t file;
+
+    /**
+     * The frame of the file at which the query starts, which may be
+     * negative if the query starts before the file.
+     */
+    int32_t offset;
+
+    /**
+     * The number of landmarks agreeing on the offset.
+     */
+    uint32_t score;
+} fp_match_t;
+
+/**
+ * Fingerprints every file in a directory or a list and writes the index.
+ *
+ * @param src       a directory holding the wave files, or a text file
+ *                  listing one path per line ("-" for the standard input).
+ * @param path      the path of the index.
+ * @param nthreads  the number of workers, 0 for the number of CPUs.
+ * @return          0 if all the files have been indexed, -1 otherwise.
+ */
+int fp_index_build(const char *src, const char *path, size_t nthreads);
+
+/**
+ * Maps an index.
+ *
+ * @param index the index.
+ * @param path  the path of the index.
+ * @return      0 on success, -1 if it cannot be read or is not an index.
+ */
+int fp_index_open(fp_index_t *index, const char *path);
+
+/**
+ * Unmaps an index.
+ */
+void fp_index_close(fp_index_t *index);
+
+/**
+ * Returns the path of a file of the index.
+ */
+const char *fp_index_path(const fp_index_t *index, uint32_t file);
+
+/**
+ * Finds the files sharing the most landmarks with the query at the same
+ * offset, each with its best offset.  Every hash of the query is looked
+ * up in the directory and its postings vote for their file and the
+ * distance between the landmarks; the cost grows with the landmarks of the
+ * query and their postings, not with the size of the library.
+ *
+ * @param index     the index.
+ * @param hashes    the landmarks of the query.
+ * @param count     the number of landmarks.
+ * @param matches   the array of k matches to be filled.
+ * @param k         the maximum number of matches.
+ * @return          the number of matches, sorted by decreasing score, or
+ *                  -1 on failure.
+ */
+ssize_t fp_index_query(const fp_index_t *index, const fp_hash_t *hashes,
+                       size_t count, fp_match_t *matches, size_t k);
+
+#endif /* FOURIER_FPINDEX_H */
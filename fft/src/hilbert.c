@@ -0,0 +1,326 @@
+/**
+ * Analytic signal, envelope and instantaneous frequency
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <complex.h>
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+#include "hilbert.h"
+
+/*
+ * The odd polynomial approximating atan(a) on [0, 1], fitted to within
+ * 5e-8 radians.
+ */
+#define ATAN_C0     0.99999943744030062
+#define ATAN_C1    -0.33330109040150102
+#define ATAN_C2     0.19948534868174295
+#define ATAN_C3    -0.1391592578858048
+#define ATAN_C4     0.096565578375105321
+#define ATAN_C5    -0.05606710810178929
+#define ATAN_C6     0.021949221490868625
+#define ATAN_C7    -0.0040740027768027542
+
+static size_t
+plan_length(size_t block)
+{
+    return (size_t)1 << to_exp(block + 2 * HILBERT_GUARD - 1);
+}
+
+size_t
+hilbert_plan_size(size_t block)
+{
+    return fft_plan_size(plan_length(block));
+}
+
+int
+hilbert_plan_init(hilbert_plan_t *plan, size_t block, double sample_rate,
+                  workspace_t *ws)
+{
+    if (block == 0 || sample_rate <= 0.0) {
+        return -1;
+    }
+
+    size_t length = plan_length(block);
+    plan->block = block;
+    plan->guard = (length - block) / 2;
+    plan->sample_rate = sample_rate;
+
+    return fft_plan_init(&plan->fft, length, ws);
+}
+
+size_t
+hilbert_state_size(size_t block)
+{
+    size_t length = plan_length(block);
+
+    return workspace_align(sizeof(double) * length)
+         + fft_buffer_size(length);
+}
+
+int
+hilbert_state_init(hilbert_state_t *state, const hilbert_plan_t *plan,
+                   workspace_t *ws)
+{
+    size_t span = plan->block + 2 * plan->guard;
+
+    state->plan = plan;
+    state->pushed = 0;
+    state->written = 0;
+    state->total = SIZE_MAX;
+    state->window = workspace_get(ws, sizeof(double) * span);
+    state->buf = workspace_get(ws, fft_buffer_size(plan->fft.length));
+    if (state->buf == NULL) {
+        return -1;
+    }
+    memset(state->window, 0, sizeof(double) * span);
+
+    return 0;
+}
+
+/*
+ * atan2(y, x) from the polynomial, without branches so that the vector
+ * versions below compute the same values.
+ */
+static inline double
+phase(double y, double x)
+{
+    double ax = fabs(x);
+    double ay = fabs(y);
+    double lo = ax < ay ? ax : ay;
+    double hi = ax < ay ? ay : ax;
+    double a = hi > 0.0 ? lo / hi : 0.0;
+    double s = a * a;
+
+    double p = ATAN_C7;
+    p = p * s + ATAN_C6;
+    p = p * s + ATAN_C5;
+    p = p * s + ATAN_C4;
+    p = p * s + ATAN_C3;
+    p = p * s + ATAN_C2;
+    p = p * s + ATAN_C1;
+    p = p * s + ATAN_C0;
+    double r = p * a;
+
+    r = ay > ax ? M_PI_2 - r : r;
+    r = x < 0.0 ? M_PI - r : r;
+    return copysign(r, y);
+}
+
+#if defined(__AVX__)
+static inline __m256d
+madd4(__m256d a, __m256d b, double c)
+{
+#if defined(__FMA__)
+    return _mm256_fmadd_pd(a, b, _mm256_set1_pd(c));
+#else
+    return _mm256_add_pd(_mm256_mul_pd(a, b), _mm256_set1_pd(c));
+#endif
+}
+
+static inline __m256d
+phase4(__m256d y, __m256d x)
+{
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    __m256d ax = _mm256_andnot_pd(sign, x);
+    __m256d ay = _mm256_andnot_pd(sign, y);
+    __m256d hi = _mm256_max_pd(ax, ay);
+
+    /* 0 / 0 is masked to 0. */
+    __m256d a = _mm256_div_pd(_mm256_min_pd(ax, ay), hi);
+    a = _mm256_and_pd(a, _mm256_cmp_pd(hi, _mm256_setzero_pd(),
+                                       _CMP_GT_OQ));
+    __m256d s = _mm256_mul_pd(a, a);
+
+    __m256d p = madd4(_mm256_set1_pd(ATAN_C7), s, ATAN_C6);
+    p = madd4(p, s, ATAN_C5);
+    p = madd4(p, s, ATAN_C4);
+    p = madd4(p, s, ATAN_C3);
+    p = madd4(p, s, ATAN_C2);
+    p = madd4(p, s, ATAN_C1);
+    p = madd4(p, s, ATAN_C0);
+    __m256d r = _mm256_mul_pd(p, a);
+
+    r = _mm256_blendv_pd(r, _mm256_sub_pd(_mm256_set1_pd(M_PI_2), r),
+                         _mm256_cmp_pd(ay, ax, _CMP_GT_OQ));
+    r = _mm256_blendv_pd(r, _mm256_sub_pd(_mm256_set1_pd(M_PI), r),
+                         _mm256_cmp_pd(x, _mm256_setzero_pd(), _CMP_LT_OQ));
+    return _mm256_or_pd(r, _mm256_and_pd(sign, y));
+}
+
+/*
+ * Splits 4 complex values into their real and imaginary parts.
+ */
+static inline void
+split4(const double complex *z, __m256d *re, __m256d *im)
+{
+    const double *d = (const double *)z;
+    __m128d q0 = _mm_loadu_pd(d);
+    __m128d q1 = _mm_loadu_pd(d + 2);
+    __m128d q2 = _mm_loadu_pd(d + 4);
+    __m128d q3 = _mm_loadu_pd(d + 6);
+
+    *re = _mm256_insertf128_pd(
+        _mm256_castpd128_pd256(_mm_unpacklo_pd(q0, q1)),
+        _mm_unpacklo_pd(q2, q3), 1);
+    *im = _mm256_insertf128_pd(
+        _mm256_castpd128_pd256(_mm_unpackhi_pd(q0, q1)),
+        _mm_unpackhi_pd(q2, q3), 1);
+}
+#elif defined(__SSE2__)
+static inline __m128d
+select2(__m128d mask, __m128d a, __m128d b)
+{
+    return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b));
+}
+
+static inline __m128d
+madd2(__m128d a, __m128d b, double c)
+{
+    return _mm_add_pd(_mm_mul_pd(a, b), _mm_set1_pd(c));
+}
+
+static inline __m128d
+phase2(__m128d y, __m128d x)
+{
+    const __m128d sign = _mm_set1_pd(-0.0);
+    __m128d ax = _mm_andnot_pd(sign, x);
+    __m128d ay = _mm_andnot_pd(sign, y);
+    __m128d hi = _mm_max_pd(ax, ay);
+
+    /* 0 / 0 is masked to 0. */
+    __m128d a = _mm_div_pd(_mm_min_pd(ax, ay), hi);
+    a = _mm_and_pd(a, _mm_cmpgt_pd(hi, _mm_setzero_pd()));
+    __m128d s = _mm_mul_pd(a, a);
+
+    __m128d p = madd2(_mm_set1_pd(ATAN_C7), s, ATAN_C6);
+    p = madd2(p, s, ATAN_C5);
+    p = madd2(p, s, ATAN_C4);
+    p = madd2(p, s, ATAN_C3);
+    p = madd2(p, s, ATAN_C2);
+    p = madd2(p, s, ATAN_C1);
+    p = madd2(p, s, ATAN_C0);
+    __m128d r = _mm_mul_pd(p, a);
+
+    r = select2(_mm_cmpgt_pd(ay, ax),
+                _mm_sub_pd(_mm_set1_pd(M_PI_2), r), r);
+    r = select2(_mm_cmplt_pd(x, _mm_setzero_pd()),
+                _mm_sub_pd(_mm_set1_pd(M_PI), r), r);
+    return _mm_or_pd(r, _mm_and_pd(sign, y));
+}
+#endif
+
+/*
+ * Computes the magnitude of z[i] and the angle between z[i - 1] and z[i]
+ * scaled by the given factor, for i from 0 to n - 1.
+ */
+static void
+envelope_frequency(const double complex *z, size_t n, double scale,
+                   double *envelope, double *frequency)
+{
+    size_t i = 0;
+
+#if defined(__AVX__)
+    const __m256d k = _mm256_set1_pd(scale);
+    for (; i + 4 <= n; i += 4) {
+        __m256d re, im, pre, pim;
+        split4(z + i, &re, &im);
+        split4(z + i - 1, &pre, &pim);
+
+        __m256d norm = _mm256_add_pd(_mm256_mul_pd(re, re),
+                                     _mm256_mul_pd(im, im));
+        _mm256_storeu_pd(envelope + i, _mm256_sqrt_pd(norm));
+
+        /* The angle of z[i] * conj(z[i - 1]) needs no unwrapping. */
+        __m256d x = _mm256_add_pd(_mm256_mul_pd(re, pre),
+                                  _mm256_mul_pd(im, pim));
+        __m256d y = _mm256_sub_pd(_mm256_mul_pd(im, pre),
+                                  _mm256_mul_pd(re, pim));
+        _mm256_storeu_pd(frequency + i, _mm256_mul_pd(k, phase4(y, x)));
+    }
+#elif defined(__SSE2__)
+    const __m128d k = _mm_set1_pd(scale);
+    const double *d = (const double *)z;
+    for (; i + 2 <= n; i += 2) {
+        __m128d p = _mm_loadu_pd(d + 2 * i - 2);
+        __m128d q0 = _mm_loadu_pd(d + 2 * i);
+        __m128d q1 = _mm_loadu_pd(d + 2 * i + 2);
+        __m128d re = _mm_unpacklo_pd(q0, q1);
+        __m128d im = _mm_unpackhi_pd(q0, q1);
+        __m128d pre = _mm_unpacklo_pd(p, q0);
+        __m128d pim = _mm_unpackhi_pd(p, q0);
+
+        __m128d norm = _mm_add_pd(_mm_mul_pd(re, re), _mm_mul_pd(im, im));
+        _mm_storeu_pd(envelope + i, _mm_sqrt_pd(norm));
+
+        /* The angle of z[i] * conj(z[i - 1]) needs no unwrapping. */
+        __m128d x = _mm_add_pd(_mm_mul_pd(re, pre), _mm_mul_pd(im, pim));
+        __m128d y = _mm_sub_pd(_mm_mul_pd(im, pre), _mm_mul_pd(re, pim));
+        _mm_storeu_pd(frequency + i, _mm_mul_pd(k, phase2(y, x)));
+    }
+#endif
+
+    for (; i < n; i++) {
+        double re = creal(z[i]), im = cimag(z[i]);
+        double pre = creal(z[i - 1]), pim = cimag(z[i - 1]);
+        envelope[i] = sqrt(re * re + im * im);
+        frequency[i] = scale * phase(im * pre - re * pim, re * pre + im * pim);
+    }
+}
+
+size_t
+hilbert_process(hilbert_state_t *state, const double *in, size_t count,
+                double *envelope, double *frequency)
+{
+    const hilbert_plan_t *plan = state->plan;
+    size_t b = plan->block;
+    size_t g = plan->guard;
+    size_t n = plan->fft.length;
+
+    if (state->written >= state->total) {
+        return 0;
+    }
+
+    /* The window holds the samples from start - 2 * guard on. */
+    size_t start = state->pushed;
+    memmove(state->window, state->window + b, sizeof(double) * 2 * g);
+    memcpy(state->window + 2 * g, in, sizeof(double) * count);
+    memset(state->window + 2 * g + count, 0, sizeof(double) * (b - count));
+    state->pushed += b;
+    if (count < b && state->total == SIZE_MAX) {
+        state->total = start + count;
+    }
+
+    /* The block kept is the one centred in the window. */
+    size_t end = start + b > g ? start + b - g : 0;
+    if (end > state->total) {
+        end = state->total;
+    }
+    if (end <= state->written) {
+        return 0;
+    }
+
+    double complex *buf = state->buf;
+    fft_execute(&plan->fft, state->window, b + 2 * g, buf);
+
+    /*
+     * With the sign of the transform, the positive frequencies are in the
+     * upper half: they are doubled and the lower half is cleared.
+     */
+    for (size_t k = 1; k < n / 2; k++) {
+        buf[k] = 0.0;
+        buf[n - k] *= 2.0;
+    }
+    fft_inverse(&plan->fft, buf);
+
+    size_t first = state->written + 2 * g - start;
+    size_t len = end - state->written;
+    envelope_frequency(buf + first, len, plan->sample_rate / (2.0 * M_PI),
+                       envelope, frequency);
+    state->written = end;
+
+    return len;
+}
@@ -0,0 +1,141 @@
+#ifndef FOURIER_HILBERT_H
+#define FOURIER_HILBERT_H
+
+#include <stdlib.h>
+#include <complex.h>
+#include "transform.h"
+#include "workspace.h"
+
+/**
+ * The default number of samples of a block.
+ */
+#define HILBERT_BLOCK   8192
+
+/**
+ * The least number of samples kept on each side of a block.
+ */
+#define HILBERT_GUARD   2048
+
+/**
+ * Analytic signal of a stream, from which the envelope and the
+ * instantaneous frequency are derived.
+ *
+ * The analytic signal is the inverse of the spectrum without its negative
+ * frequencies.  As the transform of a block is circular, the signal near
+ * its edges leaks from the other side, the more so the sharper the edge;
+ * every block is therefore transformed together with guard samples before
+ * and after it, and only the block itself is kept (overlap-discard).  The
+ * guard takes whatever is left of the power of 2 around the block, so the
+ * output lags the input by guard samples and the memory does not depend
+ * on the length of the stream.
+ */
+typedef struct hilbert_plan
+{
+    /**
+     * The number of samples of a block.
+     */
+    size_t block;
+
+    /**
+     * The number of samples kept on each side of a block.
+     */
+    size_t guard;
+
+    /**
+     * The sampling rate in Hz.
+     */
+    double sample_rate;
+
+    /**
+     * The plan of at least block + 2 * guard points.
+     */
+    fft_plan_t fft;
+} hilbert_plan_t;
+
+/**
+ * The state of a stream.
+ */
+typedef struct hilbert_state
+{
+    const hilbert_plan_t *plan;
+
+    /**
+     * The block + 2 * guard latest samples, the oldest first.
+     */
+    double *window;
+
+    /**
+     * The transform buffer.
+     */
+    double complex *buf;
+
+    /**
+     * The number of samples pushed and the number of results written.
+     */
+    size_t pushed;
+    size_t written;
+
+    /**
+     * The number of samples of the stream, known once it has ended.
+     */
+    size_t total;
+} hilbert_state_t;
+
+/**
+ * Returns the size of the workspace needed for the tables of a plan.
+ *
+ * @param block the number of samples of a block.
+ */
+size_t hilbert_plan_size(size_t block);
+
+/**
+ * Initializes the plan with the tables in the workspace.
+ *
+ * @param plan          the plan.
+ * @param block         the number of samples of a block.
+ * @param sample_rate   the sampling rate in Hz.
+ * @param ws            the workspace with at least hilbert_plan_size()
+ *                      bytes left.
+ * @return              0 on success, -1 on failure.
+ */
+int hilbert_plan_init(hilbert_plan_t *plan, size_t block, double sample_rate,
+                      workspace_t *ws);
+
+/**
+ * Returns the size of the workspace needed for the state of a stream.
+ *
+ * @param block the number of samples of a block.
+ */
+size_t hilbert_state_size(size_t block);
+
+/**
+ * Initializes the state of a stream with silence before its start.
+ *
+ * @param state the state.
+ * @param plan  the plan, which may be shared by several streams.
+ * @param ws    the workspace with at least hilbert_state_size() bytes left.
+ * @return      0 on success, -1 if the workspace is exhausted.
+ */
+int hilbert_state_init(hilbert_state_t *state, const hilbert_plan_t *plan,
+                       workspace_t *ws);
+
+/**
+ * Pushes the next samples of a stream and computes the results which no
+ * longer depend on the samples to come.
+ *
+ * The stream ends with the first call of less than plan->block samples;
+ * the calls that follow, with no samples, write the remaining results.
+ *
+ * @param state     the state.
+ * @param in        the samples.
+ * @param count     the number of samples, up to plan->block.
+ * @param envelope  the plan->block magnitudes of the analytic signal,
+ *                  which may be the input.
+ * @param frequency the plan->block instantaneous frequencies in Hz.
+ * @return          the number of results written, which lag the samples by
+ *                  plan->guard.
+ */
+size_t hilbert_process(hilbert_state_t *state, const double *in, size_t count,
+                       double *envelope, double *frequency);
+
+#endif /* FOURIER_HILBERT_H */
@@ -0,0 +1,124 @@
+/**
+ * Mel filterbank and cepstral coefficients
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include <complex.h>
+#include "mel.h"
+#include "transform.h"
+
+/*
+ * The energy a silent filter is clamped to before the logarithm.
+ */
+#define MEL_FLOOR   1e-10
+
+static double
+to_mel(double f)
+{
+    return 2595.0 * log10(1.0 + f / 700.0);
+}
+
+static double
+from_mel(double m)
+{
+    return 700.0 * (pow(10.0, m / 2595.0) - 1.0);
+}
+
+size_t
+mel_plan_size(size_t count, size_t mels, size_t coeffs)
+{
+    size_t length = (size_t)1 << to_exp(count - 1);
+
+    /*
+     * A bin lies on the slopes of two filters at most, give or take the
+     * rounding at the ends of each filter.
+     */
+    return workspace_align(sizeof(size_t) * mels)
+         + workspace_align(sizeof(size_t) * (mels + 1))
+         + workspace_align(sizeof(double) * (2 * (length / 2 + 1) + mels))
+         + workspace_align(sizeof(double) * coeffs * mels);
+}
+
+int
+mel_plan_init(mel_plan_t *plan, size_t count, double sample_rate,
+              size_t mels, size_t coeffs, workspace_t *ws)
+{
+    if (mels == 0 || mels > MEL_MAX || coeffs == 0 || coeffs > mels) {
+        return -1;
+    }
+
+    plan->length = (size_t)1 << to_exp(count - 1);
+    plan->mels = mels;
+    plan->coeffs = coeffs;
+
+    size_t nbins = plan->length / 2 + 1;
+    plan->first = workspace_get(ws, sizeof(size_t) * mels);
+    plan->offset = workspace_get(ws, sizeof(size_t) * (mels + 1));
+    plan->weights = workspace_get(ws, sizeof(double) * (2 * nbins + mels));
+    plan->dct = workspace_get(ws, sizeof(double) * coeffs * mels);
+    if (plan->dct == NULL) {
+        return -1;
+    }
+
+    double res = sample_rate / (double)plan->length;
+    double top = to_mel(sample_rate / 2.0);
+    size_t n = 0;
+
+    for (size_t i = 0; i < mels; i++) {
+        double lo = from_mel(top * (double)i / (double)(mels + 1));
+        double mid = from_mel(top * (double)(i + 1) / (double)(mels + 1));
+        double hi = from_mel(top * (double)(i + 2) / (double)(mels + 1));
+
+        size_t k = (size_t)floor(lo / res) + 1;
+        plan->first[i] = k;
+        plan->offset[i] = n;
+        for (; k < nbins && res * k < hi; k++) {
+            double f = res * k;
+            plan->weights[n++] = f <= mid ? (f - lo) / (mid - lo)
+                                          : (hi - f) / (hi - mid);
+        }
+    }
+    plan->offset[mels] = n;
+
+    for (size_t c = 0; c < coeffs; c++) {
+        double scale = sqrt((c == 0 ? 1.0 : 2.0) / (double)mels);
+        for (size_t m = 0; m < mels; m++) {
+            plan->dct[c * mels + m] =
+                scale * cos(M_PI * (double)c * ((double)m + 0.5) /
+                            (double)mels);
+        }
+    }
+
+    return 0;
+}
+
+void
+mel_execute(const mel_plan_t *plan, const double complex *spectrum,
+            float *features)
+{
+    double energy[MEL_MAX];
+
+    for (size_t i = 0; i < plan->mels; i++) {
+        const double complex *bin = spectrum + plan->first[i];
+        const double *w = plan->weights + plan->offset[i];
+        size_t n = plan->offset[i + 1] - plan->offset[i];
+        double sum = 0.0;
+
+        for (size_t k = 0; k < n; k++) {
+            double re = creal(bin[k]);
+            double im = cimag(bin[k]);
+            sum += w[k] * (re * re + im * im);
+        }
+        energy[i] = log(sum > MEL_FLOOR ? sum : MEL_FLOOR);
+    }
+
+    for (size_t c = 0; c < plan->coeffs; c++) {
+        const double *row = plan->dct + c * plan->mels;
+        double sum = 0.0;
+        for (size_t m = 0; m < plan->mels; m++) {
+            sum += row[m] * energy[m];
+        }
+        features[c] = (float)sum;
+    }
+}
@@ -0,0 +1,90 @@
+#ifndef FOURIER_MEL_H
+#define FOURIER_MEL_H
+
+#include <stdlib.h>
+#include <complex.h>
+#include "workspace.h"
+
+/**
+ * The largest number of mel filters.
+ */
+#define MEL_MAX     256
+
+/**
+ * Mel-frequency cepstral coefficients of a spectrum.
+ *
+ * The power of every bin is weighted by the triangular filters spaced
+ * evenly on the mel scale from 0 Hz to the Nyquist frequency, then the
+ * logarithms of the filter energies are decorrelated by an orthonormal
+ * DCT-II.  Only the non-zero weights of each filter are kept, so a frame
+ * reads each bin at most twice.
+ */
+typedef struct mel_plan
+{
+    /**
+     * The size of the transform.
+     */
+    size_t length;
+
+    /**
+     * The number of filters.
+     */
+    size_t mels;
+
+    /**
+     * The number of coefficients, at most the number of filters.
+     */
+    size_t coeffs;
+
+    /**
+     * The first bin of each filter.
+     */
+    size_t *first;
+
+    /**
+     * The weights of filter i are weights[offset[i]..offset[i + 1]-1].
+     */
+    size_t *offset;
+    double *weights;
+
+    /**
+     * The DCT-II matrix of coeffs rows of mels elements.
+     */
+    double *dct;
+} mel_plan_t;
+
+/**
+ * Returns the size of the workspace needed for the tables of a plan.
+ *
+ * @param count     the number of samples of the transform.
+ * @param mels      the number of filters.
+ * @param coeffs    the number of coefficients.
+ */
+size_t mel_plan_size(size_t count, size_t mels, size_t coeffs);
+
+/**
+ * Initializes the plan with the tables in the workspace.
+ *
+ * @param plan          the plan.
+ * @param count         the number of samples of the transform.
+ * @param sample_rate   the sampling rate in Hz.
+ * @param mels          the number of filters, at most MEL_MAX.
+ * @param coeffs        the number of coefficients, at most mels.
+ * @param ws            the workspace with at least mel_plan_size() bytes
+ *                      left.
+ * @return              0 on success, -1 on failure.
+ */
+int mel_plan_init(mel_plan_t *plan, size_t count, double sample_rate,
+                  size_t mels, size_t coeffs, workspace_t *ws);
+
+/**
+ * Computes the coefficients of a spectrum.
+ *
+ * @param plan      the plan.
+ * @param spectrum  the result of the transform in the natural order.
+ * @param features  the coefficients, plan->coeffs elements.
+ */
+void mel_execute(const mel_plan_t *plan, const double complex *spectrum,
+                 float *features);
+
+#endif /* FOURIER_MEL_H */
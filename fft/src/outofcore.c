@@ -0,0 +1,348 @@
+/**
+ * Out-of-core four-step Fast Fourier Transform
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <math.h>
+#include <complex.h>
+#include <sys/mman.h>
+#include "outofcore.h"
+
+static int
+pread_full(int fd, void *buf, size_t count, off_t offset)
+{
+    size_t done = 0;
+
+    while (done < count) {
+        ssize_t sz = pread(fd, (uint8_t *)buf + done, count - done,
+                           offset + done);
+        if (sz < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sz <= 0) {
+            return -1;
+        }
+        done += sz;
+    }
+
+    return 0;
+}
+
+static int
+pwrite_full(int fd, const void *buf, size_t count, off_t offset)
+{
+    size_t done = 0;
+
+    while (done < count) {
+        ssize_t sz = pwrite(fd, (const uint8_t *)buf + done, count - done,
+                            offset + done);
+        if (sz < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sz <= 0) {
+            return -1;
+        }
+        done += sz;
+    }
+
+    return 0;
+}
+
+/**
+ * Reads a block of columns of a matrix stored in slabs into ooc->in as
+ * rows.
+ *
+ * Every slab of a matrix holds whole rows and is written at once,
+ * transposed, at the offset of its first row, hence a block of columns is
+ * one run in every slab.  ooc->out holds the run before it is copied.
+ *
+ * @param ooc       the transform.
+ * @param src       the offset of the matrix.
+ * @param nrows     the number of rows.
+ * @param ncols     the number of columns.
+ * @param height    the number of rows of the slabs but the last one.
+ * @param c0        the first column of the block.
+ * @param w         the number of columns of the block.
+ */
+static int
+gather(ooc_fft_t *ooc, off_t src, size_t nrows, size_t ncols, size_t height,
+       size_t c0, size_t w)
+{
+    for (size_t r0 = 0; r0 < nrows; r0 += height) {
+        size_t h = nrows - r0 < height ? nrows - r0 : height;
+        off_t offset = src + (off_t)(r0 * ncols + c0 * h)
+                           * sizeof(double complex);
+
+        if (pread_full(ooc->fd, ooc->out, sizeof(double complex) * w * h,
+                       offset) < 0) {
+            return -1;
+        }
+        for (size_t j = 0; j < w; j++) {
+            memcpy(ooc->in + j * nrows + r0, ooc->out + j * h,
+                   sizeof(double complex) * h);
+        }
+    }
+    return 0;
+}
+
+/**
+ * Appends the last t rows of samples to the second region as a slab.
+ */
+static int
+flush_input(ooc_fft_t *ooc, size_t t)
+{
+    size_t r0 = ooc->written / ooc->cols - t;
+
+    for (size_t i = 0; i < t; i++) {
+        for (size_t c = 0; c < ooc->cols; c++) {
+            ooc->out[c * t + i] = ooc->in[i * ooc->cols + c];
+        }
+    }
+    return pwrite_full(ooc->fd, ooc->out,
+                       sizeof(double complex) * t * ooc->cols,
+                       ooc->region + (off_t)(r0 * ooc->cols)
+                                   * sizeof(double complex));
+}
+
+/*
+ * Appends the samples, or zeros if samples is NULL.
+ */
+static int
+append(ooc_fft_t *ooc, const double *samples, size_t len)
+{
+    size_t full = ooc->tile / ooc->cols * ooc->cols;
+
+    while (len > 0) {
+        size_t pos = ooc->written % full;
+        size_t n = full - pos < len ? full - pos : len;
+
+        for (size_t i = 0; i < n; i++) {
+            ooc->in[pos + i] = samples != NULL ? samples[i] : 0.0;
+        }
+        if (samples != NULL) {
+            samples += n;
+        }
+        len -= n;
+        ooc->written += n;
+
+        if (ooc->written % full == 0 &&
+            flush_input(ooc, full / ooc->cols) < 0) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * Transforms every column of a matrix stored in slabs and writes the
+ * results as the rows of the transposed matrix, in slabs of
+ * ooc->tile / nrows rows.  Each slab is written sequentially at once.
+ *
+ * @param ooc       the transform.
+ * @param src       the offset of the matrix.
+ * @param dst       the offset of the transposed matrix.
+ * @param nrows     the number of rows.
+ * @param ncols     the number of columns.
+ * @param height    the number of rows of the slabs of the matrix.
+ * @param plan      the plan of nrows points, or NULL to only transpose
+ *                  the matrix, in which case the result is in the natural
+ *                  order.
+ * @param twiddle   whether to multiply the element at (r, c) by the
+ *                  (r * c)-th power of the N-th root after the transform.
+ */
+static int
+pass(ooc_fft_t *ooc, off_t src, off_t dst, size_t nrows, size_t ncols,
+     size_t height, const fft_plan_t *plan, int twiddle)
+{
+    size_t wmax = ooc->tile / nrows;
+
+    for (size_t c0 = 0; c0 < ncols; c0 += wmax) {
+        size_t w = ncols - c0 < wmax ? ncols - c0 : wmax;
+        const double complex *slab = plan != NULL ? ooc->out : ooc->in;
+
+        if (gather(ooc, src, nrows, ncols, height, c0, w) < 0) {
+            return -1;
+        }
+
+        for (size_t i = 0; plan != NULL && i < w; i++) {
+            fft_execute_complex(plan, ooc->in + i * nrows, nrows, ooc->row);
+            if (twiddle) {
+                for (size_t r = 0; r < nrows; r++) {
+                    size_t j = (c0 + i) * r;
+                    ooc->row[r] *= ooc->hi[j / ooc->rows]
+                                 * ooc->lo[j % ooc->rows];
+                }
+            }
+            for (size_t r = 0; r < nrows; r++) {
+                ooc->out[r * w + i] = ooc->row[r];
+            }
+        }
+
+        if (pwrite_full(ooc->fd, slab, sizeof(double complex) * w * nrows,
+                        dst + (off_t)(c0 * nrows)
+                            * sizeof(double complex)) < 0) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+ooc_fft_t *
+ooc_fft_create(const char *dir, size_t count, size_t memory)
+{
+    ooc_fft_t *ooc = calloc(1, sizeof(ooc_fft_t));
+    if (ooc == NULL) {
+        return NULL;
+    }
+    ooc->fd = -1;
+
+    /* The rows are no shorter than the columns. */
+    size_t exp = to_exp(count - 1);
+    ooc->plan.count = count;
+    ooc->plan.exp = exp;
+    ooc->plan.length = (size_t)1 << exp;
+    ooc->plan.itable = NULL;
+    ooc->rows = (size_t)1 << (exp - exp / 2);
+    ooc->cols = (size_t)1 << (exp / 2);
+
+    /*
+     * A tile holds whole rows and columns, so with less memory than a row
+     * the two tiles take more than the memory given.
+     */
+    ooc->tile = memory / (2 * sizeof(double complex));
+    if (ooc->tile < ooc->rows) {
+        ooc->tile = ooc->rows;
+    }
+
+    size_t wsize = fft_plan_size(ooc->rows) + fft_plan_size(ooc->cols)
+                 + 2 * workspace_align(sizeof(double complex) * ooc->tile)
+                 + fft_buffer_size(ooc->rows)
+                 + workspace_align(sizeof(double complex) * ooc->rows)
+                 + workspace_align(sizeof(double complex) * ooc->cols);
+    ooc->ws = workspace_create(wsize, WORKSPACE_HUGEPAGE);
+    if (ooc->ws == NULL ||
+        fft_plan_init(&ooc->row_plan, ooc->rows, ooc->ws) < 0 ||
+        fft_plan_init(&ooc->col_plan, ooc->cols, ooc->ws) < 0) {
+        goto error;
+    }
+    ooc->in = workspace_get(ooc->ws, sizeof(double complex) * ooc->tile);
+    ooc->out = workspace_get(ooc->ws, sizeof(double complex) * ooc->tile);
+    ooc->row = workspace_get(ooc->ws, fft_buffer_size(ooc->rows));
+    ooc->lo = workspace_get(ooc->ws, sizeof(double complex) * ooc->rows);
+    ooc->hi = workspace_get(ooc->ws, sizeof(double complex) * ooc->cols);
+    if (ooc->hi == NULL) {
+        goto error;
+    }
+
+    for (size_t j = 0; j < ooc->rows; j++) {
+        double a = 2.0 * M_PI * (double)j / (double)ooc->plan.length;
+        ooc->lo[j] = CMPLX(cos(a), sin(a));
+    }
+    for (size_t j = 0; j < ooc->cols; j++) {
+        double a = 2.0 * M_PI * (double)j / (double)ooc->cols;
+        ooc->hi[j] = CMPLX(cos(a), sin(a));
+    }
+
+    /* Map the regions at page boundaries for the result. */
+    long page = sysconf(_SC_PAGESIZE);
+    ooc->region = sizeof(double complex) * ooc->plan.length;
+    ooc->region = (ooc->region + page - 1) / page * page;
+
+    char *path = malloc(strlen(dir) + sizeof("/fft.XXXXXX"));
+    if (path == NULL) {
+        goto error;
+    }
+    sprintf(path, "%s/fft.XXXXXX", dir);
+    ooc->fd = mkstemp(path);
+    if (ooc->fd >= 0) {
+        unlink(path);
+    }
+    free(path);
+    if (ooc->fd < 0 || ftruncate(ooc->fd, 2 * ooc->region) < 0) {
+        goto error;
+    }
+    /* The passes read a run from every slab, far apart in the file. */
+    posix_fadvise(ooc->fd, 0, 0, POSIX_FADV_RANDOM);
+
+    return ooc;
+
+error:
+    ooc_fft_destroy(ooc);
+    return NULL;
+}
+
+void
+ooc_fft_destroy(ooc_fft_t *ooc)
+{
+    if (ooc->result != NULL) {
+        munmap(ooc->result, ooc->region);
+    }
+    if (ooc->fd >= 0) {
+        close(ooc->fd);
+    }
+    if (ooc->ws != NULL) {
+        workspace_destroy(ooc->ws);
+    }
+    free(ooc);
+}
+
+int
+ooc_fft_write(ooc_fft_t *ooc, const double *samples, size_t len)
+{
+    if (ooc->written >= ooc->plan.count) {
+        return 0;
+    }
+    if (len > ooc->plan.count - ooc->written) {
+        len = ooc->plan.count - ooc->written;
+    }
+    return append(ooc, samples, len);
+}
+
+const double complex *
+ooc_fft_execute(ooc_fft_t *ooc)
+{
+    if (ooc->result != NULL) {
+        return ooc->result;
+    }
+
+    /* The padding ends on a whole row; flush the rows left in the tile. */
+    size_t full = ooc->tile / ooc->cols * ooc->cols;
+    if (append(ooc, NULL, ooc->plan.length - ooc->written) < 0 ||
+        (ooc->written % full != 0 &&
+         flush_input(ooc, ooc->written % full / ooc->cols) < 0)) {
+        return NULL;
+    }
+
+    /*
+     * The N1 by N2 signal is in slabs of full / N2 rows.  The columns
+     * of N1 points are transformed and multiplied by the twiddles, the
+     * columns of N2 points of the result are transformed and the spectrum
+     * is transposed into the natural order.
+     */
+    size_t height = full / ooc->cols;
+    if (pass(ooc, ooc->region, 0, ooc->rows, ooc->cols, height,
+             &ooc->row_plan, 1) < 0 ||
+        pass(ooc, 0, ooc->region, ooc->cols, ooc->rows,
+             ooc->tile / ooc->rows, &ooc->col_plan, 0) < 0 ||
+        pass(ooc, ooc->region, 0, ooc->rows, ooc->cols,
+             ooc->tile / ooc->cols, NULL, 0) < 0) {
+        return NULL;
+    }
+
+    void *result = mmap(NULL, ooc->region, PROT_READ, MAP_SHARED, ooc->fd, 0);
+    if (result == MAP_FAILED) {
+        return NULL;
+    }
+    madvise(result, ooc->region, MADV_SEQUENTIAL);
+    ooc->result = result;
+
+    return ooc->result;
+}
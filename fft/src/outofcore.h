@@ -0,0 +1,121 @@
+#ifndef FOURIER_OUTOFCORE_H
+#define FOURIER_OUTOFCORE_H
+
+#include <stdlib.h>
+#include <complex.h>
+#include <sys/types.h>
+#include "transform.h"
+#include "workspace.h"
+
+/**
+ * The default memory for the tiles of an out-of-core transform.
+ */
+#define OOC_MEMORY  ((size_t)256 << 20)
+
+/**
+ * Transform too large for the memory, computed with the four-step
+ * algorithm over a scratch file.
+ *
+ * The signal of N = N1 * N2 points is seen as N1 rows of N2 points.  Every
+ * matrix lives in the scratch file as slabs of whole rows, each written
+ * transposed with one sequential write, so that a block of columns is one
+ * run per slab.  The columns of N1 points are read in such blocks,
+ * transformed, multiplied by the twiddles and written as slabs, the
+ * columns of N2 points of the result are transformed likewise and a last
+ * pass transposes the spectrum into the natural order.  With tiles of T
+ * points the reads are T * T / N points long.  The file needs 32 bytes
+ * per point and the memory only the tiles.
+ */
+typedef struct ooc_fft
+{
+    /**
+     * The size of the whole transform.  It has no tables and is only
+     * meant for the output functions.
+     */
+    fft_plan_t plan;
+
+    /**
+     * The number of rows N1 of the signal and its plan.
+     */
+    size_t rows;
+    fft_plan_t row_plan;
+
+    /**
+     * The number of columns N2 of the signal and its plan.
+     */
+    size_t cols;
+    fft_plan_t col_plan;
+
+    /**
+     * The number of elements of a tile.
+     */
+    size_t tile;
+
+    /**
+     * The number of samples written so far.
+     */
+    size_t written;
+
+    /**
+     * The scratch file and the size of each of its two regions.
+     */
+    int fd;
+    off_t region;
+
+    workspace_t *ws;
+    double complex *in;
+    double complex *out;
+    double complex *row;
+
+    /**
+     * The twiddles exp(2 pi i j / N) for j < N1 and exp(2 pi i j / N2)
+     * for j < N2, which multiply to any power of the N-th root.
+     */
+    double complex *lo;
+    double complex *hi;
+
+    /**
+     * The spectrum mapped from the scratch file, or NULL.
+     */
+    double complex *result;
+} ooc_fft_t;
+
+/**
+ * Creates an out-of-core transform.
+ *
+ * @param dir       the directory for the scratch file, which is removed
+ *                  as soon as it has been created.
+ * @param count     the number of samples.
+ * @param memory    the memory for the tiles in bytes.  The tiles hold a
+ *                  row of N1 points at least, hence they take 32 * N1
+ *                  bytes, more than the memory, when it is smaller.
+ * @return          the transform, or NULL on failure.
+ */
+ooc_fft_t *ooc_fft_create(const char *dir, size_t count, size_t memory);
+
+/**
+ * Releases the transform and its scratch file.
+ */
+void ooc_fft_destroy(ooc_fft_t *ooc);
+
+/**
+ * Appends the samples to the signal.  Samples past the count are
+ * ignored.
+ *
+ * @param ooc       the transform.
+ * @param samples   the signal samples.
+ * @param len       the count of samples.
+ * @return          0 on success, -1 on I/O error.
+ */
+int ooc_fft_write(ooc_fft_t *ooc, const double *samples, size_t len);
+
+/**
+ * Pads the signal with zeros and transforms it.
+ *
+ * @param ooc   the transform.
+ * @return      the read-only spectrum of ooc->plan.length points, valid
+ *              until ooc_fft_destroy(), or NULL on failure.
+ */
+const double complex *ooc_fft_execute(ooc_fft_t *ooc);
+
+#endif /* FOURIER_OUTOFCORE_H */
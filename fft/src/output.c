@@ -0,0 +1,383 @@
+/**
+ * Text output of the analyses
+ */
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <inttypes.h>
+#include <complex.h>
+#include "output.h"
+#include "peaks.h"
+
+/*
+ * The values converted at a time for a record.
+ */
+#define RECORD_CHUNK    256
+
+/*
+ * Adds the result of fprintf() to the number of bytes written.
+ */
+static inline size_t
+count(int n)
+{
+    return n > 0 ? (size_t)n : 0;
+}
+
+static size_t
+record(FILE *out, enum output_kind kind, size_t n, double base, double step)
+{
+    output_record_t r = { kind, (uint32_t)n, base, step };
+    return fwrite(&r, sizeof(r), 1, out) * sizeof(r);
+}
+
+/*
+ * Writes n bins as a record of magnitudes and phases.
+ */
+static size_t
+record_bins(FILE *out, double base, double step, const double complex *buf,
+            size_t n)
+{
+    double tmp[2 * RECORD_CHUNK];
+    size_t bytes = record(out, OUTPUT_BINS, n, base, step);
+
+    for (size_t i = 0; i < n; i += RECORD_CHUNK) {
+        size_t m = n - i < RECORD_CHUNK ? n - i : RECORD_CHUNK;
+        for (size_t j = 0; j < m; j++) {
+            tmp[2 * j] = cabs(buf[i + j]);
+            tmp[2 * j + 1] = carg(buf[i + j]);
+        }
+        bytes += fwrite(tmp, sizeof(double), 2 * m, out) * sizeof(double);
+    }
+    return bytes;
+}
+
+/*
+ * Writes peaks as a record of rows, at base + step * bin Hz.
+ */
+static size_t
+record_peaks(FILE *out, double base, double step, const peak_t *peaks,
+             size_t n)
+{
+    size_t bytes = record(out, OUTPUT_ROWS, n, 0.0, 0.0);
+
+    for (size_t i = 0; i < n; i++) {
+        double row[3] = { base + step * peaks[i].bin, peaks[i].magnitude,
+                          peaks[i].phase };
+        bytes += fwrite(row, sizeof(row), 1, out) * sizeof(row);
+    }
+    return bytes;
+}
+
+size_t
+output_text(FILE *out, const output_options_t *opts, const char *fmt, ...)
+{
+    va_list ap;
+    int n;
+
+    va_start(ap, fmt);
+    if (opts == NULL || !opts->binary) {
+        n = vfprintf(out, fmt, ap);
+        va_end(ap);
+        return count(n);
+    }
+
+    char line[BUFSIZ];
+    n = vsnprintf(line, sizeof(line), fmt, ap);
+    va_end(ap);
+    size_t len = n < 0 ? 0 : (size_t)n < sizeof(line) ? (size_t)n
+                                                       : sizeof(line) - 1;
+    return record(out, OUTPUT_TEXT, len, 0.0, 0.0) + fwrite(line, 1, len, out);
+}
+
+size_t
+output_block(FILE *out, const output_options_t *opts, size_t bytes,
+             size_t samples)
+{
+    if (opts->binary) {
+        return record(out, OUTPUT_BLOCK, bytes, (double)samples, 0.0);
+    }
+    return count(fprintf(out, "# %zu samples read.\n", bytes))
+         + count(fprintf(out, "# %zu samples to be processed.\n", samples));
+}
+
+void
+output_header(FILE *out, const output_options_t *opts, wave_handle_t *h)
+{
+    output_text(out, opts, "# length %" PRIu64 "\n", h->length);
+    output_text(out, opts, "# num_channels %u\n", h->num_channels);
+    output_text(out, opts, "# sample_rate %u\n", h->sample_rate);
+    output_text(out, opts, "# byte_rate %u\n", h->byte_rate);
+    output_text(out, opts, "# block_size %u\n", h->block_size);
+    output_text(out, opts, "# bits_per_sample %u\n", h->bits_per_sample);
+}
+
+size_t
+output_spectrum(FILE *out, const fft_plan_t *plan, double sample_rate,
+                const double complex *buf)
+{
+    size_t bytes = 0;
+    double res = sample_rate / (double)plan->length;
+    /* Output only the left channel */
+    for (size_t i = 0; i < plan->count / 2; i++) {
+        bytes += count(fprintf(out, "%f %f %f 0 0\n", res * i, cabs(buf[i]),
+                               carg(buf[i])));
+    }
+    return bytes;
+}
+
+size_t
+output_peaks(FILE *out, const fft_plan_t *plan, double sample_rate,
+             const double complex *buf, size_t k, double threshold)
+{
+    peak_t peaks[PEAKS_MAX];
+    size_t bytes = 0;
+
+    if (k > PEAKS_MAX) {
+        k = PEAKS_MAX;
+    }
+
+    double res = sample_rate / (double)plan->length;
+    size_t n = find_peaks(buf, plan->count / 2, threshold, peaks, k);
+    for (size_t i = 0; i < n; i++) {
+        bytes += count(fprintf(out, "%f %f %f\n", res * peaks[i].bin,
+                               peaks[i].magnitude, peaks[i].phase));
+    }
+    return bytes;
+}
+
+size_t
+output_result(FILE *out, const output_options_t *opts,
+              const fft_plan_t *plan, double sample_rate,
+              const double complex *buf)
+{
+    double res = sample_rate / (double)plan->length;
+
+    if (opts->binary && opts->peaks > 0) {
+        peak_t peaks[PEAKS_MAX];
+        size_t k = opts->peaks < PEAKS_MAX ? opts->peaks : PEAKS_MAX;
+        size_t n = find_peaks(buf, plan->count / 2, opts->threshold, peaks,
+                              k);
+        return record_peaks(out, 0.0, res, peaks, n);
+    }
+    if (opts->binary) {
+        return record_bins(out, 0.0, res, buf, plan->count / 2);
+    }
+    if (opts->peaks > 0) {
+        return output_peaks(out, plan, sample_rate, buf, opts->peaks,
+                            opts->threshold);
+    }
+    return output_spectrum(out, plan, sample_rate, buf);
+}
+
+size_t
+output_zoom(FILE *out, const output_options_t *opts, const czt_plan_t *plan,
+            const double complex *buf)
+{
+    size_t bytes = 0;
+
+    if (opts->peaks > 0) {
+        peak_t peaks[PEAKS_MAX];
+        size_t k = opts->peaks < PEAKS_MAX ? opts->peaks : PEAKS_MAX;
+        size_t n = find_peaks(buf, plan->bins, opts->threshold, peaks, k);
+        if (opts->binary) {
+            return record_peaks(out, plan->f_lo, plan->step, peaks, n);
+        }
+        for (size_t i = 0; i < n; i++) {
+            bytes += count(fprintf(out, "%f %f %f\n",
+                                   czt_freq(plan, peaks[i].bin),
+                                   peaks[i].magnitude, peaks[i].phase));
+        }
+        return bytes;
+    }
+
+    if (opts->binary) {
+        return record_bins(out, plan->f_lo, plan->step, buf, plan->bins);
+    }
+    for (size_t i = 0; i < plan->bins; i++) {
+        bytes += count(fprintf(out, "%f %f %f 0 0\n",
+                               czt_freq(plan, (double)i), cabs(buf[i]),
+                               carg(buf[i])));
+    }
+    return bytes;
+}
+
+size_t
+output_sparse(FILE *out, const output_options_t *opts,
+              const sparse_plan_t *plan, double sample_rate,
+              const sparse_coeff_t *coeffs, size_t n, int dense)
+{
+    double res = sample_rate / (double)plan->length;
+
+    if (opts->binary) {
+        size_t bytes = record(out, dense ? OUTPUT_DENSE : OUTPUT_SPARSE, n,
+                              0.0, 0.0);
+        for (size_t i = 0; i < n; i++) {
+            double row[3] = { res * coeffs[i].bin, cabs(coeffs[i].value),
+                              carg(coeffs[i].value) };
+            bytes += fwrite(row, sizeof(row), 1, out) * sizeof(row);
+        }
+        return bytes;
+    }
+
+    size_t bytes = count(fprintf(out, "# %s %zu\n",
+                                 dense ? "dense" : "sparse", n));
+
+    for (size_t i = 0; i < n; i++) {
+        bytes += count(fprintf(out, "%f %f %f\n", res * coeffs[i].bin,
+                               cabs(coeffs[i].value),
+                               carg(coeffs[i].value)));
+    }
+    return bytes;
+}
+
+size_t
+output_features(FILE *out, const output_options_t *opts,
+                const float *features, size_t n)
+{
+    if (opts->binary) {
+        size_t bytes = record(out, OUTPUT_FEATURES, n, 0.0, 0.0);
+        return bytes + fwrite(features, sizeof(float), n, out) * sizeof(float);
+    }
+    return output_coefficients(out, "mfcc", features, n);
+}
+
+size_t
+output_coefficients(FILE *out, const char *name, const float *coeffs,
+                    size_t n)
+{
+    size_t bytes = count(fprintf(out, "# %s %zu\n", name, n));
+    return bytes + fwrite(coeffs, sizeof(float), n, out) * sizeof(float);
+}
+
+size_t
+output_envelope(FILE *out, const float *pairs, size_t n)
+{
+    size_t bytes = count(fprintf(out, "# envelope %zu\n", n));
+    return bytes + fwrite(pairs, sizeof(float), 2 * n, out) * sizeof(float);
+}
+
+size_t
+output_planes(FILE *out, float *const *planes, size_t channels, size_t n)
+{
+    size_t bytes = count(fprintf(out, "# planes %zu %zu\n", channels, n));
+    for (size_t c = 0; c < channels; c++) {
+        bytes += fwrite(planes[c], sizeof(float), n, out) * sizeof(float);
+    }
+    return bytes;
+}
+
+/*
+ * Returns the size of the payload of a record, or 0 with *valid cleared
+ * if the kind is unknown.
+ */
+static size_t
+payload_size(const output_record_t *r, int *valid)
+{
+    *valid = 1;
+    switch (r->kind) {
+    case OUTPUT_TEXT:
+        return r->count;
+    case OUTPUT_BINS:
+        return sizeof(double) * 2 * (size_t)r->count;
+    case OUTPUT_ROWS:
+    case OUTPUT_SPARSE:
+    case OUTPUT_DENSE:
+        return sizeof(double) * 3 * (size_t)r->count;
+    case OUTPUT_FEATURES:
+        return sizeof(float) * (size_t)r->count;
+    case OUTPUT_BLOCK:
+        return 0;
+    default:
+        *valid = 0;
+        return 0;
+    }
+}
+
+/*
+ * Tells whether the records are well formed, so that a corrupt entry is
+ * refused before anything has been written.
+ */
+static int
+records_valid(const uint8_t *records, size_t length)
+{
+    size_t pos = 0;
+
+    while (pos < length) {
+        output_record_t r;
+        int valid;
+        if (length - pos < sizeof(r)) {
+            return 0;
+        }
+        memcpy(&r, records + pos, sizeof(r));
+        pos += sizeof(r);
+        size_t size = payload_size(&r, &valid);
+        if (!valid || size > length - pos) {
+            return 0;
+        }
+        pos += size;
+    }
+    return 1;
+}
+
+ssize_t
+output_replay(FILE *out, const uint8_t *records, size_t length)
+{
+    size_t bytes = 0;
+    size_t pos = 0;
+
+    if (!records_valid(records, length)) {
+        return -1;
+    }
+
+    while (pos < length) {
+        output_record_t r;
+        int valid;
+        memcpy(&r, records + pos, sizeof(r));
+        pos += sizeof(r);
+        size_t size = payload_size(&r, &valid);
+        const uint8_t *p = records + pos;
+        pos += size;
+
+        if (r.kind == OUTPUT_SPARSE || r.kind == OUTPUT_DENSE) {
+            bytes += count(fprintf(out, "# %s %" PRIu32 "\n",
+                                   r.kind == OUTPUT_DENSE ? "dense"
+                                                          : "sparse",
+                                   r.count));
+        }
+        switch (r.kind) {
+        case OUTPUT_TEXT:
+            bytes += fwrite(p, 1, size, out);
+            break;
+        case OUTPUT_BINS:
+            for (size_t i = 0; i < r.count; i++) {
+                double bin[2];
+                memcpy(bin, p + sizeof(bin) * i, sizeof(bin));
+                bytes += count(fprintf(out, "%f %f %f 0 0\n",
+                                       r.base + r.step * i, bin[0], bin[1]));
+            }
+            break;
+        case OUTPUT_ROWS:
+        case OUTPUT_SPARSE:
+        case OUTPUT_DENSE:
+            for (size_t i = 0; i < r.count; i++) {
+                double row[3];
+                memcpy(row, p + sizeof(row) * i, sizeof(row));
+                bytes += count(fprintf(out, "%f %f %f\n", row[0], row[1],
+                                       row[2]));
+            }
+            break;
+        case OUTPUT_FEATURES:
+            bytes += count(fprintf(out, "# mfcc %" PRIu32 "\n", r.count));
+            bytes += fwrite(p, 1, size, out);
+            break;
+        case OUTPUT_BLOCK:
+            bytes += count(fprintf(out, "# %" PRIu32 " samples read.\n"
+                                   "# %.0f samples to be processed.\n",
+                                   r.count, r.base));
+            break;
+        }
+    }
+
+    return bytes;
+}
@@ -0,0 +1,232 @@
+#ifndef FOURIER_OUTPUT_H
+#define FOURIER_OUTPUT_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <complex.h>
+#include <sys/types.h>
+#include "wave.h"
+#include "transform.h"
+#include "czt.h"
+#include "sparse.h"
+
+typedef struct output_options
+{
+    /**
+     * The number of peaks to be written instead of the full spectrum, or
+     * 0 for the full spectrum.
+     */
+    size_t peaks;
+
+    /**
+     * The minimum magnitude of a peak.
+     */
+    double threshold;
+
+    /**
+     * The number of mel filters and cepstral coefficients to be written
+     * instead of the spectrum, or 0 for the spectrum.
+     */
+    size_t mels;
+    size_t coeffs;
+
+    /**
+     * Write binary records instead of the text, to be formatted later by
+     * output_replay().
+     */
+    int binary;
+} output_options_t;
+
+/**
+ * The kinds of binary records.
+ */
+enum output_kind
+{
+    /* count bytes of text */
+    OUTPUT_TEXT,
+
+    /* count pairs of double magnitude and phase, at base + step * i Hz */
+    OUTPUT_BINS,
+
+    /* count triples of double frequency, magnitude and phase */
+    OUTPUT_ROWS,
+
+    /* the same after a comment line "# sparse <n>" or "# dense <n>" */
+    OUTPUT_SPARSE,
+    OUTPUT_DENSE,
+
+    /* count float32 features after a comment line "# mfcc <n>" */
+    OUTPUT_FEATURES,
+
+    /* the comment lines of a block of count bytes and base samples */
+    OUTPUT_BLOCK
+};
+
+/**
+ * The header of a binary record, followed by its payload.
+ *
+ * The records hold the results rather than their text, about half of its
+ * size for full spectra.  They keep the doubles the text is formatted
+ * from, hence a replay writes the very bytes of the text written
+ * directly.
+ */
+typedef struct output_record
+{
+    uint32_t kind;
+    uint32_t count;
+    double base;
+    double step;
+} output_record_t;
+
+/**
+ * Writes a comment line or any text, as a record if the options ask for
+ * binary records.
+ *
+ * @param out   the output stream.
+ * @param opts  the options, or NULL for text.
+ * @param fmt   the format of printf().
+ */
+size_t output_text(FILE *out, const output_options_t *opts, const char *fmt,
+                   ...);
+
+/**
+ * Writes the comment lines telling the size of a block read, in bytes
+ * and in samples.
+ *
+ * @param out       the output stream.
+ * @param opts      the options.
+ * @param bytes     the bytes read.
+ * @param samples   the samples to be processed.
+ */
+size_t output_block(FILE *out, const output_options_t *opts, size_t bytes,
+                    size_t samples);
+
+/**
+ * Writes the format of the wave file as comment lines.
+ *
+ * @param out   the output stream.
+ * @param opts  the options, or NULL for text.
+ * @param h     the handle of the wave file.
+ */
+void output_header(FILE *out, const output_options_t *opts,
+                   wave_handle_t *h);
+
+/**
+ * Writes the first half of the spectrum, one bin per line.
+ *
+ * The writers return the number of bytes written.
+ *
+ * @param out           the output stream.
+ * @param plan          the plan used for the transform.
+ * @param sample_rate   the sampling rate of the transformed samples.
+ * @param buf           the result of the transform.
+ */
+size_t output_spectrum(FILE *out, const fft_plan_t *plan,
+                       double sample_rate, const double complex *buf);
+
+/**
+ * Writes the K strongest peaks of the spectrum, one per line, with the
+ * interpolated frequency, magnitude and phase.
+ *
+ * @param out           the output stream.
+ * @param plan          the plan used for the transform.
+ * @param sample_rate   the sampling rate of the transformed samples.
+ * @param buf           the result of the transform.
+ * @param k             the maximum number of peaks.
+ * @param threshold     the minimum magnitude of a peak.
+ */
+size_t output_peaks(FILE *out, const fft_plan_t *plan, double sample_rate,
+                    const double complex *buf, size_t k, double threshold);
+
+/**
+ * Writes the result of the transform as selected by the options.
+ */
+size_t output_result(FILE *out, const output_options_t *opts,
+                     const fft_plan_t *plan, double sample_rate,
+                     const double complex *buf);
+
+/**
+ * Writes the bins of a zoomed band, or its peaks, as selected by the
+ * options.
+ */
+size_t output_zoom(FILE *out, const output_options_t *opts,
+                   const czt_plan_t *plan, const double complex *buf);
+
+/**
+ * Writes the bins recovered by the sparse transform, one per line, with
+ * the frequency, magnitude and phase, after a comment line "# sparse <n>"
+ * or "# dense <n>" telling whether the full transform has been computed.
+ *
+ * @param out           the output stream.
+ * @param opts          the options.
+ * @param plan          the plan used for the transform.
+ * @param sample_rate   the sampling rate of the transformed samples.
+ * @param coeffs        the bins.
+ * @param n             the number of bins.
+ * @param dense         whether the full transform has been computed.
+ */
+size_t output_sparse(FILE *out, const output_options_t *opts,
+                     const sparse_plan_t *plan, double sample_rate,
+                     const sparse_coeff_t *coeffs, size_t n, int dense);
+
+/**
+ * Writes the features of a frame as a comment line "# mfcc <n>" followed
+ * by n native float32 values, so that a consumer can read the matrix
+ * without parsing text.
+ *
+ * @param out       the output stream.
+ * @param opts      the options.
+ * @param features  the features.
+ * @param n         the number of features.
+ */
+size_t output_features(FILE *out, const output_options_t *opts,
+                       const float *features, size_t n);
+
+/**
+ * Writes the coefficients of a frame as a comment line "# <name> <n>"
+ * followed by n native float32 values.
+ *
+ * @param out       the output stream.
+ * @param name      the name of the transform.
+ * @param coeffs    the coefficients.
+ * @param n         the number of coefficients.
+ */
+size_t output_coefficients(FILE *out, const char *name, const float *coeffs,
+                           size_t n);
+
+/**
+ * Writes a block of the analytic signal as a comment line
+ * "# envelope <n>" followed by n pairs of native float32 values, the
+ * envelope and the instantaneous frequency in Hz of each sample.
+ *
+ * @param out       the output stream.
+ * @param pairs     the interleaved envelope and frequency.
+ * @param n         the number of samples.
+ */
+size_t output_envelope(FILE *out, const float *pairs, size_t n);
+
+/**
+ * Writes a block of deinterleaved samples as a comment line
+ * "# planes <channels> <n>" followed by the n native float32 values of
+ * each channel in turn.
+ *
+ * @param out       the output stream.
+ * @param planes    the samples of each channel.
+ * @param channels  the number of channels.
+ * @param n         the number of samples per channel.
+ */
+size_t output_planes(FILE *out, float *const *planes, size_t channels,
+                     size_t n);
+
+/**
+ * Formats binary records as the text they stand for.
+ *
+ * @param out       the output stream.
+ * @param records   the records, which need not be aligned.
+ * @param length    the size of the records in bytes.
+ * @return          the number of bytes written, -1 if the records are
+ *                  malformed, in which case nothing is written.
+ */
+ssize_t output_replay(FILE *out, const uint8_t *records, size_t length);
+
+#endif /* FOURIER_OUTPUT_H */
@@ -0,0 +1,124 @@
+/**
+ * Peak picking with sub-bin interpolation
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include <complex.h>
+#include "peaks.h"
+
+/*
+ * The heap is ordered by the magnitude of the bins, which is all that is
+ * known about a candidate until it has survived the selection.
+ */
+static void
+sift_down(peak_t *heap, size_t n, size_t i)
+{
+    for (;;) {
+        size_t min = i;
+        size_t l = 2 * i + 1;
+        size_t r = l + 1;
+        if (l < n && heap[l].magnitude < heap[min].magnitude) {
+            min = l;
+        }
+        if (r < n && heap[r].magnitude < heap[min].magnitude) {
+            min = r;
+        }
+        if (min == i) {
+            break;
+        }
+        peak_t tmp = heap[i];
+        heap[i] = heap[min];
+        heap[min] = tmp;
+        i = min;
+    }
+}
+
+static void
+sift_up(peak_t *heap, size_t i)
+{
+    while (i > 0) {
+        size_t parent = (i - 1) / 2;
+        if (heap[parent].magnitude <= heap[i].magnitude) {
+            break;
+        }
+        peak_t tmp = heap[i];
+        heap[i] = heap[parent];
+        heap[parent] = tmp;
+        i = parent;
+    }
+}
+
+/*
+ * Fits a parabola to the log-magnitudes around the bin.
+ */
+static void
+interpolate(const double complex *buf, size_t nbins, peak_t *p)
+{
+    size_t i = (size_t)p->bin;
+
+    p->phase = carg(buf[i]);
+    if (i == 0 || i + 1 >= nbins) {
+        return;
+    }
+
+    double a = log(cabs(buf[i - 1]) + 1e-300);
+    double b = log(p->magnitude);
+    double c = log(cabs(buf[i + 1]) + 1e-300);
+    double d = a - 2.0 * b + c;
+    if (d >= 0.0) {
+        return;
+    }
+
+    double delta = 0.5 * (a - c) / d;
+    p->bin = (double)i + delta;
+    p->magnitude = exp(b - 0.25 * (a - c) * delta);
+}
+
+static int
+compare_peaks(const void *a, const void *b)
+{
+    double ma = ((const peak_t *)a)->magnitude;
+    double mb = ((const peak_t *)b)->magnitude;
+    return (ma < mb) - (ma > mb);
+}
+
+size_t
+find_peaks(const double complex *buf, size_t nbins, double threshold,
+           peak_t *peaks, size_t k)
+{
+    size_t n = 0;
+
+    if (k == 0 || nbins < 3) {
+        return 0;
+    }
+
+    double prev = cabs(buf[0]);
+    double cur = cabs(buf[1]);
+    for (size_t i = 1; i + 1 < nbins; i++) {
+        double next = cabs(buf[i + 1]);
+
+        if (cur > threshold && cur > prev && cur >= next) {
+            if (n < k) {
+                peaks[n].bin = (double)i;
+                peaks[n].magnitude = cur;
+                sift_up(peaks, n++);
+            }
+            else if (cur > peaks[0].magnitude) {
+                peaks[0].bin = (double)i;
+                peaks[0].magnitude = cur;
+                sift_down(peaks, n, 0);
+            }
+        }
+
+        prev = cur;
+        cur = next;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        interpolate(buf, nbins, &peaks[i]);
+    }
+    qsort(peaks, n, sizeof(peak_t), compare_peaks);
+
+    return n;
+}
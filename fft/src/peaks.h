@@ -0,0 +1,48 @@
+#ifndef FOURIER_PEAKS_H
+#define FOURIER_PEAKS_H
+
+#include <stdlib.h>
+#include <complex.h>
+
+/**
+ * The maximum number of peaks picked from a spectrum.
+ */
+#define PEAKS_MAX   1024
+
+typedef struct peak
+{
+    /**
+     * The interpolated position of the peak in bins.
+     */
+    double bin;
+
+    /**
+     * The interpolated magnitude of the peak.
+     */
+    double magnitude;
+
+    /**
+     * The phase of the nearest bin.
+     */
+    double phase;
+} peak_t;
+
+/**
+ * Picks the K largest local maxima of the magnitude spectrum.
+ *
+ * The candidates are selected with a bounded min-heap, so only the K
+ * survivors are ever ordered.  Each of them is refined by fitting a
+ * parabola to the log-magnitudes of the bin and its neighbours.
+ *
+ * @param buf       the result of the transform.
+ * @param nbins     the number of bins to be searched.
+ * @param threshold the minimum magnitude of a peak.
+ * @param peaks     the array of k peaks to be filled.
+ * @param k         the maximum number of peaks.
+ * @return          the number of peaks found, sorted by decreasing
+ *                  magnitude.
+ */
+size_t find_peaks(const double complex *buf, size_t nbins, double threshold,
+                  peak_t *peaks, size_t k);
+
+#endif /* FOURIER_PEAKS_H */
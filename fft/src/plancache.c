@@ -0,0 +1,67 @@
+/**
+ * Cache of FFT plans shared between threads
+ */
+
+#include <stdlib.h>
+#include <pthread.h>
+#include "plancache.h"
+
+void
+plan_cache_init(plan_cache_t *cache)
+{
+    cache->entries = NULL;
+    pthread_mutex_init(&cache->lock, NULL);
+}
+
+void
+plan_cache_destroy(plan_cache_t *cache)
+{
+    plan_entry_t *e = cache->entries;
+    while (e != NULL) {
+        plan_entry_t *next = e->next;
+        workspace_destroy(e->ws);
+        free(e);
+        e = next;
+    }
+    cache->entries = NULL;
+    pthread_mutex_destroy(&cache->lock);
+}
+
+const fft_plan_t *
+plan_cache_get(plan_cache_t *cache, size_t count)
+{
+    plan_entry_t *e;
+
+    pthread_mutex_lock(&cache->lock);
+    for (e = cache->entries; e != NULL; e = e->next) {
+        if (e->plan.count == count) {
+            goto exit;
+        }
+    }
+
+    e = malloc(sizeof(plan_entry_t));
+    if (e == NULL) {
+        goto exit;
+    }
+
+    e->ws = workspace_create(fft_plan_size(count), 0);
+    if (e->ws == NULL) {
+        free(e);
+        e = NULL;
+        goto exit;
+    }
+
+    if (fft_plan_init(&e->plan, count, e->ws) < 0) {
+        workspace_destroy(e->ws);
+        free(e);
+        e = NULL;
+        goto exit;
+    }
+
+    e->next = cache->entries;
+    cache->entries = e;
+
+exit:
+    pthread_mutex_unlock(&cache->lock);
+    return e != NULL ? &e->plan : NULL;
+}
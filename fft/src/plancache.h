@@ -0,0 +1,48 @@
+#ifndef FOURIER_PLANCACHE_H
+#define FOURIER_PLANCACHE_H
+
+#include <stdlib.h>
+#include <pthread.h>
+#include "transform.h"
+#include "workspace.h"
+
+typedef struct plan_entry
+{
+    fft_plan_t plan;
+    workspace_t *ws;
+    struct plan_entry *next;
+} plan_entry_t;
+
+/**
+ * Plans shared between threads, one per size.
+ *
+ * A plan is created on the first request for its size and stays until
+ * the cache is destroyed.  The plans are read-only, hence the threads use
+ * them without further locking.
+ */
+typedef struct plan_cache
+{
+    plan_entry_t *entries;
+    pthread_mutex_t lock;
+} plan_cache_t;
+
+/**
+ * Initializes an empty cache.
+ */
+void plan_cache_init(plan_cache_t *cache);
+
+/**
+ * Releases all the plans in the cache.
+ */
+void plan_cache_destroy(plan_cache_t *cache);
+
+/**
+ * Returns the plan for the given count of samples, creating it if needed.
+ *
+ * @param cache the cache.
+ * @param count the number of samples.
+ * @return      the plan or NULL if it cannot be created.
+ */
+const fft_plan_t *plan_cache_get(plan_cache_t *cache, size_t count);
+
+#endif /* FOURIER_PLANCACHE_H */
@@ -0,0 +1,159 @@
+/**
+ * Work-stealing thread pool
+ */
+
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "pool.h"
+
+/*
+ * The queue of a worker.  The tasks of a queue are the contiguous range
+ * [front, back); the owner pops from the back and thieves from the front.
+ */
+typedef struct pool_queue
+{
+    size_t front;
+    size_t back;
+    pthread_mutex_t lock;
+} pool_queue_t;
+
+typedef struct pool
+{
+    size_t nthreads;
+    pool_queue_t *queues;
+    pool_task_t fn;
+    void *arg;
+} pool_t;
+
+typedef struct pool_worker
+{
+    pool_t *pool;
+    size_t id;
+} pool_worker_t;
+
+size_t
+pool_ncpus(void)
+{
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (size_t)n : 1;
+}
+
+static int
+pop(pool_queue_t *q, size_t *task)
+{
+    int found = 0;
+
+    pthread_mutex_lock(&q->lock);
+    if (q->front < q->back) {
+        *task = --q->back;
+        found = 1;
+    }
+    pthread_mutex_unlock(&q->lock);
+
+    return found;
+}
+
+static int
+steal(pool_queue_t *q, size_t *task)
+{
+    int found = 0;
+
+    pthread_mutex_lock(&q->lock);
+    if (q->front < q->back) {
+        *task = q->front++;
+        found = 1;
+    }
+    pthread_mutex_unlock(&q->lock);
+
+    return found;
+}
+
+static void *
+work(void *arg)
+{
+    pool_worker_t *w = arg;
+    pool_t *p = w->pool;
+    size_t task;
+
+    for (;;) {
+        if (pop(&p->queues[w->id], &task)) {
+            p->fn(task, w->id, p->arg);
+            continue;
+        }
+
+        /*
+         * No task is ever added once the pool has started, so a round
+         * over all the queues without a steal means that the work is
+         * done.
+         */
+        int stolen = 0;
+        for (size_t i = 1; i < p->nthreads && !stolen; i++) {
+            size_t victim = (w->id + i) % p->nthreads;
+            stolen = steal(&p->queues[victim], &task);
+        }
+        if (!stolen) {
+            break;
+        }
+        p->fn(task, w->id, p->arg);
+    }
+
+    return NULL;
+}
+
+int
+pool_run(size_t ntasks, size_t nthreads, pool_task_t fn, void *arg)
+{
+    int ret = -1;
+
+    if (nthreads == 0) {
+        nthreads = pool_ncpus();
+    }
+    if (nthreads > ntasks) {
+        nthreads = ntasks > 0 ? ntasks : 1;
+    }
+
+    pool_t pool = { nthreads, NULL, fn, arg };
+    pool.queues = malloc(sizeof(pool_queue_t) * nthreads);
+    pool_worker_t *workers = malloc(sizeof(pool_worker_t) * nthreads);
+    pthread_t *threads = malloc(sizeof(pthread_t) * nthreads);
+    if (pool.queues == NULL || workers == NULL || threads == NULL) {
+        goto exit;
+    }
+
+    for (size_t i = 0; i < nthreads; i++) {
+        pool.queues[i].front = ntasks * i / nthreads;
+        pool.queues[i].back = ntasks * (i + 1) / nthreads;
+        pthread_mutex_init(&pool.queues[i].lock, NULL);
+        workers[i].pool = &pool;
+        workers[i].id = i;
+    }
+
+    /* The calling thread serves as the first worker. */
+    size_t started;
+    for (started = 1; started < nthreads; started++) {
+        if (pthread_create(&threads[started], NULL, work,
+                           &workers[started]) != 0) {
+            break;
+        }
+    }
+    work(&workers[0]);
+    for (size_t i = 1; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    /*
+     * If some workers could not be started, their queues have been
+     * drained by stealing.
+     */
+    for (size_t i = 0; i < nthreads; i++) {
+        pthread_mutex_destroy(&pool.queues[i].lock);
+    }
+    ret = 0;
+
+exit:
+    free(threads);
+    free(workers);
+    free(pool.queues);
+    return ret;
+}
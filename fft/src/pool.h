@@ -0,0 +1,37 @@
+#ifndef FOURIER_POOL_H
+#define FOURIER_POOL_H
+
+#include <stdlib.h>
+
+/**
+ * A task run by the pool.
+ *
+ * @param task      the index of the task.
+ * @param worker    the index of the worker running the task.
+ * @param arg       the argument given to pool_run().
+ */
+typedef void (*pool_task_t)(size_t task, size_t worker, void *arg);
+
+/**
+ * Runs the tasks 0..ntasks-1 on a work-stealing thread pool and waits for
+ * all of them.
+ *
+ * The tasks are dealt to the workers in contiguous ranges.  A worker takes
+ * its own tasks from the back of its queue and, once the queue is empty,
+ * steals from the front of the queues of the others, so that the load is
+ * balanced even if the cost of the tasks varies a lot.
+ *
+ * @param ntasks    the number of tasks.
+ * @param nthreads  the number of workers, 0 for the number of CPUs.
+ * @param fn        the task.
+ * @param arg       the argument passed to the task.
+ * @return          0 on success, -1 if the workers cannot be started.
+ */
+int pool_run(size_t ntasks, size_t nthreads, pool_task_t fn, void *arg);
+
+/**
+ * Returns the number of online CPUs.
+ */
+size_t pool_ncpus(void);
+
+#endif /* FOURIER_POOL_H */
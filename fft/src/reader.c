@@ -0,0 +1,176 @@
+/**
+ * Double-buffered asynchronous reader of wave files
+ */
+
+#include <stdlib.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "reader.h"
+
+size_t
+wave_reader_size(size_t bufsize, size_t depth)
+{
+    return workspace_align(sizeof(wave_read_buffer_t) * depth)
+         + workspace_align(sizeof(ssize_t) * depth)
+         + workspace_align(bufsize) * depth;
+}
+
+static void *
+prefetch(void *arg)
+{
+    wave_reader_t *r = arg;
+
+    pthread_mutex_lock(&r->lock);
+    while (!r->stop) {
+        if (r->filled == r->depth) {
+            pthread_cond_wait(&r->cond, &r->lock);
+            continue;
+        }
+
+        /* The slot at the head is not visible to the caller yet. */
+        size_t slot = r->head;
+        pthread_mutex_unlock(&r->lock);
+
+        ssize_t len = wave_rawread(r->handle, &r->bufs[slot]);
+
+        pthread_mutex_lock(&r->lock);
+        r->lengths[slot] = len;
+        r->head = (slot + 1) % r->depth;
+        r->filled++;
+        pthread_cond_broadcast(&r->cond);
+
+        if (len <= 0) {
+            r->eof = 1;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&r->lock);
+
+    return NULL;
+}
+
+int
+wave_reader_start(wave_reader_t *r, wave_handle_t *h, size_t bufsize,
+                  size_t depth, workspace_t *ws)
+{
+    if (depth == 0) {
+        depth = 1;
+    }
+
+    r->handle = h;
+    r->depth = depth;
+    r->head = 0;
+    r->tail = 0;
+    r->filled = 0;
+    r->eof = 0;
+    r->stop = 0;
+
+    r->bufs = workspace_get(ws, sizeof(wave_read_buffer_t) * depth);
+    r->lengths = workspace_get(ws, sizeof(ssize_t) * depth);
+    if (r->bufs == NULL || r->lengths == NULL) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < depth; i++) {
+        uint8_t *body = workspace_get(ws, bufsize);
+        if (body == NULL) {
+            return -1;
+        }
+        wave_init_read_buffer(&r->bufs[i], body, bufsize);
+    }
+
+    if (depth < 2) {
+        return 0;
+    }
+
+    /* Fall back to reading on the caller's thread on failure. */
+    if (pipe(r->wakeup) < 0) {
+        r->depth = 1;
+        return 0;
+    }
+    h->interrupt = r->wakeup[0];
+
+    pthread_mutex_init(&r->lock, NULL);
+    pthread_cond_init(&r->cond, NULL);
+    if (pthread_create(&r->thread, NULL, prefetch, r) != 0) {
+        pthread_cond_destroy(&r->cond);
+        pthread_mutex_destroy(&r->lock);
+        h->interrupt = -1;
+        close(r->wakeup[0]);
+        close(r->wakeup[1]);
+        r->depth = 1;
+    }
+
+    return 0;
+}
+
+ssize_t
+wave_reader_next(wave_reader_t *r, wave_read_buffer_t **buf)
+{
+    ssize_t len;
+
+    if (r->depth < 2) {
+        *buf = &r->bufs[0];
+        return wave_rawread(r->handle, *buf);
+    }
+
+    pthread_mutex_lock(&r->lock);
+    while (r->filled == 0 && !r->eof) {
+        pthread_cond_wait(&r->cond, &r->lock);
+    }
+    if (r->filled == 0) {
+        /* The block at the end of the file has been released already. */
+        pthread_mutex_unlock(&r->lock);
+        *buf = NULL;
+        return 0;
+    }
+    *buf = &r->bufs[r->tail];
+    len = r->lengths[r->tail];
+    pthread_mutex_unlock(&r->lock);
+
+    return len;
+}
+
+void
+wave_reader_release(wave_reader_t *r)
+{
+    if (r->depth < 2) {
+        return;
+    }
+
+    pthread_mutex_lock(&r->lock);
+    if (r->filled > 0) {
+        r->tail = (r->tail + 1) % r->depth;
+        r->filled--;
+        pthread_cond_broadcast(&r->cond);
+    }
+    pthread_mutex_unlock(&r->lock);
+}
+
+void
+wave_reader_stop(wave_reader_t *r)
+{
+    if (r->depth < 2) {
+        return;
+    }
+
+    pthread_mutex_lock(&r->lock);
+    r->stop = 1;
+    pthread_cond_broadcast(&r->cond);
+    pthread_mutex_unlock(&r->lock);
+
+    /* The thread may wait for a writer which never comes. */
+    char c = 0;
+    ssize_t sz;
+    do {
+        sz = write(r->wakeup[1], &c, sizeof(c));
+    } while (sz < 0 && errno == EINTR);
+
+    pthread_join(r->thread, NULL);
+    pthread_cond_destroy(&r->cond);
+    pthread_mutex_destroy(&r->lock);
+    r->handle->interrupt = -1;
+    close(r->wakeup[0]);
+    close(r->wakeup[1]);
+}
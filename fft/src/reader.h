@@ -0,0 +1,126 @@
+#ifndef FOURIER_READER_H
+#define FOURIER_READER_H
+
+#include <stdlib.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include "wave.h"
+#include "workspace.h"
+
+/**
+ * The default number of buffers in the ring of an asynchronous reader.
+ */
+#define WAVE_READER_DEPTH   3
+
+/**
+ * A reader which prefetches blocks of a wave file into a ring of buffers.
+ *
+ * With a depth of 2 or more, a background thread keeps reading the next
+ * blocks while the caller processes the current one.  With a depth of 1
+ * the blocks are read synchronously on the caller's thread.
+ */
+typedef struct wave_reader
+{
+    /**
+     * The handle of the wave file.
+     */
+    wave_handle_t *handle;
+
+    /**
+     * The number of buffers in the ring.
+     */
+    size_t depth;
+
+    /**
+     * The ring of buffers.
+     */
+    wave_read_buffer_t *bufs;
+
+    /**
+     * The number of bytes read into each buffer.
+     */
+    ssize_t *lengths;
+
+    /**
+     * The buffer to be filled next by the background thread.
+     */
+    size_t head;
+
+    /**
+     * The buffer to be handed to the caller next.
+     */
+    size_t tail;
+
+    /**
+     * The number of buffers filled and not released yet.
+     */
+    size_t filled;
+
+    /**
+     * Set when the background thread has hit the end of the file or an
+     * error.
+     */
+    int eof;
+
+    /**
+     * Set when the caller asks the background thread to quit.
+     */
+    int stop;
+
+    /**
+     * The pipe written by wave_reader_stop() to interrupt a read of the
+     * background thread blocked on a pipe or a followed file.
+     */
+    int wakeup[2];
+
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+} wave_reader_t;
+
+/**
+ * Returns the size of the workspace needed for the ring.
+ *
+ * @param bufsize   the size of a buffer in bytes.
+ * @param depth     the number of buffers.
+ */
+size_t wave_reader_size(size_t bufsize, size_t depth);
+
+/**
+ * Initializes the reader and starts prefetching.
+ *
+ * @param r         the reader.
+ * @param h         the handle of the wave file.
+ * @param bufsize   the size of a buffer in bytes.
+ * @param depth     the number of buffers.
+ * @param ws        the workspace with at least wave_reader_size() bytes left.
+ * @return          0 on success, -1 on failure.
+ */
+int wave_reader_start(wave_reader_t *r, wave_handle_t *h, size_t bufsize,
+                      size_t depth, workspace_t *ws);
+
+/**
+ * Waits for the next block.
+ *
+ * The buffer belongs to the caller until wave_reader_release() is called.
+ *
+ * @param r     the reader.
+ * @param buf   set to the buffer holding the block.
+ * @return      the size of the block in bytes, 0 at the end of the file or
+ *              -1 on error.
+ */
+ssize_t wave_reader_next(wave_reader_t *r, wave_read_buffer_t **buf);
+
+/**
+ * Gives the buffer returned by the last wave_reader_next() back to the
+ * ring.
+ */
+void wave_reader_release(wave_reader_t *r);
+
+/**
+ * Stops prefetching and waits for the background thread, interrupting
+ * the read it may be blocked in.
+ */
+void wave_reader_stop(wave_reader_t *r);
+
+#endif /* FOURIER_READER_H */
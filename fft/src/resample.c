@@ -0,0 +1,218 @@
+/**
+ * Polyphase FIR resampler
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+#include "resample.h"
+
+#define KAISER_BETA     8.0
+#define CUTOFF_RATIO    0.9
+
+static size_t
+gcd(size_t a, size_t b)
+{
+    while (b != 0) {
+        size_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+/*
+ * Reduces the ratio of the rates and sizes the filter.
+ */
+static int
+factors(size_t in_rate, size_t out_rate, size_t *up, size_t *down,
+        size_t *taps)
+{
+    if (in_rate == 0 || out_rate == 0) {
+        return -1;
+    }
+
+    size_t g = gcd(in_rate, out_rate);
+    *up = out_rate / g;
+    *down = in_rate / g;
+    if (*up > RESAMPLER_MAX_UP) {
+        return -1;
+    }
+
+    /* The filter spans the zero crossings of the narrower band. */
+    size_t ratio = (*down + *up - 1) / *up;
+    *taps = 2 * RESAMPLER_ZEROS * (ratio > 1 ? ratio : 1);
+
+    return 0;
+}
+
+static inline size_t
+stride_of(size_t taps)
+{
+    /* Keep every phase aligned for the vector loads. */
+    return workspace_align(sizeof(double) * taps) / sizeof(double);
+}
+
+size_t
+resampler_size(size_t in_rate, size_t out_rate, size_t max_input)
+{
+    size_t up, down, taps;
+
+    if (factors(in_rate, out_rate, &up, &down, &taps) < 0) {
+        return 0;
+    }
+
+    return workspace_align(sizeof(double) * stride_of(taps) * up)
+         + workspace_align(sizeof(double) * (taps - 1 + max_input));
+}
+
+size_t
+resampler_max_output(size_t in_rate, size_t out_rate, size_t count)
+{
+    return (count * out_rate + in_rate - 1) / in_rate + 1;
+}
+
+/*
+ * Zeroth-order modified Bessel function of the first kind.
+ */
+static double
+bessel_i0(double x)
+{
+    double sum = 1.0;
+    double term = 1.0;
+    double q = x * x / 4.0;
+
+    for (int k = 1; k < 64; k++) {
+        term *= q / ((double)k * (double)k);
+        sum += term;
+        if (term < sum * 1e-17) {
+            break;
+        }
+    }
+    return sum;
+}
+
+int
+resampler_init(resampler_t *r, size_t in_rate, size_t out_rate,
+               size_t max_input, workspace_t *ws)
+{
+    if (factors(in_rate, out_rate, &r->up, &r->down, &r->taps) < 0) {
+        return -1;
+    }
+
+    r->stride = stride_of(r->taps);
+    r->max_input = max_input;
+    r->coeffs = workspace_get(ws, sizeof(double) * r->stride * r->up);
+    r->line = workspace_get(ws, sizeof(double) * (r->taps - 1 + max_input));
+    if (r->coeffs == NULL || r->line == NULL) {
+        return -1;
+    }
+
+    /*
+     * Kaiser-windowed sinc at the interpolated rate, cut off below the
+     * lower Nyquist frequency and scaled by up to make up for the zeros
+     * stuffed between the input samples.
+     */
+    size_t length = r->taps * r->up;
+    size_t wide = r->up > r->down ? r->up : r->down;
+    double fc = CUTOFF_RATIO * 0.5 / (double)wide;
+    double center = (double)(length - 1) / 2.0;
+    double norm = bessel_i0(KAISER_BETA);
+
+    memset(r->coeffs, 0, sizeof(double) * r->stride * r->up);
+    for (size_t n = 0; n < length; n++) {
+        double t = (double)n - center;
+        double x = 2.0 * fc * t;
+        double sinc = t == 0.0 ? 1.0 : sin(M_PI * x) / (M_PI * x);
+        double w = t / (center > 0.0 ? center : 1.0);
+        double kaiser = bessel_i0(KAISER_BETA * sqrt(fmax(0.0, 1.0 - w * w)))
+                      / norm;
+        double h = 2.0 * fc * sinc * kaiser * (double)r->up;
+
+        /* h[phase + k * up] multiplies the input k samples back. */
+        size_t phase = n % r->up;
+        size_t k = n / r->up;
+        r->coeffs[phase * r->stride + (r->taps - 1 - k)] = h;
+    }
+
+    memset(r->line, 0, sizeof(double) * (r->taps - 1));
+    r->pos = (r->taps - 1) * r->up;
+
+    return 0;
+}
+
+static inline double
+dot(const double *restrict a, const double *restrict b, size_t n)
+{
+    size_t i = 0;
+    double sum;
+
+#if defined(__AVX__)
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    for (; i + 8 <= n; i += 8) {
+#if defined(__FMA__)
+        acc0 = _mm256_fmadd_pd(_mm256_load_pd(a + i),
+                               _mm256_loadu_pd(b + i), acc0);
+        acc1 = _mm256_fmadd_pd(_mm256_load_pd(a + i + 4),
+                               _mm256_loadu_pd(b + i + 4), acc1);
+#else
+        acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(_mm256_load_pd(a + i),
+                                                 _mm256_loadu_pd(b + i)));
+        acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(_mm256_load_pd(a + i + 4),
+                                                 _mm256_loadu_pd(b + i + 4)));
+#endif
+    }
+    acc0 = _mm256_add_pd(acc0, acc1);
+    __m128d half = _mm_add_pd(_mm256_castpd256_pd128(acc0),
+                              _mm256_extractf128_pd(acc0, 1));
+    sum = _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+#elif defined(__SSE2__)
+    __m128d acc0 = _mm_setzero_pd();
+    __m128d acc1 = _mm_setzero_pd();
+    for (; i + 4 <= n; i += 4) {
+        acc0 = _mm_add_pd(acc0, _mm_mul_pd(_mm_load_pd(a + i),
+                                           _mm_loadu_pd(b + i)));
+        acc1 = _mm_add_pd(acc1, _mm_mul_pd(_mm_load_pd(a + i + 2),
+                                           _mm_loadu_pd(b + i + 2)));
+    }
+    acc0 = _mm_add_pd(acc0, acc1);
+    sum = _mm_cvtsd_f64(_mm_add_sd(acc0, _mm_unpackhi_pd(acc0, acc0)));
+#else
+    sum = 0.0;
+#endif
+
+    for (; i < n; i++) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+size_t
+resampler_run(resampler_t *r, const double *in, size_t count, double *out)
+{
+    size_t hist = r->taps - 1;
+    size_t n = 0;
+
+    if (count > r->max_input) {
+        count = r->max_input;
+    }
+    memcpy(r->line + hist, in, sizeof(double) * count);
+
+    /* An output needs the input at pos / up and the hist before it. */
+    size_t end = (hist + count) * r->up;
+    for (; r->pos < end; r->pos += r->down) {
+        size_t base = r->pos / r->up;
+        size_t phase = r->pos % r->up;
+        out[n++] = dot(r->coeffs + phase * r->stride, r->line + base - hist,
+                       r->taps);
+    }
+
+    r->pos -= count * r->up;
+    memmove(r->line, r->line + count, sizeof(double) * hist);
+
+    return n;
+}
@@ -0,0 +1,103 @@
+#ifndef FOURIER_RESAMPLE_H
+#define FOURIER_RESAMPLE_H
+
+#include <stdlib.h>
+#include "workspace.h"
+
+/**
+ * The number of zero crossings on each side of the low-pass filter.
+ */
+#define RESAMPLER_ZEROS     16
+
+/**
+ * The largest interpolation factor accepted after reducing the ratio of
+ * the rates.
+ */
+#define RESAMPLER_MAX_UP    1024
+
+/**
+ * Polyphase FIR resampler by a rational factor up / down.
+ *
+ * The input is low-passed below the lower of the two Nyquist frequencies,
+ * so that decimation does not alias.  Only the phases of the filter that
+ * hit an output sample are evaluated.  The state is kept between calls,
+ * hence a signal may be fed in blocks of any size up to the maximum given
+ * at initialization.
+ */
+typedef struct resampler
+{
+    /**
+     * The interpolation and the decimation factors.
+     */
+    size_t up;
+    size_t down;
+
+    /**
+     * The number of taps per phase.
+     */
+    size_t taps;
+
+    /**
+     * The distance between the phases in the table in doubles.
+     */
+    size_t stride;
+
+    /**
+     * The coefficients of the phases, reversed for the inner products.
+     */
+    double *coeffs;
+
+    /**
+     * The last taps - 1 input samples followed by the current block.
+     */
+    double *line;
+
+    /**
+     * The maximum number of input samples per call.
+     */
+    size_t max_input;
+
+    /**
+     * The position of the next output sample on the line at the
+     * interpolated rate.
+     */
+    size_t pos;
+} resampler_t;
+
+/**
+ * Returns the size of the workspace needed by the resampler.
+ *
+ * @param in_rate   the input rate in Hz.
+ * @param out_rate  the output rate in Hz.
+ * @param max_input the maximum number of input samples per call.
+ * @return          the size in bytes, 0 if the ratio is not supported.
+ */
+size_t resampler_size(size_t in_rate, size_t out_rate, size_t max_input);
+
+/**
+ * Initializes the resampler with the tables in the workspace.
+ *
+ * @return  0 on success, -1 on failure.
+ */
+int resampler_init(resampler_t *r, size_t in_rate, size_t out_rate,
+                   size_t max_input, workspace_t *ws);
+
+/**
+ * Returns the maximum number of output samples for the given number of
+ * input samples.
+ */
+size_t resampler_max_output(size_t in_rate, size_t out_rate, size_t count);
+
+/**
+ * Resamples a block of the signal.
+ *
+ * @param r     the resampler.
+ * @param in    the input samples.
+ * @param count the number of input samples, at most r->max_input.
+ * @param out   the output buffer of resampler_max_output() samples.
+ * @return      the number of output samples.
+ */
+size_t resampler_run(resampler_t *r, const double *in, size_t count,
+                     double *out);
+
+#endif /* FOURIER_RESAMPLE_H */
@@ -0,0 +1,532 @@
+/**
+ * Sparse Fourier Transform
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <complex.h>
+#include "sparse.h"
+
+/*
+ * The width of a bucket in bins is at least SPARSE_MIN_WIDTH and the edges
+ * of the filter are a Gaussian of a SPARSE_SHARPNESS-th of it.  The window
+ * is cut where the Gaussian falls below exp(-SPARSE_CUT^2 / 2).
+ */
+#define SPARSE_MIN_WIDTH    16
+#define SPARSE_SHARPNESS    8
+#define SPARSE_CUT          6.5
+
+#define SPARSE_SEED         0x2545f4914f6cdd1dULL
+
+/*
+ * The regions of the transform buffer.
+ */
+typedef struct sparse_buffer
+{
+    double complex *dense;
+    double *aliased;
+    double complex *spectra;
+    double *mag;
+    size_t *keys;
+    unsigned char *votes;
+    sparse_coeff_t *cands;
+} sparse_buffer_t;
+
+static uint64_t
+next_random(uint64_t *state)
+{
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 0x2545f4914f6cdd1dULL;
+}
+
+/*
+ * Chooses the buckets and the window for a transform of the given size, or
+ * leaves plan->buckets 0 if the sparse transform would read as many
+ * samples as the dense one.
+ */
+static void
+choose_layout(sparse_plan_t *plan)
+{
+    size_t n = plan->length;
+    size_t s = 2 * plan->k;
+
+    plan->buckets = 0;
+    if (n < 2 * SPARSE_MIN_WIDTH || s > n / SPARSE_MIN_WIDTH) {
+        return;
+    }
+
+    /* sqrt(N * K) buckets balance the samples and the votes. */
+    size_t b = (size_t)1 << ((to_exp(n * s - 1) + 1) / 2);
+    if (b > n / SPARSE_MIN_WIDTH) {
+        return;
+    }
+    size_t w = n / b;
+
+    double spread = (double)w / SPARSE_SHARPNESS;
+    double width = (double)n / (2.0 * M_PI * spread);
+    size_t half = (size_t)ceil(SPARSE_CUT * width / (double)b) * b;
+    if (SPARSE_LOOPS * 2 * half >= n) {
+        return;
+    }
+
+    plan->buckets = b;
+    plan->support = 2 * half;
+    plan->spread = spread;
+    plan->large = 2 * s < b ? 2 * s : b;
+    plan->slots = (size_t)1 << to_exp(2 * SPARSE_LOOPS * plan->large * w - 1);
+}
+
+size_t
+sparse_plan_size(size_t count, size_t k)
+{
+    sparse_plan_t plan;
+
+    plan.length = (size_t)1 << to_exp(count - 1);
+    plan.k = k;
+    choose_layout(&plan);
+
+    size_t size = fft_plan_size(count);
+    if (plan.buckets > 0) {
+        size += fft_plan_size(plan.buckets)
+              + workspace_align(sizeof(double) * plan.support);
+    }
+    return size;
+}
+
+size_t
+sparse_buffer_size(size_t count, size_t k)
+{
+    sparse_plan_t plan;
+
+    plan.length = (size_t)1 << to_exp(count - 1);
+    plan.k = k;
+    choose_layout(&plan);
+
+    size_t size = fft_buffer_size(count);
+    if (plan.buckets > 0) {
+        size += workspace_align(sizeof(double) * plan.buckets)
+              + workspace_align(sizeof(double complex) * plan.buckets *
+                                SPARSE_LOOPS)
+              + workspace_align(sizeof(double) * plan.buckets)
+              + workspace_align(sizeof(size_t) * plan.slots)
+              + workspace_align(plan.slots)
+              + workspace_align(sizeof(sparse_coeff_t) * plan.slots);
+    }
+    return size;
+}
+
+/*
+ * Carves the regions of sparse_buffer_size() out of the buffer.
+ */
+static void
+split_buffer(const sparse_plan_t *plan, void *buf, sparse_buffer_t *b)
+{
+    char *p = buf;
+
+    b->dense = (double complex *)p;
+    p += fft_buffer_size(plan->count);
+    if (plan->buckets == 0) {
+        return;
+    }
+    b->aliased = (double *)p;
+    p += workspace_align(sizeof(double) * plan->buckets);
+    b->spectra = (double complex *)p;
+    p += workspace_align(sizeof(double complex) * plan->buckets *
+                         SPARSE_LOOPS);
+    b->mag = (double *)p;
+    p += workspace_align(sizeof(double) * plan->buckets);
+    b->keys = (size_t *)p;
+    p += workspace_align(sizeof(size_t) * plan->slots);
+    b->votes = (unsigned char *)p;
+    p += workspace_align(plan->slots);
+    b->cands = (sparse_coeff_t *)p;
+}
+
+int
+sparse_plan_init(sparse_plan_t *plan, size_t count, size_t k,
+                 double tolerance, workspace_t *ws)
+{
+    if (k == 0) {
+        return -1;
+    }
+
+    plan->count = count;
+    plan->length = (size_t)1 << to_exp(count - 1);
+    plan->k = k < plan->length / 2 + 1 ? k : plan->length / 2 + 1;
+    plan->tolerance = tolerance;
+    plan->filter = NULL;
+    choose_layout(plan);
+
+    if (fft_plan_init(&plan->dense, count, ws) < 0) {
+        return -1;
+    }
+    if (plan->buckets == 0) {
+        return 0;
+    }
+    if (fft_plan_init(&plan->bucket, plan->buckets, ws) < 0) {
+        return -1;
+    }
+    plan->filter = workspace_get(ws, sizeof(double) * plan->support);
+    if (plan->filter == NULL) {
+        return -1;
+    }
+
+    /*
+     * A box of the width of a bucket in frequency, smoothed by a Gaussian
+     * so that the window is short in time.
+     */
+    double n = (double)plan->length;
+    double box = (double)(plan->length / plan->buckets + 1);
+    double width = n / (2.0 * M_PI * plan->spread);
+    long half = (long)plan->support / 2;
+    for (long i = -half; i < half; i++) {
+        double g = exp(-(double)(i * i) / (2.0 * width * width));
+        double d = i == 0 ? box / n
+                          : sin(M_PI * box * i / n) / (n * sin(M_PI * i / n));
+        plan->filter[i + half] = g * d;
+    }
+
+    uint64_t state = SPARSE_SEED;
+    size_t mask = plan->length - 1;
+    for (size_t l = 0; l < SPARSE_LOOPS; l++) {
+        size_t sigma = (next_random(&state) | 1) & mask;
+        /* Newton's iteration doubles the correct bits of the inverse. */
+        size_t inv = sigma;
+        for (int i = 0; i < 6; i++) {
+            inv *= 2 - sigma * inv;
+        }
+        plan->sigma[l] = sigma;
+        plan->inverse[l] = inv & mask;
+        plan->tau[l] = next_random(&state) & mask;
+    }
+    for (size_t i = 0; i < SPARSE_PROBES; i++) {
+        plan->probes[i] = next_random(&state) & mask;
+    }
+
+    return 0;
+}
+
+/*
+ * Returns the gain of the filter at d bins from the centre of a bucket.
+ */
+static double
+filter_gain(const sparse_plan_t *plan, double d)
+{
+    double h = (double)(plan->length / plan->buckets) / 2.0 + 0.5;
+    double s = M_SQRT2 * plan->spread;
+    return 0.5 * (erf((d + h) / s) - erf((d - h) / s));
+}
+
+/*
+ * Permutes, filters and aliases the samples into the buckets and
+ * transforms them.
+ */
+static void
+hash_to_buckets(const sparse_plan_t *plan, size_t l, const double *samples,
+                size_t count, double *aliased, double complex *spectrum)
+{
+    size_t mask = plan->length - 1;
+    size_t bmask = plan->buckets - 1;
+    size_t half = plan->support / 2;
+    size_t sigma = plan->sigma[l];
+    size_t index = (plan->tau[l] - sigma * half) & mask;
+
+    memset(aliased, 0, sizeof(double) * plan->buckets);
+    for (size_t i = 0; i < plan->support; i++) {
+        if (index < count) {
+            aliased[i & bmask] += samples[index] * plan->filter[i];
+        }
+        index = (index + sigma) & mask;
+    }
+
+    fft_execute(&plan->bucket, aliased, plan->buckets, spectrum);
+}
+
+static void
+swap(double *v, size_t i, size_t j)
+{
+    double t = v[i];
+    v[i] = v[j];
+    v[j] = t;
+}
+
+/*
+ * Returns the k-th largest of the values, which are reordered.
+ */
+static double
+select_largest(double *v, size_t n, size_t k)
+{
+    size_t lo = 0;
+    size_t hi = n;
+
+    for (;;) {
+        /* Larger values first, then the pivot, then the smaller ones. */
+        double pivot = v[lo + (hi - lo) / 2];
+        size_t lt = lo;
+        size_t gt = hi;
+        for (size_t i = lo; i < gt; ) {
+            if (v[i] > pivot) {
+                swap(v, lt++, i++);
+            }
+            else if (v[i] < pivot) {
+                swap(v, i, --gt);
+            }
+            else {
+                i++;
+            }
+        }
+        if (k - 1 < lt) {
+            hi = lt;
+        }
+        else if (k - 1 >= gt) {
+            lo = gt;
+        }
+        else {
+            return pivot;
+        }
+    }
+}
+
+/*
+ * Adds a vote for the bin and appends it to the candidates once a majority
+ * of the loops has voted for it.
+ */
+static void
+vote(const sparse_plan_t *plan, sparse_buffer_t *b, size_t bin,
+     size_t *ncands)
+{
+    size_t smask = plan->slots - 1;
+    size_t slot = (size_t)(((uint64_t)bin * 0x9e3779b97f4a7c15ULL) >>
+                           (64 - to_exp(smask)));
+
+    for (;; slot = (slot + 1) & smask) {
+        if (b->keys[slot] == 0) {
+            b->keys[slot] = bin + 1;
+            b->votes[slot] = 0;
+        }
+        if (b->keys[slot] == bin + 1) {
+            break;
+        }
+    }
+    if (++b->votes[slot] == SPARSE_LOOPS / 2 + 1) {
+        b->cands[(*ncands)++].bin = bin;
+    }
+}
+
+static void
+vote_large_buckets(const sparse_plan_t *plan, size_t l, sparse_buffer_t *b,
+                   size_t *ncands)
+{
+    const double complex *spectrum = b->spectra + l * plan->buckets;
+    size_t mask = plan->length - 1;
+    size_t w = plan->length / plan->buckets;
+
+    for (size_t i = 0; i < plan->buckets; i++) {
+        b->mag[i] = creal(spectrum[i]) * creal(spectrum[i])
+                  + cimag(spectrum[i]) * cimag(spectrum[i]);
+    }
+    double threshold = select_largest(b->mag, plan->buckets, plan->large);
+    if (threshold <= 0.0) {
+        return;
+    }
+
+    /* Every bin of a large bucket may be the one which made it large. */
+    size_t taken = 0;
+    for (int ties = 0; ties < 2; ties++) {
+        for (size_t i = 0; i < plan->buckets && taken < plan->large; i++) {
+            double m = creal(spectrum[i]) * creal(spectrum[i])
+                     + cimag(spectrum[i]) * cimag(spectrum[i]);
+            if (ties ? m != threshold : m <= threshold) {
+                continue;
+            }
+            taken++;
+            size_t first = i * w - w / 2;
+            for (size_t j = 0; j < w; j++) {
+                size_t bin = (plan->inverse[l] * (first + j)) & mask;
+                if (bin <= plan->length / 2) {
+                    vote(plan, b, bin, ncands);
+                }
+            }
+        }
+    }
+}
+
+static double
+median(double *v, size_t n)
+{
+    for (size_t i = 1; i < n; i++) {
+        double t = v[i];
+        size_t j = i;
+        for (; j > 0 && v[j - 1] > t; j--) {
+            v[j] = v[j - 1];
+        }
+        v[j] = t;
+    }
+    return v[n / 2];
+}
+
+/*
+ * Estimates a bin from the bucket it fell in, in every loop.
+ */
+static double complex
+estimate(const sparse_plan_t *plan, const sparse_buffer_t *b, size_t bin)
+{
+    double re[SPARSE_LOOPS];
+    double im[SPARSE_LOOPS];
+    size_t mask = plan->length - 1;
+    size_t w = plan->length / plan->buckets;
+    double n = (double)plan->length;
+
+    for (size_t l = 0; l < SPARSE_LOOPS; l++) {
+        size_t k = (plan->sigma[l] * bin) & mask;
+        size_t i = ((k + w / 2) / w) & (plan->buckets - 1);
+        size_t d = (k - i * w + plan->length / 2) & mask;
+        double gain = filter_gain(plan, (double)d - n / 2.0);
+
+        /* Undo the offset of the permutation. */
+        double a = 2.0 * M_PI * (double)((bin * plan->tau[l]) & mask) / n;
+        double complex v = b->spectra[l * plan->buckets + i] * n / gain
+                         * CMPLX(cos(a), sin(a));
+        re[l] = creal(v);
+        im[l] = cimag(v);
+    }
+
+    return CMPLX(median(re, SPARSE_LOOPS), median(im, SPARSE_LOOPS));
+}
+
+static int
+compare_coeffs(const void *a, const void *b)
+{
+    double ma = cabs(((const sparse_coeff_t *)a)->value);
+    double mb = cabs(((const sparse_coeff_t *)b)->value);
+    return ma < mb ? 1 : ma > mb ? -1 : 0;
+}
+
+/*
+ * Returns whether the coefficients reproduce the signal at the probes
+ * within the tolerance.
+ */
+static int
+check(const sparse_plan_t *plan, const double *samples, size_t count,
+      const sparse_coeff_t *coeffs, size_t n)
+{
+    size_t mask = plan->length - 1;
+    double len = (double)plan->length;
+    double energy = 0.0;
+    double error = 0.0;
+
+    for (size_t p = 0; p < SPARSE_PROBES; p++) {
+        size_t t = plan->probes[p];
+        double x = t < count ? samples[t] : 0.0;
+        double y = 0.0;
+
+        /* Each bin but 0 and N/2 stands for its conjugate as well. */
+        for (size_t i = 0; i < n; i++) {
+            size_t k = coeffs[i].bin;
+            double a = -2.0 * M_PI * (double)((k * t) & mask) / len;
+            double v = creal(coeffs[i].value) * cos(a)
+                     - cimag(coeffs[i].value) * sin(a);
+            y += k == 0 || k == plan->length / 2 ? v : 2.0 * v;
+        }
+        y /= len;
+
+        energy += x * x;
+        error += (x - y) * (x - y);
+    }
+
+    return error <= plan->tolerance * plan->tolerance * energy;
+}
+
+/*
+ * Keeps the k largest bins of the full spectrum.
+ */
+static size_t
+dense_largest(const sparse_plan_t *plan, const double *samples, size_t count,
+              double complex *buf, sparse_coeff_t *coeffs)
+{
+    size_t n = 0;
+
+    fft_execute(&plan->dense, samples, count, buf);
+
+    /* A min-heap of the k largest magnitudes seen so far. */
+    for (size_t bin = 0; bin <= plan->length / 2; bin++) {
+        double m = cabs(buf[bin]);
+        size_t i;
+        if (n < plan->k) {
+            i = n++;
+            for (; i > 0 && cabs(coeffs[(i - 1) / 2].value) > m;
+                 i = (i - 1) / 2) {
+                coeffs[i] = coeffs[(i - 1) / 2];
+            }
+        }
+        else if (m > cabs(coeffs[0].value)) {
+            i = 0;
+            for (;;) {
+                size_t c = 2 * i + 1;
+                if (c >= n) {
+                    break;
+                }
+                if (c + 1 < n &&
+                    cabs(coeffs[c + 1].value) < cabs(coeffs[c].value)) {
+                    c++;
+                }
+                if (cabs(coeffs[c].value) >= m) {
+                    break;
+                }
+                coeffs[i] = coeffs[c];
+                i = c;
+            }
+        }
+        else {
+            continue;
+        }
+        coeffs[i].bin = bin;
+        coeffs[i].value = buf[bin];
+    }
+
+    qsort(coeffs, n, sizeof(sparse_coeff_t), compare_coeffs);
+    return n;
+}
+
+size_t
+sparse_execute(const sparse_plan_t *plan, const double *samples,
+               size_t count, void *buf, sparse_coeff_t *coeffs, int *dense)
+{
+    sparse_buffer_t b;
+
+    if (count > plan->count) {
+        count = plan->count;
+    }
+    split_buffer(plan, buf, &b);
+
+    *dense = 1;
+    if (plan->buckets == 0) {
+        return dense_largest(plan, samples, count, b.dense, coeffs);
+    }
+
+    size_t ncands = 0;
+    memset(b.keys, 0, sizeof(size_t) * plan->slots);
+    for (size_t l = 0; l < SPARSE_LOOPS; l++) {
+        hash_to_buckets(plan, l, samples, count, b.aliased,
+                        b.spectra + l * plan->buckets);
+        vote_large_buckets(plan, l, &b, &ncands);
+    }
+
+    for (size_t i = 0; i < ncands; i++) {
+        b.cands[i].value = estimate(plan, &b, b.cands[i].bin);
+    }
+    qsort(b.cands, ncands, sizeof(sparse_coeff_t), compare_coeffs);
+
+    size_t n = ncands < plan->k ? ncands : plan->k;
+    memcpy(coeffs, b.cands, sizeof(sparse_coeff_t) * n);
+    if (!check(plan, samples, count, coeffs, n)) {
+        return dense_largest(plan, samples, count, b.dense, coeffs);
+    }
+
+    *dense = 0;
+    return n;
+}
@@ -0,0 +1,163 @@
+#ifndef FOURIER_SPARSE_H
+#define FOURIER_SPARSE_H
+
+#include <stdlib.h>
+#include <complex.h>
+#include "transform.h"
+#include "workspace.h"
+
+/**
+ * The number of random permutations the coefficients are hashed with.
+ * It is odd so that the median of the estimates is one of them.
+ */
+#define SPARSE_LOOPS        7
+
+/**
+ * The number of samples the recovered spectrum is checked against.
+ */
+#define SPARSE_PROBES       64
+
+/**
+ * The default relative RMS error beyond which the signal is not sparse.
+ */
+#define SPARSE_TOLERANCE    0.05
+
+/**
+ * One coefficient of the spectrum.
+ */
+typedef struct sparse_coeff
+{
+    size_t bin;
+    double complex value;
+} sparse_coeff_t;
+
+/**
+ * Sparse Fourier Transform recovering the K largest bins of a real signal.
+ *
+ * Every loop permutes the spectrum with a random odd stride, filters the
+ * samples with a flat window and aliases them into B buckets, so that a
+ * B-point transform computes the sums of the bins hashed to each bucket.
+ * The bins of the largest buckets get a vote; those voted by most loops
+ * are estimated by the median over the loops.  Only the samples under the
+ * window are read, about SPARSE_LOOPS * 18 * sqrt(N * K) of them.
+ *
+ * The result is checked against the signal at random samples, and the
+ * full transform is computed instead when the signal turns out not to be
+ * sparse, or when it is too short to gain anything.
+ */
+typedef struct sparse_plan
+{
+    /**
+     * The number of samples given to the transform.
+     */
+    size_t count;
+
+    /**
+     * The size of the transform.
+     */
+    size_t length;
+
+    /**
+     * The number of bins to be recovered, from 0 to length / 2.
+     */
+    size_t k;
+
+    /**
+     * The number of buckets, or 0 if the transform is always dense.
+     */
+    size_t buckets;
+
+    /**
+     * The number of samples under the window, a multiple of 2 * buckets.
+     */
+    size_t support;
+
+    /**
+     * The number of buckets voting in each loop.
+     */
+    size_t large;
+
+    /**
+     * The size of the table of votes, a power of 2.
+     */
+    size_t slots;
+
+    /**
+     * The standard deviation of the edges of the filter in bins.
+     */
+    double spread;
+
+    /**
+     * The largest relative RMS error of a sparse result.
+     */
+    double tolerance;
+
+    /**
+     * The window from -support / 2 to support / 2 - 1.
+     */
+    double *filter;
+
+    /**
+     * The stride, its inverse modulo length and the offset of each loop.
+     */
+    size_t sigma[SPARSE_LOOPS];
+    size_t inverse[SPARSE_LOOPS];
+    size_t tau[SPARSE_LOOPS];
+
+    /**
+     * The samples the result is checked against.
+     */
+    size_t probes[SPARSE_PROBES];
+
+    fft_plan_t bucket;
+    fft_plan_t dense;
+} sparse_plan_t;
+
+/**
+ * Returns the size of the workspace needed for the tables of a plan.
+ *
+ * @param count the number of samples.
+ * @param k     the number of bins.
+ */
+size_t sparse_plan_size(size_t count, size_t k);
+
+/**
+ * Returns the size of the workspace needed for a transform buffer.
+ *
+ * @param count the number of samples.
+ * @param k     the number of bins.
+ */
+size_t sparse_buffer_size(size_t count, size_t k);
+
+/**
+ * Initializes the plan with the tables in the workspace.
+ *
+ * @param plan      the plan.
+ * @param count     the number of samples.
+ * @param k         the number of bins.
+ * @param tolerance the largest relative RMS error of a sparse result.
+ * @param ws        the workspace with at least sparse_plan_size() bytes
+ *                  left.
+ * @return          0 on success, -1 on failure.
+ */
+int sparse_plan_init(sparse_plan_t *plan, size_t count, size_t k,
+                     double tolerance, workspace_t *ws);
+
+/**
+ * Recovers the largest bins of the spectrum.
+ *
+ * @param plan      the plan.
+ * @param samples   the signal samples.
+ * @param count     the count of samples.
+ * @param buf       the buffer of sparse_buffer_size() bytes.
+ * @param coeffs    the array of plan->k coefficients to be filled.
+ * @param dense     set to 1 if the full transform has been computed, to 0
+ *                  otherwise.
+ * @return          the number of coefficients found, sorted by decreasing
+ *                  magnitude.
+ */
+size_t sparse_execute(const sparse_plan_t *plan, const double *samples,
+                      size_t count, void *buf, sparse_coeff_t *coeffs,
+                      int *dense);
+
+#endif /* FOURIER_SPARSE_H */
@@ -0,0 +1,144 @@
+/**
+ * Per-stage timers and counters
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "stats.h"
+
+stats_t *stats_global = NULL;
+
+static const char *stage_names[STATS_NSTAGES] = {
+    "read", "decode", "resample", "sort", "butterfly", "output"
+};
+
+int
+stats_enable(size_t capacity)
+{
+    stats_t *s = calloc(1, sizeof(stats_t));
+    if (s == NULL) {
+        return -1;
+    }
+
+    s->capacity = capacity > 0 ? capacity : 1;
+    s->frames = malloc(sizeof(uint64_t) * STATS_NSTAGES * s->capacity);
+    if (s->frames == NULL) {
+        free(s);
+        return -1;
+    }
+
+    s->start = stats_now();
+    stats_global = s;
+
+    return 0;
+}
+
+void
+stats_disable(void)
+{
+    stats_t *s = stats_global;
+
+    stats_global = NULL;
+    if (s != NULL) {
+        free(s->frames);
+        free(s);
+    }
+}
+
+void
+stats_frame(void)
+{
+    stats_t *s = stats_global;
+
+    if (s == NULL) {
+        return;
+    }
+
+    uint64_t *slot = s->frames + STATS_NSTAGES * (s->nframes % s->capacity);
+    for (int i = 0; i < STATS_NSTAGES; i++) {
+        slot[i] = s->current[i];
+        s->total[i] += s->current[i];
+        s->current[i] = 0;
+    }
+    s->nframes++;
+}
+
+static int
+compare_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static uint64_t
+percentile(const uint64_t *sorted, size_t n, double p)
+{
+    if (n == 0) {
+        return 0;
+    }
+    size_t i = (size_t)(p * (double)(n - 1) + 0.5);
+    return sorted[i];
+}
+
+void
+stats_report(FILE *out)
+{
+    stats_t *s = stats_global;
+
+    if (s == NULL) {
+        return;
+    }
+
+    /* Time left in an unfinished frame still counts in the totals. */
+    for (int i = 0; i < STATS_NSTAGES; i++) {
+        s->total[i] += s->current[i];
+        s->current[i] = 0;
+    }
+
+    size_t n = s->nframes < s->capacity ? s->nframes : s->capacity;
+    uint64_t *column = malloc(sizeof(uint64_t) * (n > 0 ? n : 1));
+
+    fprintf(out, "{\n");
+    fprintf(out, "  \"frames\": %zu,\n", s->nframes);
+    fprintf(out, "  \"wall_ns\": %llu,\n",
+            (unsigned long long)(stats_now() - s->start));
+    fprintf(out, "  \"counters\": {\n");
+    fprintf(out, "    \"bytes_read\": %llu,\n",
+            (unsigned long long)s->bytes_read);
+    fprintf(out, "    \"samples_decoded\": %llu,\n",
+            (unsigned long long)s->samples_decoded);
+    fprintf(out, "    \"transforms\": %llu,\n",
+            (unsigned long long)s->transforms);
+    fprintf(out, "    \"butterflies\": %llu,\n",
+            (unsigned long long)s->butterflies);
+    fprintf(out, "    \"output_bytes\": %llu\n",
+            (unsigned long long)s->output_bytes);
+    fprintf(out, "  },\n");
+    fprintf(out, "  \"stages\": {\n");
+
+    for (int i = 0; i < STATS_NSTAGES; i++) {
+        size_t m = 0;
+        if (column != NULL) {
+            for (size_t f = 0; f < n; f++) {
+                column[m++] = s->frames[STATS_NSTAGES * f + i];
+            }
+            qsort(column, m, sizeof(uint64_t), compare_u64);
+        }
+
+        fprintf(out, "    \"%s\": { \"total_ns\": %llu, \"p50_ns\": %llu, "
+                     "\"p90_ns\": %llu, \"p99_ns\": %llu, \"max_ns\": %llu }%s\n",
+                stage_names[i], (unsigned long long)s->total[i],
+                (unsigned long long)percentile(column, m, 0.50),
+                (unsigned long long)percentile(column, m, 0.90),
+                (unsigned long long)percentile(column, m, 0.99),
+                (unsigned long long)(m > 0 ? column[m - 1] : 0),
+                i + 1 < STATS_NSTAGES ? "," : "");
+    }
+
+    fprintf(out, "  }\n");
+    fprintf(out, "}\n");
+
+    free(column);
+}
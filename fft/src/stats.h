@@ -0,0 +1,139 @@
+#ifndef FOURIER_STATS_H
+#define FOURIER_STATS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+
+/**
+ * The default number of frames whose timings are kept for the
+ * percentiles.  Older frames are only reflected in the totals.
+ */
+#define STATS_FRAMES    65536
+
+/**
+ * The stages of the pipeline.
+ */
+enum stats_stage
+{
+    STATS_READ,
+    STATS_DECODE,
+    STATS_RESAMPLE,
+    STATS_SORT,
+    STATS_BUTTERFLY,
+    STATS_OUTPUT,
+    STATS_NSTAGES
+};
+
+/**
+ * Timers and counters of the pipeline.
+ *
+ * The instrumentation is active only while stats_global is set, so that a
+ * disabled run pays a single test of a pointer per stage.  It is meant for
+ * the single-threaded pipeline; the times are taken on the calling thread.
+ */
+typedef struct stats
+{
+    uint64_t bytes_read;
+    uint64_t samples_decoded;
+    uint64_t transforms;
+    uint64_t butterflies;
+    uint64_t output_bytes;
+
+    /**
+     * The time spent in every stage in nanoseconds.
+     */
+    uint64_t total[STATS_NSTAGES];
+
+    /**
+     * The time spent in every stage for the current frame.
+     */
+    uint64_t current[STATS_NSTAGES];
+
+    /**
+     * The ring of per-frame times, STATS_NSTAGES per frame.
+     */
+    uint64_t *frames;
+    size_t capacity;
+
+    /**
+     * The number of frames completed.
+     */
+    size_t nframes;
+
+    /**
+     * The time at which the statistics have been enabled.
+     */
+    uint64_t start;
+} stats_t;
+
+/**
+ * The active statistics, or NULL if disabled.
+ */
+extern stats_t *stats_global;
+
+static inline uint64_t
+stats_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * Starts timing a stage.
+ *
+ * @return  the time stamp to be given to stats_end().
+ */
+static inline uint64_t
+stats_begin(void)
+{
+    return stats_global != NULL ? stats_now() : 0;
+}
+
+/**
+ * Charges the time since stats_begin() to the stage.
+ */
+static inline void
+stats_end(enum stats_stage stage, uint64_t t0)
+{
+    if (stats_global != NULL) {
+        stats_global->current[stage] += stats_now() - t0;
+    }
+}
+
+/**
+ * Adds to a counter, e.g. STATS_ADD(bytes_read, n).
+ */
+#define STATS_ADD(counter, n)                       \
+    do {                                            \
+        if (stats_global != NULL) {                 \
+            stats_global->counter += (n);           \
+        }                                           \
+    } while (0)
+
+/**
+ * Enables the statistics.
+ *
+ * @param capacity  the number of frames kept for the percentiles.
+ * @return          0 on success, -1 on failure.
+ */
+int stats_enable(size_t capacity);
+
+/**
+ * Disables the statistics and releases them.
+ */
+void stats_disable(void);
+
+/**
+ * Closes the current frame.
+ */
+void stats_frame(void);
+
+/**
+ * Writes the summary in JSON.
+ */
+void stats_report(FILE *out);
+
+#endif /* FOURIER_STATS_H */
@@ -0,0 +1,339 @@
+/**
+ * Radix-2 Fast Fourier Transform
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+#include <complex.h>
+#include "transform.h"
+#include "codelets.h"
+#include "stats.h"
+
+/*
+ * The stages run by a single leaf codelet over each block of the buffer.
+ */
+#define LEAF_STAGES 5
+
+static void
+init_index_table(size_t *table, size_t exp)
+{
+    size_t length = (size_t)1 << exp;
+
+    for (size_t i = 0; i < length; i++) {
+        size_t res = 0;
+        for (size_t b = 0; b < exp; b++) {
+            res |= ((i >> b) & 1) << (exp - b - 1);
+        }
+        table[i] = res;
+    }
+}
+
+size_t
+fft_plan_size(size_t count)
+{
+    size_t length = (size_t)1 << to_exp(count - 1);
+    return workspace_align(sizeof(size_t) * length);
+}
+
+size_t
+fft_buffer_size(size_t count)
+{
+    size_t length = (size_t)1 << to_exp(count - 1);
+    return workspace_align(sizeof(double complex) * length);
+}
+
+int
+fft_plan_init(fft_plan_t *plan, size_t count, workspace_t *ws)
+{
+    /*
+     * Expand and align the buffer size to power of 2, which is the
+     * precondition of FFT.
+     */
+    plan->count = count;
+    plan->exp = to_exp(count - 1);
+    plan->length = (size_t)1 << plan->exp;
+
+    plan->itable = workspace_get(ws, sizeof(size_t) * plan->length);
+    if (plan->itable == NULL) {
+        return -1;
+    }
+    init_index_table(plan->itable, plan->exp);
+
+    return 0;
+}
+
+/**
+ * Copies the given samples so that they are aligned for the butterfly
+ * calculation.
+ *
+ * @param plan      the plan.
+ * @param dest      the destination buffer.
+ * @param src       the original samples.
+ * @param window    the window applied to the samples, or NULL.
+ * @param count     the count of samples.
+ */
+static void
+copy_and_sort(const fft_plan_t *plan, double complex *dest, const double *src,
+              const double *window, size_t count)
+{
+    const size_t *itable = plan->itable;
+
+    if (plan->length < count) {
+        count = plan->length;
+    }
+
+    /* Sort the samples for the butterfly calculation. */
+    if (window != NULL) {
+        for (size_t i = 0; i < count; i++) {
+            dest[itable[i]] = src[i] * window[i];
+        }
+    }
+    else {
+        for (size_t i = 0; i < count; i++) {
+            dest[itable[i]] = src[i];
+        }
+    }
+    /* Pad the rest so that the buffer need not be cleared beforehand. */
+    for (size_t i = count; i < plan->length; i++) {
+        dest[itable[i]] = 0;
+    }
+}
+
+static void
+copy_and_sort_complex(const fft_plan_t *plan, double complex *dest,
+                      const double complex *src, size_t count)
+{
+    const size_t *itable = plan->itable;
+
+    if (plan->length < count) {
+        count = plan->length;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        dest[itable[i]] = src[i];
+    }
+    for (size_t i = count; i < plan->length; i++) {
+        dest[itable[i]] = 0;
+    }
+}
+
+void
+fft(double complex *input, size_t num_stages)
+{
+    uint64_t t0 = stats_begin();
+    size_t length = (size_t)1 << num_stages;
+    size_t leaf = num_stages < LEAF_STAGES ? num_stages : LEAF_STAGES;
+    leaf_codelet_t codelet = leaf_codelet((size_t)1 << leaf);
+
+    /*
+     * The first stages stay within blocks of 1 << leaf points, which the
+     * generated codelets compute without the twiddle calculation.
+     */
+    if (codelet != NULL) {
+        for (size_t i = 0; i < length; i += (size_t)1 << leaf) {
+            codelet(input + i);
+        }
+    }
+    else {
+        leaf = 0;
+    }
+
+    for (size_t s = leaf + 1; s <= num_stages; s++) {
+        size_t N = (size_t)1 << s;      // Unit of batterfly
+        double a = 2.0 * M_PI / (double)N;
+        for (size_t i = 0; i < length / N; i++) {
+            for (size_t j = 0; j < N / 2; j++) {
+                double real = cos(a * j);
+                double imag = sin(a * j);
+                size_t m = i * N + j;
+                size_t n = m + N / 2;
+                double complex delta = CMPLX(real, imag) * input[n];
+                input[n] = input[m] - delta;
+                input[m] = input[m] + delta;
+            }
+        }
+    }
+
+    stats_end(STATS_BUTTERFLY, t0);
+    STATS_ADD(transforms, 1);
+    STATS_ADD(butterflies, length / 2 * num_stages);
+}
+
+/*
+ * Transforms a frame of at most CODELET_MAX points loaded in the natural
+ * order, which the straight-line codelet takes without the bit-reversal
+ * sort.
+ */
+static void
+small_fft(const fft_plan_t *plan, const double complex *in,
+          double complex *buf)
+{
+    uint64_t t0 = stats_begin();
+    dft_codelet(plan->length)(in, 1, buf, 1);
+    stats_end(STATS_BUTTERFLY, t0);
+    STATS_ADD(transforms, 1);
+    STATS_ADD(butterflies, plan->length / 2 * plan->exp);
+}
+
+void
+fft_execute(const fft_plan_t *plan, const double *samples, size_t count,
+            double complex *buf)
+{
+    fft_execute_window(plan, samples, NULL, count, buf);
+}
+
+void
+fft_execute_window(const fft_plan_t *plan, const double *samples,
+                   const double *window, size_t count, double complex *buf)
+{
+    uint64_t t0 = stats_begin();
+    if (dft_codelet(plan->length) != NULL) {
+        double complex in[CODELET_MAX];
+        size_t n = count < plan->length ? count : plan->length;
+        for (size_t i = 0; i < n; i++) {
+            in[i] = window != NULL ? samples[i] * window[i] : samples[i];
+        }
+        for (size_t i = n; i < plan->length; i++) {
+            in[i] = 0;
+        }
+        stats_end(STATS_SORT, t0);
+        small_fft(plan, in, buf);
+        return;
+    }
+    copy_and_sort(plan, buf, samples, window, count);
+    stats_end(STATS_SORT, t0);
+
+    fft(buf, plan->exp);
+}
+
+/*
+ * Loads a channel of the interleaved PCM into dest in the butterfly order,
+ * or in the natural order if order is NULL.  The buffer is filled in
+ * sequence, each element gathering its sample through the bit-reversal
+ * table, which is its own inverse; the PCM of a block is far smaller than
+ * the complex buffer and stays in the cache while the buffer is streamed
+ * out once.  The padding is masked rather than branched on, as the padded
+ * elements are scattered in this order.
+ */
+#define LOAD_PCM(type, expr)                                            \
+    do {                                                                \
+        const type *ptr = (const type *)rbuf->body + ch;                \
+        for (size_t j = 0; j < plan->length; j++) {                     \
+            size_t i = order != NULL ? order[j] : j;                    \
+            size_t k = i < count ? i : 0;                               \
+            double x = (expr);                                          \
+            if (window != NULL) {                                       \
+                x *= window[k];                                         \
+            }                                                           \
+            dest[j] = i < count ? x : 0.0;                              \
+        }                                                               \
+    } while (0)
+
+int
+fft_execute_pcm(const fft_plan_t *plan, wave_handle_t *h,
+                const wave_read_buffer_t *rbuf, size_t count, unsigned int ch,
+                const double *window, double complex *buf)
+{
+    const size_t *itable = plan->itable;
+    size_t nch = h->num_channels;
+
+    if (!(ch < nch)) {
+        return -1;
+    }
+    if (rbuf->length / h->block_size < count) {
+        count = rbuf->length / h->block_size;
+    }
+    if (plan->length < count) {
+        count = plan->length;
+    }
+
+    /* A small frame is loaded in the natural order for its codelet. */
+    double complex in[CODELET_MAX];
+    int small = dft_codelet(plan->length) != NULL;
+    double complex *dest = small ? in : buf;
+    const size_t *order = small ? NULL : itable;
+
+    uint64_t t0 = stats_begin();
+    if (h->bits_per_sample == BITS_PER_SAMPLE_16) {
+        LOAD_PCM(int16_t, (double)ptr[k * nch] / ((double)INT16_MAX + 1.0));
+    }
+    else if (h->bits_per_sample == BITS_PER_SAMPLE_8) {
+        LOAD_PCM(uint8_t, (double)ptr[k * nch] / (double)UINT8_MAX);
+    }
+    else {
+        return -1;
+    }
+    stats_end(STATS_SORT, t0);
+
+    if (small) {
+        small_fft(plan, in, buf);
+    }
+    else {
+        fft(buf, plan->exp);
+    }
+
+    return 0;
+}
+
+void
+fft_execute_complex(const fft_plan_t *plan, const double complex *samples,
+                    size_t count, double complex *buf)
+{
+    if (dft_codelet(plan->length) != NULL) {
+        double complex in[CODELET_MAX];
+        size_t n = count < plan->length ? count : plan->length;
+        for (size_t i = 0; i < plan->length; i++) {
+            in[i] = i < n ? samples[i] : 0;
+        }
+        small_fft(plan, in, buf);
+        return;
+    }
+
+    uint64_t t0 = stats_begin();
+    copy_and_sort_complex(plan, buf, samples, count);
+    stats_end(STATS_SORT, t0);
+
+    fft(buf, plan->exp);
+}
+
+void
+fft_inverse(const fft_plan_t *plan, double complex *buf)
+{
+    const size_t *itable = plan->itable;
+    double scale = 1.0 / (double)plan->length;
+
+    if (dft_codelet(plan->length) != NULL) {
+        double complex in[CODELET_MAX];
+        for (size_t i = 0; i < plan->length; i++) {
+            in[i] = conj(buf[i]);
+        }
+        small_fft(plan, in, buf);
+        for (size_t i = 0; i < plan->length; i++) {
+            buf[i] = conj(buf[i]) * scale;
+        }
+        return;
+    }
+
+    /*
+     * The conjugate of the transform of the conjugate runs the butterflies
+     * with the twiddles of the opposite sign.
+     */
+    for (size_t i = 0; i < plan->length; i++) {
+        size_t j = itable[i];
+        if (i < j) {
+            double complex tmp = buf[i];
+            buf[i] = conj(buf[j]);
+            buf[j] = conj(tmp);
+        }
+        else if (i == j) {
+            buf[i] = conj(buf[i]);
+        }
+    }
+
+    fft(buf, plan->exp);
+
+    for (size_t i = 0; i < plan->length; i++) {
+        buf[i] = conj(buf[i]) * scale;
+    }
+}
@@ -0,0 +1,139 @@
+#ifndef FOURIER_TRANSFORM_H
+#define FOURIER_TRANSFORM_H
+
+#include <stdlib.h>
+#include <complex.h>
+#include "wave.h"
+#include "workspace.h"
+
+/**
+ * The tables shared by every transform of the same size.
+ *
+ * A plan only refers to memory in a workspace and is read-only once it
+ * has been initialized.
+ */
+typedef struct fft_plan
+{
+    /**
+     * The number of samples given to the transform.
+     */
+    size_t count;
+
+    /**
+     * The number of stages, i.e. the size of the transform in the power
+     * of two.
+     */
+    size_t exp;
+
+    /**
+     * The size of the transform.
+     */
+    size_t length;
+
+    /**
+     * The bit-reversal index table.
+     */
+    size_t *itable;
+} fft_plan_t;
+
+/**
+ * Returns the number of stages needed to transform the given count of
+ * samples.
+ */
+static inline size_t
+to_exp(size_t count)
+{
+    size_t exp;
+    for (exp = 0; count > 0; count >>= 1, exp++) ;
+    return exp;
+}
+
+/**
+ * Returns the size of the workspace needed for the tables of a plan.
+ *
+ * @param count the number of samples.
+ */
+size_t fft_plan_size(size_t count);
+
+/**
+ * Returns the size of the workspace needed for a transform buffer.
+ *
+ * @param count the number of samples.
+ */
+size_t fft_buffer_size(size_t count);
+
+/**
+ * Initializes the plan with the tables in the workspace.
+ *
+ * @param plan  the plan.
+ * @param count the number of samples.
+ * @param ws    the workspace with at least fft_plan_size() bytes left.
+ * @return      0 on success, -1 if the workspace is exhausted.
+ */
+int fft_plan_init(fft_plan_t *plan, size_t count, workspace_t *ws);
+
+/**
+ * Fast Fourier Transform.
+ *
+ * @param input         the signal samples aligned in power of 2.
+ * @param num_stages    the number of stages.
+ */
+void fft(double complex *input, size_t num_stages);
+
+/**
+ * Copies the samples into the buffer in the butterfly order, pads it
+ * with zeros and transforms it.
+ *
+ * @param plan      the plan.
+ * @param samples   the signal samples.
+ * @param count     the count of samples.
+ * @param buf       the buffer of plan->length elements.
+ */
+void fft_execute(const fft_plan_t *plan, const double *samples, size_t count,
+                 double complex *buf);
+
+/**
+ * Same as fft_execute() with the samples multiplied by a window.
+ *
+ * @param window    the window of count elements, or NULL.
+ */
+void fft_execute_window(const fft_plan_t *plan, const double *samples,
+                        const double *window, size_t count,
+                        double complex *buf);
+
+/**
+ * Same as fft_execute_window() for a channel of the raw PCM, which is
+ * decoded, scaled, windowed and sorted in a single pass.  The samples
+ * equal those of wave_single_channel().
+ *
+ * @param plan      the plan.
+ * @param h         the handle of the wave file.
+ * @param rbuf      the raw PCM.
+ * @param count     the number of frames.
+ * @param ch        the channel.
+ * @param window    the window of count elements, or NULL.
+ * @param buf       the buffer of plan->length elements.
+ * @return          0 on success, -1 if the format is not supported.
+ */
+int fft_execute_pcm(const fft_plan_t *plan, wave_handle_t *h,
+                    const wave_read_buffer_t *rbuf, size_t count,
+                    unsigned int ch, const double *window,
+                    double complex *buf);
+
+/**
+ * Same as fft_execute() for complex samples.
+ */
+void fft_execute_complex(const fft_plan_t *plan, const double complex *samples,
+                         size_t count, double complex *buf);
+
+/**
+ * Inverse transform of a spectrum in the natural order, in place.
+ *
+ * fft_inverse() undoes fft_execute(): the result is scaled by 1 / length.
+ *
+ * @param plan  the plan.
+ * @param buf   the spectrum of plan->length elements.
+ */
+void fft_inverse(const fft_plan_t *plan, double complex *buf);
+
+#endif /* FOURIER_TRANSFORM_H */
@@ -5,9 +5,15 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <stddef.h>
 #include <string.h>
+#include <math.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
 #include "wave.h"
 
 /*
@@ -37,15 +43,34 @@
  * | 4B | 'data' |
  * | 4B | Length |
  * | Length | Wave data |
+ *
+ *
+ * RF64 and BW64 start with 'RF64' or 'BW64' instead of 'RIFF' and put a
+ * ds64 chunk before the fmt chunk.  The 32-bit lengths are then set to
+ * 0xFFFFFFFF and the real ones are in ds64.
+ *
+ * ds64 chunk
+ * | 4B | 'ds64' |
+ * | 4B | Length |
+ * | 8B | File size in bytes |
+ * | 8B | Data length |
+ * | 8B | Number of samples |
+ * | 4B | Table length |
+ * | n | Table of the 64-bit lengths of other chunks |
  */
 
 #define CHUNK_ID_SIZE       4
 #define CHUNK_ID_RIFF       "RIFF"
+#define CHUNK_ID_RF64       "RF64"
+#define CHUNK_ID_BW64       "BW64"
+#define CHUNK_ID_DS64       "ds64"
 #define CHUNK_ID_FMT        "fmt "
 #define CHUNK_ID_DATA       "data"
 #define FORMAT_TYPE_SIZE    4
 #define FORMAT_TYPE_WAVE    "WAVE"
 
+#define BITS_PER_BYTE    8
+
 typedef struct riff_chunk
 {
     char chunk_id[CHUNK_ID_SIZE];
@@ -53,6 +78,19 @@ typedef struct riff_chunk
     char format[FORMAT_TYPE_SIZE];
 } riff_chunk_t;
 
+typedef struct ds64_chunk_header
+{
+    char chunk_id[CHUNK_ID_SIZE];
+    uint32_t chunk_size;
+} ds64_chunk_header_t;
+
+typedef struct ds64_chunk_body
+{
+    uint64_t riff_size;
+    uint64_t data_size;
+    uint64_t sample_count;
+} ds64_chunk_body_t;
+
 typedef struct fmt_chunk_header
 {
     char chunk_id[CHUNK_ID_SIZE];
@@ -75,71 +113,305 @@ typedef struct data_chunk_header
     uint32_t chunk_size;
 } data_chunk_header_t;
 
+/*
+ * The offset of the data length in ds64, right after the RF64 chunk.
+ */
+#define DS64_DATA_SIZE      (sizeof(riff_chunk_t) \
+                             + sizeof(ds64_chunk_header_t) \
+                             + offsetof(ds64_chunk_body_t, data_size))
+
+/*
+ * Tells whether a length of data from the header is a placeholder.  A
+ * writer which does not know the length in advance, e.g. a live capture,
+ * leaves 0 or the maximum value in the header.
+ */
+static int
+unknown_length(uint64_t length, int wide)
+{
+    if (wide) {
+        return length == 0 || length == UINT64_MAX;
+    }
+    return length == 0 || length == UINT32_MAX || length == INT32_MAX;
+}
+
+/*
+ * Reads until the buffer is full or the end of the file, as a pipe may
+ * return less than what has been asked for.
+ */
+static ssize_t
+read_full(int fd, void *buf, size_t count)
+{
+    size_t done = 0;
+
+    while (done < count) {
+        ssize_t sz = read(fd, (uint8_t *)buf + done, count - done);
+        if (sz < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return done > 0 ? (ssize_t)done : -1;
+        }
+        if (sz == 0) {
+            break;
+        }
+        done += sz;
+    }
+
+    return done;
+}
+
+/*
+ * Waits until the descriptor can be read without blocking.
+ *
+ * @return  0 on success, -1 with errno set to ECANCELED if the interrupt
+ *          descriptor of the handle became readable first.
+ */
+static int
+wait_input(wave_handle_t *h, int fd)
+{
+    if (h->interrupt < 0) {
+        return 0;
+    }
+
+    struct pollfd fds[2] = {
+        { .fd = fd, .events = POLLIN },
+        { .fd = h->interrupt, .events = POLLIN },
+    };
+    int n;
+    do {
+        n = poll(fds, 2, -1);
+    } while (n < 0 && errno == EINTR);
+    if (n < 0) {
+        return -1;
+    }
+    if (fds[1].revents != 0) {
+        errno = ECANCELED;
+        return -1;
+    }
+
+    return 0;
+}
+
+/*
+ * Reads the data like read_full(), waiting for every read so that it
+ * gives up as soon as the handle is interrupted.
+ */
+static ssize_t
+read_data(wave_handle_t *h, void *buf, size_t count)
+{
+    size_t done = 0;
+
+    if (h->interrupt < 0) {
+        return read_full(h->fd, buf, count);
+    }
+
+    while (done < count) {
+        if (wait_input(h, h->fd) < 0) {
+            return -1;
+        }
+        ssize_t sz = read(h->fd, (uint8_t *)buf + done, count - done);
+        if (sz < 0) {
+            if (errno == EINTR || errno == EAGAIN) {
+                continue;
+            }
+            return done > 0 ? (ssize_t)done : -1;
+        }
+        if (sz == 0) {
+            break;
+        }
+        done += sz;
+    }
+
+    return done;
+}
+
+/*
+ * Writes the whole buffer, as a pipe may take less than what is given.
+ */
+static ssize_t
+write_full(int fd, const void *buf, size_t count)
+{
+    size_t done = 0;
+
+    while (done < count) {
+        ssize_t sz = write(fd, (const uint8_t *)buf + done, count - done);
+        if (sz < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        done += sz;
+    }
+
+    return done;
+}
+
+/*
+ * Skips the body of a chunk by reading it, which also works on pipes.
+ */
+static int
+skip(int fd, size_t count)
+{
+    uint8_t buf[BUFSIZ];
+
+    while (count > 0) {
+        size_t len = count < sizeof(buf) ? count : sizeof(buf);
+        if (read_full(fd, buf, len) < (ssize_t)len) {
+            return -1;
+        }
+        count -= len;
+    }
+
+    return 0;
+}
+
+static wave_handle_t *
+create_handle(int fd, uint64_t length, int unbounded)
+{
+    wave_handle_t *handle = malloc(sizeof(wave_handle_t));
+    if (handle == NULL) {
+        return NULL;
+    }
+
+    handle->fd = fd;
+    handle->length = length;
+    handle->unbounded = unbounded;
+    handle->remaining = length;
+    handle->writer = 0;
+    handle->follow = -1;
+    handle->interrupt = -1;
+    handle->data_offset = -1;
+    handle->wide = 0;
+
+    return handle;
+}
+
 wave_handle_t *
 wave_open(const char *path, int mode)
+{
+    int fd;
+
+    if (strcmp(path, WAVE_STDIN) == 0) {
+        fd = STDIN_FILENO;
+    }
+    else {
+        fd = open(path, mode);
+    }
+
+    if (fd < 0) {
+        return NULL;
+    }
+
+    return wave_fdopen(fd);
+}
+
+wave_handle_t *
+wave_fdopen(int fd)
 {
     ssize_t sz;
     riff_chunk_t riff_chunk;
+    ds64_chunk_header_t ds64_chunk_header;
+    ds64_chunk_body_t ds64 = { 0, 0, 0 };
     fmt_chunk_header_t fmt_chunk_header;
     data_chunk_header_t data_chunk_header;
 
-    int fd = open(path, mode);
-
-    if (fd < 0) {
+    sz = read_full(fd, &riff_chunk, sizeof(riff_chunk_t));
+    if (sz < (ssize_t)sizeof(riff_chunk_t)) {
         goto error;
     }
 
-    sz = read(fd, &riff_chunk, sizeof(riff_chunk_t));
-    if (sz < sizeof(riff_chunk_t)) {
-        close(fd);
+    int wide = strncmp(riff_chunk.chunk_id, CHUNK_ID_RF64,
+                       CHUNK_ID_SIZE) == 0 ||
+               strncmp(riff_chunk.chunk_id, CHUNK_ID_BW64,
+                       CHUNK_ID_SIZE) == 0;
+    if ((!wide &&
+         strncmp(riff_chunk.chunk_id, CHUNK_ID_RIFF, CHUNK_ID_SIZE) != 0) ||
+        strncmp(riff_chunk.format, FORMAT_TYPE_WAVE, FORMAT_TYPE_SIZE) != 0) {
         goto error;
     }
 
-    if (strncmp(riff_chunk.chunk_id, CHUNK_ID_RIFF, CHUNK_ID_SIZE) != 0 ||
-        strncmp(riff_chunk.format, FORMAT_TYPE_WAVE, FORMAT_TYPE_SIZE) != 0) {
-        close(fd);
-        goto error;
+    if (wide) {
+        sz = read_full(fd, &ds64_chunk_header, sizeof(ds64_chunk_header_t));
+        if (sz < (ssize_t)sizeof(ds64_chunk_header_t) ||
+            strncmp(ds64_chunk_header.chunk_id, CHUNK_ID_DS64,
+                    CHUNK_ID_SIZE) != 0 ||
+            ds64_chunk_header.chunk_size < sizeof(ds64_chunk_body_t)) {
+            goto error;
+        }
+
+        sz = read_full(fd, &ds64, sizeof(ds64_chunk_body_t));
+        if (sz < (ssize_t)sizeof(ds64_chunk_body_t)) {
+            goto error;
+        }
+
+        /* Skip the table, which only matters to the other chunks. */
+        uint32_t rest = ds64_chunk_header.chunk_size
+                      - sizeof(ds64_chunk_body_t);
+        if (skip(fd, rest + (ds64_chunk_header.chunk_size & 1)) < 0) {
+            goto error;
+        }
     }
 
-    sz = read(fd, &fmt_chunk_header, sizeof(fmt_chunk_header_t));
-    if (sz < sizeof(fmt_chunk_header_t)) {
-        close(fd);
+    sz = read_full(fd, &fmt_chunk_header, sizeof(fmt_chunk_header_t));
+    if (sz < (ssize_t)sizeof(fmt_chunk_header_t)) {
         goto error;
     }
 
-    if (strncmp(fmt_chunk_header.chunk_id, CHUNK_ID_FMT, CHUNK_ID_SIZE) != 0) {
-        close(fd);
+    if (strncmp(fmt_chunk_header.chunk_id, CHUNK_ID_FMT, CHUNK_ID_SIZE) != 0 ||
+        fmt_chunk_header.chunk_size < sizeof(fmt_chunk_body_t) ||
+        fmt_chunk_header.chunk_size > BUFSIZ) {
         goto error;
     }
 
     uint8_t buf[BUFSIZ];
-    sz = read(fd, buf, fmt_chunk_header.chunk_size);
+    sz = read_full(fd, buf, fmt_chunk_header.chunk_size);
     if (sz < fmt_chunk_header.chunk_size) {
-        close(fd);
         goto error;
     }
 
     fmt_chunk_body_t *ptr = (fmt_chunk_body_t *)buf;
 
-    sz = read(fd, &data_chunk_header, sizeof(data_chunk_header_t));
-    if (sz < sizeof(data_chunk_header_t)) {
-        close(fd);
-        goto error;
+    /* Skip the chunks such as LIST or fact preceding the data. */
+    for (;;) {
+        sz = read_full(fd, &data_chunk_header, sizeof(data_chunk_header_t));
+        if (sz < (ssize_t)sizeof(data_chunk_header_t)) {
+            goto error;
+        }
+
+        if (strncmp(data_chunk_header.chunk_id, CHUNK_ID_DATA,
+                    CHUNK_ID_SIZE) == 0) {
+            break;
+        }
+
+        /* Chunks are aligned to 2 bytes. */
+        if (skip(fd, data_chunk_header.chunk_size +
+                     (data_chunk_header.chunk_size & 1)) < 0) {
+            goto error;
+        }
     }
 
-    if (strncmp(data_chunk_header.chunk_id, CHUNK_ID_DATA, CHUNK_ID_SIZE) != 0) {
-        close(fd);
-        goto error;
+    /*
+     * RF64 always leaves the maximum value in the data chunk and the
+     * length, if any, in ds64.
+     */
+    uint64_t length = data_chunk_header.chunk_size;
+    int unbounded;
+    if (wide && length == UINT32_MAX) {
+        length = ds64.data_size;
+        unbounded = unknown_length(length, 1);
+    }
+    else {
+        unbounded = unknown_length(length, 0);
     }
 
-    wave_handle_t *handle = malloc(sizeof(wave_handle_t));
+    wave_handle_t *handle = create_handle(fd, length, unbounded);
     if (handle == NULL) {
-        close(fd);
         goto error;
     }
+    handle->data_offset = lseek(fd, 0, SEEK_CUR);
+    handle->wide = wide;
 
-    handle->fd = fd;
-    handle->length = data_chunk_header.chunk_size;
     handle->num_channels = ptr->num_channels;
     handle->sample_rate = ptr->sample_rate;
     handle->byte_rate = ptr->byte_rate;
@@ -149,13 +421,247 @@ wave_open(const char *path, int mode)
     return handle;
 
 error:
+    if (fd > 0) {
+        close(fd);
+    }
     return NULL;
 }
 
+wave_handle_t *
+wave_open_raw(const char *path, uint32_t sample_rate, uint16_t num_channels,
+              uint16_t bits_per_sample)
+{
+    int fd;
+
+    if (num_channels == 0 || (bits_per_sample != BITS_PER_SAMPLE_8 &&
+                              bits_per_sample != BITS_PER_SAMPLE_16)) {
+        return NULL;
+    }
+
+    if (strcmp(path, WAVE_STDIN) == 0) {
+        fd = STDIN_FILENO;
+    }
+    else {
+        fd = open(path, O_RDONLY);
+    }
+
+    if (fd < 0) {
+        return NULL;
+    }
+
+    wave_handle_t *handle = create_handle(fd, 0, 1);
+    if (handle == NULL) {
+        if (fd > 0) {
+            close(fd);
+        }
+        return NULL;
+    }
+
+    handle->num_channels = num_channels;
+    handle->sample_rate = sample_rate;
+    handle->block_size = num_channels * bits_per_sample / BITS_PER_BYTE;
+    handle->byte_rate = sample_rate * handle->block_size;
+    handle->bits_per_sample = bits_per_sample;
+
+    return handle;
+}
+
+wave_handle_t *
+wave_create(const char *path, uint32_t sample_rate, uint16_t num_channels,
+            uint16_t bits_per_sample)
+{
+    int fd;
+
+    if (num_channels == 0 || (bits_per_sample != BITS_PER_SAMPLE_8 &&
+                              bits_per_sample != BITS_PER_SAMPLE_16)) {
+        return NULL;
+    }
+
+    if (strcmp(path, WAVE_STDOUT) == 0) {
+        fd = STDOUT_FILENO;
+    }
+    else {
+        fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    }
+
+    if (fd < 0) {
+        return NULL;
+    }
+
+    wave_handle_t *handle = create_handle(fd, 0, 0);
+    if (handle == NULL) {
+        goto error;
+    }
+
+    handle->writer = 1;
+    handle->num_channels = num_channels;
+    handle->sample_rate = sample_rate;
+    handle->block_size = num_channels * bits_per_sample / BITS_PER_BYTE;
+    handle->byte_rate = sample_rate * handle->block_size;
+    handle->bits_per_sample = bits_per_sample;
+
+    /* The lengths are known at the end only, if they can be rewritten. */
+    uint32_t size = handle->unbounded ? UINT32_MAX : 0;
+    struct {
+        riff_chunk_t riff;
+        fmt_chunk_header_t fmt_header;
+        fmt_chunk_body_t fmt;
+        data_chunk_header_t data;
+    } header = {
+        { { 'R', 'I', 'F', 'F' }, size, { 'W', 'A', 'V', 'E' } },
+        { { 'f', 'm', 't', ' ' }, sizeof(fmt_chunk_body_t) },
+        { 1, num_channels, sample_rate, handle->byte_rate,
+          handle->block_size, bits_per_sample },
+        { { 'd', 'a', 't', 'a' }, size },
+    };
+    if (write_full(fd, &header, sizeof(header)) < (ssize_t)sizeof(header)) {
+        free(handle);
+        goto error;
+    }
+
+    return handle;
+
+error:
+    if (fd > 0) {
+        close(fd);
+    }
+    return NULL;
+}
+
+/*
+ * Fills the lengths in the header of a file written by wave_write().
+ */
+static void
+finish_header(wave_handle_t *h)
+{
+    uint64_t length = h->length;
+    uint8_t pad = 0;
+
+    /* Chunks are aligned to 2 bytes. */
+    if ((length & 1) && write_full(h->fd, &pad, 1) < 1) {
+        return;
+    }
+
+    uint64_t riff = sizeof(riff_chunk_t) - offsetof(riff_chunk_t, format)
+                  + sizeof(fmt_chunk_header_t) + sizeof(fmt_chunk_body_t)
+                  + sizeof(data_chunk_header_t) + length + (length & 1);
+    uint32_t riff_size = riff < UINT32_MAX ? (uint32_t)riff : UINT32_MAX;
+    uint32_t data_size = length < UINT32_MAX ? (uint32_t)length : UINT32_MAX;
+
+    pwrite(h->fd, &riff_size, sizeof(riff_size),
+           offsetof(riff_chunk_t, chunk_size));
+    pwrite(h->fd, &data_size, sizeof(data_size),
+           sizeof(riff_chunk_t) + sizeof(fmt_chunk_header_t)
+           + sizeof(fmt_chunk_body_t) + offsetof(data_chunk_header_t,
+                                                 chunk_size));
+}
+
+int
+wave_follow(wave_handle_t *h, const char *path)
+{
+    if (h->writer || strcmp(path, WAVE_STDIN) == 0) {
+        return -1;
+    }
+
+    int fd = inotify_init1(IN_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+    if (inotify_add_watch(fd, path, IN_MODIFY | IN_CLOSE_WRITE) < 0) {
+        close(fd);
+        return -1;
+    }
+
+    h->follow = fd;
+    h->unbounded = 1;
+    return 0;
+}
+
+/*
+ * Stops following once the writer has closed the file.  The rest of the
+ * data is bounded by the length the writer has patched into the header;
+ * if there is none, it is read until the end of the file.
+ */
+static void
+stop_following(wave_handle_t *h)
+{
+    close(h->follow);
+    h->follow = -1;
+    if (h->data_offset < 0) {
+        return;
+    }
+
+    uint64_t length = 0;
+    uint32_t size;
+    if (pread(h->fd, &size, sizeof(size),
+              h->data_offset - sizeof(size)) < (ssize_t)sizeof(size)) {
+        return;
+    }
+    length = size;
+    if (h->wide && size == UINT32_MAX &&
+        pread(h->fd, &length, sizeof(length),
+              DS64_DATA_SIZE) < (ssize_t)sizeof(length)) {
+        return;
+    }
+    off_t pos = lseek(h->fd, 0, SEEK_CUR);
+    if (unknown_length(length, h->wide && size == UINT32_MAX) || pos < 0) {
+        return;
+    }
+
+    uint64_t end = h->data_offset + length;
+    h->length = length;
+    h->remaining = end > (uint64_t)pos ? end - pos : 0;
+    h->unbounded = 0;
+}
+
+/*
+ * Waits for the writer of a followed file to append or to close it.
+ *
+ * @return  0 on success, -1 on error.
+ */
+static int
+wait_writer(wave_handle_t *h)
+{
+    union {
+        struct inotify_event event;
+        uint8_t buf[BUFSIZ];
+    } events;
+
+    ssize_t sz;
+    do {
+        if (wait_input(h, h->follow) < 0) {
+            return -1;
+        }
+        sz = read(h->follow, &events, sizeof(events));
+    } while (sz < 0 && errno == EINTR);
+    if (sz <= 0) {
+        return -1;
+    }
+
+    /* The events of a read all count, as several may have queued up. */
+    for (ssize_t i = 0; i < sz; ) {
+        const struct inotify_event *e =
+            (const struct inotify_event *)(events.buf + i);
+        if (e->mask & (IN_CLOSE_WRITE | IN_IGNORED)) {
+            stop_following(h);
+            break;
+        }
+        i += sizeof(struct inotify_event) + e->len;
+    }
+
+    return 0;
+}
+
 void
 wave_close(wave_handle_t *handle)
 {
     int fd = handle->fd;
+    if (handle->writer && !handle->unbounded) {
+        finish_header(handle);
+    }
+    if (handle->follow >= 0) {
+        close(handle->follow);
+    }
     free(handle);
     if (fd > 0) {
         close(fd);
@@ -163,10 +669,10 @@ wave_close(wave_handle_t *handle)
 }
 
 wave_buffer_t *
-wave_alloc_buffer(wave_handle_t *handle, int sec)
+wave_alloc_buffer(wave_handle_t *handle, unsigned int sec)
 {
     // Total number of samples in the given duration
-    size_t length = handle->num_channels * handle->sample_rate * sec;
+    size_t length = (size_t)handle->num_channels * handle->sample_rate * sec;
     wave_buffer_t *buf = NULL;
     double *ptr = malloc(length * sizeof(double));
     if (ptr != NULL) {
@@ -190,8 +696,6 @@ wave_free_buffer(wave_buffer_t *buf)
     free(buf);
 }
 
-#define BITS_PER_BYTE    8
-
 ssize_t
 wave_read(wave_handle_t *handle, wave_buffer_t *buf)
 {
@@ -201,35 +705,33 @@ wave_read(wave_handle_t *handle, wave_buffer_t *buf)
         goto exit;
     }
 
+    /*
+     * The raw samples are read into the head of the buffer and widened in
+     * place from the tail, so that no temporary buffer is needed.  A
+     * double is wider than any raw sample, hence the i-th result never
+     * overwrites a raw sample which has not been converted yet.
+     */
     if (handle->bits_per_sample == BITS_PER_SAMPLE_8) {
         size_t bufsz = buf->length * handle->bits_per_sample / BITS_PER_BYTE;
-        uint8_t *tmp = malloc(bufsz);
-        if (tmp == NULL) {
-            goto exit;
-        }
+        uint8_t *tmp = (uint8_t *)buf->buffer;
 
-        sz = read(handle->fd, tmp, bufsz);
-        for (ssize_t i = 0; i < sz; i++) {
+        sz = read_full(handle->fd, tmp, bufsz);
+        for (ssize_t i = sz - 1; i >= 0; i--) {
             buf->buffer[i] = (double)tmp[i] / (double)UINT8_MAX;
         }
-        free(tmp);
     }
     else if (handle->bits_per_sample == BITS_PER_SAMPLE_16) {
         // wave_buffer_t already counts the number of channels.
         // So, the size of sample in bytes is taken into account here.
         size_t bufsz = buf->length * handle->bits_per_sample / BITS_PER_BYTE;
-        int16_t *tmp = malloc(bufsz);
-        if (tmp == NULL) {
-            goto exit;
-        }
+        int16_t *tmp = (int16_t *)buf->buffer;
 
-        sz = read(handle->fd, tmp, bufsz);
+        sz = read_full(handle->fd, tmp, bufsz);
         // Adjust the count to the int16_t array.
         sz /= sizeof(int16_t);
-        for (ssize_t i = 0; i < sz; i++) {
+        for (ssize_t i = sz - 1; i >= 0; i--) {
             buf->buffer[i] = (double)tmp[i] / ((double)INT16_MAX + 1.0);
         }
-        free(tmp);
     }
 exit:
     return sz;
@@ -239,7 +741,7 @@ wave_read_buffer_t *
 wave_alloc_read_buffer(wave_handle_t *h, unsigned int sec)
 {
     wave_read_buffer_t *buf = NULL;
-    size_t length = h->byte_rate * sec;
+    size_t length = wave_read_buffer_size(h, sec);
 
     uint8_t *ptr = malloc(length);
     if (ptr != NULL) {
@@ -256,6 +758,13 @@ wave_alloc_read_buffer(wave_handle_t *h, unsigned int sec)
     return buf;
 }
 
+void
+wave_init_read_buffer(wave_read_buffer_t *buf, uint8_t *body, size_t length)
+{
+    buf->length = length;
+    buf->body = body;
+}
+
 void
 wave_free_read_buffer(wave_read_buffer_t *buf)
 {
@@ -266,7 +775,42 @@ wave_free_read_buffer(wave_read_buffer_t *buf)
 ssize_t
 wave_rawread(wave_handle_t *h, wave_read_buffer_t *buf)
 {
-    return read(h->fd, buf->body, buf->length);
+    size_t length = buf->length;
+
+    /* Stop at the end of the data chunk if its length is known. */
+    if (!h->unbounded && h->remaining < length) {
+        length = h->remaining;
+    }
+
+    ssize_t sz = read_data(h, buf->body, length);
+
+    /*
+     * The end of a followed file is only where the writer is at; the
+     * read goes on as it appends, until the buffer is full.
+     */
+    while (h->follow >= 0 && sz >= 0 && (size_t)sz < length) {
+        if (wait_writer(h) < 0) {
+            return -1;
+        }
+        if (!h->unbounded) {
+            /* The writer is done and the rest of data is known. */
+            if (h->remaining < length - sz) {
+                length = sz + h->remaining;
+            }
+            h->remaining += sz;
+        }
+        ssize_t more = read_data(h, buf->body + sz, length - sz);
+        if (more < 0) {
+            return -1;
+        }
+        sz += more;
+    }
+
+    if (sz > 0 && !h->unbounded) {
+        h->remaining -= sz;
+    }
+
+    return sz;
 }
 
 ssize_t
@@ -312,6 +856,41 @@ exit:
 ssize_t
 wave_write(wave_handle_t *handle, const wave_buffer_t *buf)
 {
-    //return write(handle->fd, buf->buffer, buf->length);
-    return 0;
+    uint8_t tmp[BUFSIZ];
+    size_t bytes = handle->bits_per_sample / BITS_PER_BYTE;
+    size_t step = sizeof(tmp) / bytes;
+    size_t done = 0;
+
+    if (!handle->writer) {
+        return -1;
+    }
+
+    /* The samples are converted through a small buffer on the stack. */
+    for (size_t i = 0; i < buf->length; i += step) {
+        size_t n = buf->length - i < step ? buf->length - i : step;
+        const double *src = buf->buffer + i;
+
+        if (handle->bits_per_sample == BITS_PER_SAMPLE_8) {
+            for (size_t j = 0; j < n; j++) {
+                double v = nearbyint(src[j] * (double)UINT8_MAX);
+                tmp[j] = v < 0.0 ? 0 : v > UINT8_MAX ? UINT8_MAX : (uint8_t)v;
+            }
+        }
+        else {
+            int16_t *dest = (int16_t *)tmp;
+            for (size_t j = 0; j < n; j++) {
+                double v = nearbyint(src[j] * ((double)INT16_MAX + 1.0));
+                dest[j] = v < INT16_MIN ? INT16_MIN
+                        : v > INT16_MAX ? INT16_MAX : (int16_t)v;
+            }
+        }
+
+        if (write_full(handle->fd, tmp, n * bytes) < 0) {
+            return -1;
+        }
+        done += n * bytes;
+    }
+
+    handle->length += done;
+    return done;
 }
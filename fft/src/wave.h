@@ -7,6 +7,17 @@
 
 #define BITS_PER_SAMPLE_8   8
 #define BITS_PER_SAMPLE_16  16
+#define BITS_PER_SAMPLE_24  24
+
+/**
+ * The path which stands for the standard input.
+ */
+#define WAVE_STDIN          "-"
+
+/**
+ * The path which stands for the standard output.
+ */
+#define WAVE_STDOUT         "-"
 
 typedef struct wave_handle
 {
@@ -18,7 +29,44 @@ typedef struct wave_handle
     /**
      * The size of data in bytes.
      */
-    uint32_t length;
+    uint64_t length;
+
+    /**
+     * Set if the length of data is unknown, e.g. for a live stream.  The
+     * data is then read until the end of the file.
+     */
+    int unbounded;
+
+    /**
+     * The size of data not read yet in bytes.
+     */
+    uint64_t remaining;
+
+    /**
+     * Set if the handle writes a file created by wave_create().  The
+     * length then counts the bytes written.
+     */
+    int writer;
+
+    /**
+     * The inotify descriptor watching the file while it is followed, -1
+     * otherwise.
+     */
+    int follow;
+
+    /**
+     * A descriptor which becomes readable when a blocked read of the data
+     * must give up, -1 if the reads are never interrupted.
+     */
+    int interrupt;
+
+    /**
+     * The offset of the data in the file, -1 if it has no header or cannot
+     * be sought, and whether the header is RF64 or BW64.  They tell where
+     * the length of data is patched by the writer.
+     */
+    off_t data_offset;
+    int wide;
 
     /**
      * The number of channels
@@ -85,10 +133,60 @@ typedef struct wave_read_buffer
 } wave_read_buffer_t;
 
 /**
- * Opens the wave file and creates a handle to it.
+ * Opens the wave file and creates a handle to it.  RF64 and BW64 files
+ * are read as well as RIFF ones.
+ *
+ * @param path  the path of the file, or WAVE_STDIN for the standard input.
+ * @param mode  the flags given to open().
  */
 wave_handle_t *wave_open(const char *path, int mode);
 
+/**
+ * Creates a handle to the wave data read from the file descriptor, which
+ * may be a pipe.  The descriptor is closed on failure.
+ */
+wave_handle_t *wave_fdopen(int fd);
+
+/**
+ * Opens a file of raw PCM without header.  The data is read until the end
+ * of the file.
+ *
+ * @param path              the path of the file, or WAVE_STDIN.
+ * @param sample_rate       the sampling rate.
+ * @param num_channels      the number of interleaved channels.
+ * @param bits_per_sample   BITS_PER_SAMPLE_8 or BITS_PER_SAMPLE_16.
+ */
+wave_handle_t *wave_open_raw(const char *path, uint32_t sample_rate,
+                             uint16_t num_channels, uint16_t bits_per_sample);
+
+/**
+ * Creates a wave file to be written with wave_write().  The lengths in
+ * the header are filled in by wave_close(), or left to the maximum value
+ * as for a live stream if the output is a pipe.
+ *
+ * @param path              the path of the file, or WAVE_STDOUT for the
+ *                          standard output.
+ * @param sample_rate       the sampling rate.
+ * @param num_channels      the number of interleaved channels.
+ * @param bits_per_sample   BITS_PER_SAMPLE_8 or BITS_PER_SAMPLE_16.
+ */
+wave_handle_t *wave_create(const char *path, uint32_t sample_rate,
+                           uint16_t num_channels, uint16_t bits_per_sample);
+
+/**
+ * Follows a file which is still being written, as "tail -f" does.  The
+ * length of data in the header is ignored, and a read which reaches the
+ * end of the file waits for the writer to append more, so that only the
+ * last block is short.  Once the writer closes the file the length it has
+ * patched into the header, if any, bounds the rest of the data.
+ *
+ * @param handle    the handle of the file.
+ * @param path      the path the handle has been opened with.
+ * @return          0 on success, -1 if the file cannot be watched, e.g. for
+ *                  the standard input.
+ */
+int wave_follow(wave_handle_t *handle, const char *path);
+
 /**
  * Closes the given handle.
  */
@@ -100,7 +198,7 @@ void wave_close(wave_handle_t *handle);
  * @param handle    the handle.
  * @param sec       the duration.
  */
-wave_buffer_t *wave_alloc_buffer(wave_handle_t *handle, int sec);
+wave_buffer_t *wave_alloc_buffer(wave_handle_t *handle, unsigned int sec);
 
 /**
  * Releases the buffer.
@@ -112,6 +210,18 @@ void wave_free_buffer(wave_buffer_t *buf);
  */
 ssize_t wave_read(wave_handle_t *handle, wave_buffer_t *buf);
 
+/**
+ * Returns the size of a buffer for wave data in bytes.
+ *
+ * @param handle    the handle of the wave file.
+ * @param sec       the size of the buffer in seconds.
+ */
+static inline size_t
+wave_read_buffer_size(wave_handle_t *h, unsigned int sec)
+{
+    return (size_t)h->byte_rate * sec;
+}
+
 /**
  * Allocates a buffer for wave data.
  *
@@ -120,18 +230,43 @@ ssize_t wave_read(wave_handle_t *handle, wave_buffer_t *buf);
  */
 wave_read_buffer_t *wave_alloc_read_buffer(wave_handle_t *handle, unsigned int sec);
 
+/**
+ * Initializes a buffer for wave data with the memory given by the caller,
+ * e.g. a region of a workspace.  Such a buffer must not be released with
+ * wave_free_read_buffer().
+ *
+ * @param buf       the buffer.
+ * @param body      the memory.
+ * @param length    the size of the memory in bytes.
+ */
+void wave_init_read_buffer(wave_read_buffer_t *buf, uint8_t *body,
+                           size_t length);
+
 /**
  * Release the buffer.
  */
 void wave_free_read_buffer(wave_read_buffer_t *buf);
 
+/**
+ * Reads raw wave data into the buffer.  The read blocks until the buffer
+ * is full, the data chunk is exhausted or the end of the file is reached,
+ * so that only the last block may be short, or until the interrupt
+ * descriptor of the handle becomes readable.
+ *
+ * @return  the number of bytes read, 0 at the end of data, -1 on error or
+ *          interruption.
+ */
 ssize_t wave_rawread(wave_handle_t *handle, wave_read_buffer_t *buf);
 
 ssize_t wave_single_channel(wave_handle_t *h, wave_read_buffer_t *buf,
                             double *dest, size_t len, unsigned int ch);
 
 /**
- * Writes the data in the buffer to the wave file.
+ * Writes the data in the buffer to the wave file.  The interleaved
+ * samples are scaled as wave_read() does and clipped to the range of the
+ * format.
+ *
+ * @return  the number of bytes written, -1 on error.
  */
 ssize_t wave_write(wave_handle_t *handle, const wave_buffer_t *buf);
 
@@ -0,0 +1,44 @@
+/**
+ * Window functions
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "window.h"
+
+int
+window_parse(const char *name)
+{
+    static const char *const names[] = { "none", "hann", "hamming",
+                                         "blackman" };
+
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+        if (strcmp(name, names[i]) == 0) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+void
+window_init(double *w, enum window_type type, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        double a = 2.0 * M_PI * (double)i / (double)count;
+        switch (type) {
+        case WINDOW_HANN:
+            w[i] = 0.5 - 0.5 * cos(a);
+            break;
+        case WINDOW_HAMMING:
+            w[i] = 0.54 - 0.46 * cos(a);
+            break;
+        case WINDOW_BLACKMAN:
+            w[i] = 0.42 - 0.5 * cos(a) + 0.08 * cos(2.0 * a);
+            break;
+        default:
+            w[i] = 1.0;
+            break;
+        }
+    }
+}
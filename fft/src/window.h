@@ -0,0 +1,32 @@
+#ifndef FOURIER_WINDOW_H
+#define FOURIER_WINDOW_H
+
+#include <stdlib.h>
+
+/**
+ * The window functions applied to a frame before the transform.
+ */
+enum window_type
+{
+    WINDOW_NONE,
+    WINDOW_HANN,
+    WINDOW_HAMMING,
+    WINDOW_BLACKMAN
+};
+
+/**
+ * Returns the window of the name, or -1 if there is none.
+ */
+int window_parse(const char *name);
+
+/**
+ * Fills the table with the periodic window of the given size, which suits
+ * spectral analysis better than the symmetric one.
+ *
+ * @param w     the table of count elements.
+ * @param type  the window.
+ * @param count the number of samples.
+ */
+void window_init(double *w, enum window_type type, size_t count);
+
+#endif /* FOURIER_WINDOW_H */
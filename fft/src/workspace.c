@@ -0,0 +1,147 @@
+/**
+ * Aligned workspace arena
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include "workspace.h"
+
+/* The huge page size when /proc/meminfo does not tell. */
+#define WORKSPACE_HUGEPAGE_SIZE ((size_t)2 << 20)
+
+int
+workspace_init(workspace_t *ws, void *block, size_t size)
+{
+    if (ws == NULL || ((uintptr_t)block & (WORKSPACE_ALIGN - 1)) != 0) {
+        return -1;
+    }
+
+    ws->base = block;
+    ws->size = size;
+    ws->used = 0;
+    ws->source = WORKSPACE_EXTERNAL;
+
+    return 0;
+}
+
+#ifdef MAP_HUGETLB
+/*
+ * Returns the size of the default huge pages in bytes.
+ */
+static size_t
+hugepage_size(void)
+{
+    size_t size = WORKSPACE_HUGEPAGE_SIZE;
+    FILE *fp = fopen("/proc/meminfo", "r");
+    char line[128];
+    unsigned long kb;
+
+    if (fp == NULL) {
+        return size;
+    }
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        if (sscanf(line, "Hugepagesize: %lu kB", &kb) == 1 && kb > 0) {
+            size = (size_t)kb << 10;
+            break;
+        }
+    }
+    fclose(fp);
+
+    return size;
+}
+#endif
+
+/*
+ * Maps the block, and rounds its size up to the huge page size if it is
+ * backed by reserved huge pages, which are only unmapped whole.
+ */
+static void *
+alloc_hugepage(size_t *size)
+{
+    void *ptr = MAP_FAILED;
+
+#ifdef MAP_HUGETLB
+    size_t huge = hugepage_size();
+    size_t length = (*size + huge - 1) / huge * huge;
+
+    ptr = mmap(NULL, length, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (ptr != MAP_FAILED) {
+        *size = length;
+        return ptr;
+    }
+#endif
+    /* No reserved huge pages; ask for transparent ones instead. */
+    ptr = mmap(NULL, *size, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED) {
+        return NULL;
+    }
+#ifdef MADV_HUGEPAGE
+    madvise(ptr, *size, MADV_HUGEPAGE);
+#endif
+
+    return ptr;
+}
+
+workspace_t *
+workspace_create(size_t size, int flags)
+{
+    workspace_t *ws = malloc(sizeof(workspace_t));
+    if (ws == NULL) {
+        goto error;
+    }
+
+    size = workspace_align(size);
+
+    void *block = NULL;
+    if (flags & WORKSPACE_HUGEPAGE) {
+        block = alloc_hugepage(&size);
+        ws->source = WORKSPACE_MMAP;
+    }
+    if (block == NULL) {
+        if (posix_memalign(&block, WORKSPACE_ALIGN, size) != 0) {
+            free(ws);
+            goto error;
+        }
+        ws->source = WORKSPACE_HEAP;
+    }
+
+    ws->base = block;
+    ws->size = size;
+    ws->used = 0;
+
+    return ws;
+
+error:
+    return NULL;
+}
+
+void
+workspace_destroy(workspace_t *ws)
+{
+    if (ws->source == WORKSPACE_MMAP) {
+        munmap(ws->base, ws->size);
+    }
+    else if (ws->source == WORKSPACE_HEAP) {
+        free(ws->base);
+    }
+    free(ws);
+}
+
+void *
+workspace_get(workspace_t *ws, size_t size)
+{
+    size = workspace_align(size);
+    if (size > ws->size - ws->used) {
+        return NULL;
+    }
+
+    void *ptr = ws->base + ws->used;
+    ws->used += size;
+
+    return ptr;
+}
@@ -0,0 +1,105 @@
+#ifndef FOURIER_WORKSPACE_H
+#define FOURIER_WORKSPACE_H
+
+#include <stdlib.h>
+#include <stdint.h>
+
+/**
+ * Alignment of every region handed out by a workspace in bytes.
+ */
+#define WORKSPACE_ALIGN         64
+
+/**
+ * Back the workspace with huge pages when the system allows it.
+ */
+#define WORKSPACE_HUGEPAGE      0x1
+
+/*
+ * How the block of a workspace has been obtained.  Used internally to
+ * release it.
+ */
+#define WORKSPACE_EXTERNAL      0
+#define WORKSPACE_HEAP          1
+#define WORKSPACE_MMAP          2
+
+/**
+ * A linear arena carved out of a single aligned block.
+ *
+ * The block is either supplied by the caller or allocated by
+ * workspace_create().  Regions are handed out in order and are never
+ * freed one by one; workspace_reset() rewinds the whole arena.
+ */
+typedef struct workspace
+{
+    /**
+     * The beginning of the block.
+     */
+    uint8_t *base;
+
+    /**
+     * The size of the block in bytes.
+     */
+    size_t size;
+
+    /**
+     * The number of bytes already handed out.
+     */
+    size_t used;
+
+    /**
+     * The origin of the block.
+     */
+    int source;
+} workspace_t;
+
+/**
+ * Rounds the size up to the workspace alignment.
+ */
+static inline size_t
+workspace_align(size_t size)
+{
+    return (size + WORKSPACE_ALIGN - 1) & ~(size_t)(WORKSPACE_ALIGN - 1);
+}
+
+/**
+ * Initializes the workspace with the block supplied by the caller.
+ *
+ * @param ws    the workspace.
+ * @param block the block aligned to WORKSPACE_ALIGN.
+ * @param size  the size of the block in bytes.
+ * @return      0 on success, -1 if the block is not aligned.
+ */
+int workspace_init(workspace_t *ws, void *block, size_t size);
+
+/**
+ * Allocates an aligned block and creates a workspace on it.
+ *
+ * @param size  the size of the block in bytes.
+ * @param flags WORKSPACE_HUGEPAGE or 0.
+ */
+workspace_t *workspace_create(size_t size, int flags);
+
+/**
+ * Releases the workspace and the block allocated by workspace_create().
+ */
+void workspace_destroy(workspace_t *ws);
+
+/**
+ * Hands out an aligned region of the workspace.
+ *
+ * @param ws    the workspace.
+ * @param size  the size of the region in bytes.
+ * @return      the region or NULL if the workspace is exhausted.
+ */
+void *workspace_get(workspace_t *ws, size_t size);
+
+/**
+ * Rewinds the workspace so that all the regions can be handed out again.
+ */
+static inline void
+workspace_reset(workspace_t *ws)
+{
+    ws->used = 0;
+}
+
+#endif /* FOURIER_WORKSPACE_H */
@@ -0,0 +1,278 @@
+#!/usr/bin/env python3
+"""
+Generates straight-line DFT kernels (codelets) for small sizes.
+
+    gencodelets.py header > src/codelets.h
+    gencodelets.py source > src/codelets.c
+
+Every kernel computes X(k) = sum x(n) exp(+2 pi i n k / N), the sign
+convention of fft().  The arithmetic is emitted on real and imaginary
+parts separately so that the compiler keeps the whole transform in
+registers and no complex multiplication falls back to a library call.
+"""
+
+import decimal
+import functools
+import sys
+
+# The natural-order kernels transform whole frames of up to CODELET_MAX
+# points; the leaf kernels run the first LEAF_STAGES stages of fft().
+SIZES = [2, 4, 8, 16, 32, 64]
+LEAF_SIZES = [2, 4, 8, 16, 32]
+EPS = 1e-15
+
+
+def _pi():
+    """Pi to the precision of the context (Machin's formula)."""
+    def arctan_inv(x):
+        total = term = decimal.Decimal(1) / x
+        x2 = x * x
+        k = 1
+        while True:
+            term /= -x2
+            delta = term / (2 * k + 1)
+            if delta == 0:
+                break
+            total += delta
+            k += 1
+        return total
+    with decimal.localcontext() as ctx:
+        ctx.prec = 50
+        return 4 * (4 * arctan_inv(decimal.Decimal(5)) -
+                    arctan_inv(decimal.Decimal(239)))
+
+
+@functools.lru_cache(maxsize=None)
+def cossin(num, den):
+    """Returns cos and sin of 2 pi num / den, correctly rounded."""
+    num %= den
+    with decimal.localcontext() as ctx:
+        ctx.prec = 40
+        x = 2 * _pi() * (num % den) / den
+        c = s = decimal.Decimal(0)
+        term = decimal.Decimal(1)
+        k = 0
+        while True:
+            # term = x^k / k!
+            if k % 4 == 0:
+                c += term
+            elif k % 4 == 1:
+                s += term
+            elif k % 4 == 2:
+                c -= term
+            else:
+                s -= term
+            k += 1
+            term = term * x / k
+            if abs(term) < decimal.Decimal(10) ** -45:
+                break
+        return float(c), float(s)
+
+
+class Emitter:
+    def __init__(self):
+        self.lines = []
+        self.count = 0
+
+    def tmp(self, expr):
+        name = 't%d' % self.count
+        self.count += 1
+        self.lines.append('    const double %s = %s;' % (name, expr))
+        return name
+
+    def add(self, a, b):
+        return (self.tmp('%s + %s' % (a[0], b[0])),
+                self.tmp('%s + %s' % (a[1], b[1])))
+
+    def sub(self, a, b):
+        return (self.tmp('%s - %s' % (a[0], b[0])),
+                self.tmp('%s - %s' % (a[1], b[1])))
+
+    def mul(self, a, num, den):
+        """Multiplies a by exp(2 pi i num / den), skipping trivial factors."""
+        c, s = cossin(num, den)
+        if abs(s) < EPS:
+            if c > 0:
+                return a
+            return (self.tmp('-%s' % a[0]), self.tmp('-%s' % a[1]))
+        if abs(c) < EPS:
+            if s > 0:
+                return (self.tmp('-%s' % a[1]), a[0])
+            return (a[1], self.tmp('-%s' % a[0]))
+        if abs(abs(c) - abs(s)) < EPS:
+            # (c + i s) a with |c| = |s|: two additions and two products.
+            h = '%.17g' % abs(c)
+            if c * s > 0:
+                re = self.tmp('%s - %s' % (a[0], a[1]))
+                im = self.tmp('%s + %s' % (a[0], a[1]))
+            else:
+                re = self.tmp('%s + %s' % (a[0], a[1]))
+                im = self.tmp('%s - %s' % (a[1], a[0]))
+            if c > 0:
+                return (self.tmp('%s * %s' % (h, re)),
+                        self.tmp('%s * %s' % (h, im)))
+            return (self.tmp('-%s * %s' % (h, re)),
+                    self.tmp('-%s * %s' % (h, im)))
+        return (self.tmp('%.17g * %s - %.17g * %s' % (c, a[0], s, a[1])),
+                self.tmp('%.17g * %s + %.17g * %s' % (s, a[0], c, a[1])))
+
+    def radix2(self, x):
+        """Decimation in time over the values in the natural order."""
+        n = len(x)
+        if n == 1:
+            return x
+        even = self.radix2(x[0::2])
+        odd = self.radix2(x[1::2])
+        out = [None] * n
+        for k in range(n // 2):
+            d = self.mul(odd[k], k, n)
+            out[k] = self.add(even[k], d)
+            out[k + n // 2] = self.sub(even[k], d)
+        return out
+
+
+def bitrev(i, bits):
+    r = 0
+    for b in range(bits):
+        r |= ((i >> b) & 1) << (bits - b - 1)
+    return r
+
+
+def kernel(n, loads):
+    e = Emitter()
+    x = []
+    for i in range(n):
+        src = loads(i)
+        x.append((e.tmp('creal(%s)' % src), e.tmp('cimag(%s)' % src)))
+    return e, e.radix2(x)
+
+
+def dft(n):
+    e, out = kernel(n, lambda i: 'in[%d * is]' % i)
+    body = ['void',
+            'dft_%d(const double complex *in, size_t is, '
+            'double complex *out, size_t os)' % n,
+            '{']
+    body += e.lines
+    for k, (re, im) in enumerate(out):
+        body.append('    out[%d * os] = CMPLX(%s, %s);' % (k, re, im))
+    body.append('}')
+    return body
+
+
+def leaf(n):
+    bits = n.bit_length() - 1
+    e, out = kernel(n, lambda i: 'buf[%d]' % bitrev(i, bits))
+    body = ['void',
+            'leaf_%d(double complex *buf)' % n,
+            '{']
+    body += e.lines
+    for k, (re, im) in enumerate(out):
+        body.append('    buf[%d] = CMPLX(%s, %s);' % (k, re, im))
+    body.append('}')
+    return body
+
+
+def header():
+    out = ['/*',
+           ' * Generated by tools/gencodelets.py; do not edit.',
+           ' */',
+           '',
+           '#ifndef FOURIER_CODELETS_H',
+           '#define FOURIER_CODELETS_H',
+           '',
+           '#include <stdlib.h>',
+           '#include <complex.h>',
+           '',
+           '/**',
+           ' * The largest size of the codelets.',
+           ' */',
+           '#define CODELET_MAX  %d' % SIZES[-1],
+           '',
+           '/**',
+           ' * Straight-line DFT of N points in the natural order.',
+           ' *',
+           ' * @param in    the input.',
+           ' * @param is    the stride of the input.',
+           ' * @param out   the output, which must not overlap the input.',
+           ' * @param os    the stride of the output.',
+           ' */',
+           'typedef void (*dft_codelet_t)(const double complex *in, size_t is,',
+           '                              double complex *out, size_t os);',
+           '',
+           '/**',
+           ' * Straight-line DFT of N points in place, taking the input in the',
+           ' * bit-reversed order.  Equivalent to the first log2(N) stages of',
+           ' * fft() over a block of N points.',
+           ' */',
+           'typedef void (*leaf_codelet_t)(double complex *buf);',
+           '']
+    for n in SIZES:
+        out.append('void dft_%d(const double complex *in, size_t is, '
+                   'double complex *out,' % n)
+        out.append('%ssize_t os);' % (' ' * (len('void dft_%d(' % n))))
+    out.append('')
+    for n in LEAF_SIZES:
+        out.append('void leaf_%d(double complex *buf);' % n)
+    out += ['',
+            '/**',
+            ' * Returns the codelet of the size, or NULL if there is none.',
+            ' */',
+            'dft_codelet_t dft_codelet(size_t n);',
+            '',
+            '/**',
+            ' * Returns the leaf codelet of the size, or NULL if there is none.',
+            ' */',
+            'leaf_codelet_t leaf_codelet(size_t n);',
+            '',
+            '#endif /* FOURIER_CODELETS_H */']
+    return out
+
+
+def source():
+    out = ['/*',
+           ' * Generated by tools/gencodelets.py; do not edit.',
+           ' */',
+           '',
+           '#include <stdlib.h>',
+           '#include <complex.h>',
+           '#include "codelets.h"',
+           '']
+    for n in SIZES:
+        out += dft(n)
+        out.append('')
+    for n in LEAF_SIZES:
+        out += leaf(n)
+        out.append('')
+    out += ['dft_codelet_t',
+            'dft_codelet(size_t n)',
+            '{',
+            '    switch (n) {']
+    for n in SIZES:
+        out.append('    case %d:' % n)
+        out.append('        return dft_%d;' % n)
+    out += ['    default:',
+            '        return NULL;',
+            '    }',
+            '}',
+            '',
+            'leaf_codelet_t',
+            'leaf_codelet(size_t n)',
+            '{',
+            '    switch (n) {']
+    for n in LEAF_SIZES:
+        out.append('    case %d:' % n)
+        out.append('        return leaf_%d;' % n)
+    out += ['    default:',
+            '        return NULL;',
+            '    }',
+            '}']
+    return out
+
+
+if __name__ == '__main__':
+    if len(sys.argv) != 2 or sys.argv[1] not in ('header', 'source'):
+        sys.stderr.write('usage: %s header|source\n' % sys.argv[0])
+        sys.exit(1)
+    lines = header() if sys.argv[1] == 'header' else source()
+    sys.stdout.write('\n'.join(lines) + '\n')